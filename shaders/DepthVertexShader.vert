@@ -3,6 +3,8 @@ layout(location = 0) in vec3 vertexPosition_modelspace;
 layout(location = 1) in vec2 vertexUV;
 layout(location = 2) in vec3 normal;
 layout(location = 3) in uint textureIndex;
+// Per draw, see TRANSFORM_ATTRIBUTE_LOCATION
+layout(location = 6) in mat4 transformationMatrix;
 
 // Passthrough texture index and UVs
 flat out uint texIndex;
@@ -10,7 +12,6 @@ out vec2 UV;
 
 // Values that stay constant for the whole mesh.
 uniform mat4 lightSpaceMatrix;
-uniform mat4 transformationMatrix;
 
 void main(){
  // Passthrough to fragment shader for alpha discard
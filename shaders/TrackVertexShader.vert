@@ -5,6 +5,8 @@ layout(location = 2) in vec3 normal;
 layout(location = 3) in uint textureIndex;
 layout(location = 4) in vec4 nfsData;
 layout(location = 5) in uint debugData;
+// Per draw, see TRANSFORM_ATTRIBUTE_LOCATION
+layout(location = 6) in mat4 transformationMatrix;
 
 // Output data ; will be interpolated for each fragment.
 out vec2 UV;
@@ -24,7 +26,7 @@ out vec4 viewSpace;
 out vec4 lightSpace;
 
 // Values that stay constant for the whole mesh.
-uniform mat4 projectionMatrix, viewMatrix ,transformationMatrix;
+uniform mat4 projectionMatrix, viewMatrix;
 uniform mat4 lightSpaceMatrix;
 uniform vec3 lightPosition[MAX_TRACK_CONTRIB_LIGHTS];
 uniform vec3 spotlightPosition;
@@ -23,6 +23,7 @@ void Config::InitFromCommandLine(int argc, char **argv)
           // Option name/short name, parameter to option, description
           ("help,h", "Print OpenNFS command-line parameters")("spark", bool_switch(&sparkMode), "Ignore Virual Road boundaries")(
             "vulkan", bool_switch(&vulkanRender), "Use the Vulkan renderer instead of GL default")("headless", bool_switch(&headless), "Launch ONFS without a window")(
+            "uncompressed-textures", bool_switch(&uncompressedTextures), "Upload textures as RGBA8 rather than BC1/BC3 block compressed")(
             "train", bool_switch(&trainingMode), "Launch ONFS in AI training mode")("fullv", bool_switch(&useFullVroad), "Allow AI to drive whole track")(
             "nracers", value(&nRacers), "Number of AI Racers on track")("ngens", value(&nGenerations), "Number of generations to allow AI to develop for (training mode)")(
             "nticks", value(&nTicks), "Number of ticks to allow AI agents to simulate in, per generation (training mode)")("car,c", value(&car), "Name of desired car")(
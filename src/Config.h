@@ -27,7 +27,8 @@ const std::string CAR_PATH      = ASSET_PATH + "car/";
 const std::string TRACK_PATH    = ASSET_PATH + "tracks/";
 const std::string RESOURCE_PATH = "../resources/";
 
-const std::string BEST_NETWORK_PATH = ASSET_PATH + "bestRacer.net";
+const std::string BEST_NETWORK_PATH  = ASSET_PATH + "bestRacer.net";
+const std::string TEXTURE_CACHE_PATH = ASSET_PATH + "texturecache/";
 
 const std::string NFS_2_TRACK_PATH = "/gamedata/tracks/pc/";
 const std::string NFS_2_CAR_PATH   = "/gamedata/carmodel/pc/";
@@ -90,9 +91,10 @@ public:
     bool useFullVroad = true;
     bool sparkMode    = false;
     /* -- Render Params -- */
-    bool vulkanRender = false;
-    bool headless     = false;
-    float fov         = DEFAULT_FOV;
+    bool vulkanRender         = false;
+    bool headless             = false;
+    bool uncompressedTextures = false;
+    float fov                 = DEFAULT_FOV;
     uint32_t resX = DEFAULT_X_RESOLUTION, resY = DEFAULT_Y_RESOLUTION;
     /* -- Training Params -- */
     bool trainingMode     = false;
@@ -116,13 +118,15 @@ struct ParamData
     float nearPlane             = 160.f;
     float farPlane              = 300.f;
     float trackSpecDamper       = 10;
-    int blockDrawDistance       = 15;
+    float trackMedResDistance   = 150.f;
+    float trackLoResDistance    = 300.f;
     bool physicsDebugView       = false;
     bool drawHermiteFrustum     = false;
     bool drawTrackAABB          = false;
     bool useClassicGraphics     = false;
     bool attachCamToHermite     = false;
     bool useNbData              = true;
+    bool useTrackLODs           = true;
     bool attachCamToCar         = true;
     bool frustumCull            = false;
     bool drawVroad              = false;
@@ -0,0 +1,272 @@
+#include "AssetCatalogue.h"
+
+#include <algorithm>
+#include <ctime>
+#include <boost/filesystem.hpp>
+
+#include "AssetScanner.h"
+
+namespace
+{
+    // Guards against allocating off the back of a corrupt count or length
+    const uint32_t MAX_CATALOGUE_ENTRIES = 1 << 20;
+} // namespace
+
+AssetCatalogue AssetCatalogue::Open(const std::string &resourcePath, const std::string &cataloguePath)
+{
+    AssetCatalogue catalogue;
+    if (Load(cataloguePath, catalogue) && catalogue.IsValidFor(resourcePath))
+    {
+        LOG(INFO) << "Asset catalogue " << cataloguePath << " is up to date, skipping resource scan";
+    }
+    else
+    {
+        LOG(INFO) << "Scanning " << resourcePath << " for installed NFS versions";
+        std::vector<std::string> scannedDirectories;
+        catalogue                 = AssetCatalogue();
+        catalogue.resourcePath    = resourcePath;
+        catalogue.installedNFS    = AssetScanner::ScanResources(resourcePath, &scannedDirectories);
+        catalogue.directoryStamps = StampDirectories(scannedDirectories);
+        Save(cataloguePath, catalogue);
+    }
+    AssetScanner::ExtractSharedResources(resourcePath, catalogue.installedNFS);
+
+    return catalogue;
+}
+
+bool AssetCatalogue::Load(const std::string &cataloguePath, AssetCatalogue &catalogue)
+{
+    if (!boost::filesystem::exists(cataloguePath))
+    {
+        return false;
+    }
+
+    std::ifstream catalogueFile(cataloguePath, std::ios::in | std::ios::binary);
+    if (!catalogueFile.is_open())
+    {
+        return false;
+    }
+
+    return catalogue._SerializeIn(catalogueFile);
+}
+
+void AssetCatalogue::Save(const std::string &cataloguePath, AssetCatalogue &catalogue)
+{
+    LOG(INFO) << "Saving asset catalogue to " << cataloguePath;
+    // As OnfsFile, write alongside and move into place so that a concurrent or interrupted save never leaves a truncated catalogue
+    std::string tempPath = cataloguePath + ".tmp";
+    boost::filesystem::create_directories(boost::filesystem::path(cataloguePath).parent_path());
+    {
+        std::ofstream catalogueFile(tempPath, std::ios::out | std::ios::binary);
+        catalogue._SerializeOut(catalogueFile);
+        if (!catalogueFile.good())
+        {
+            LOG(WARNING) << "Failed to write asset catalogue to " << tempPath;
+            return;
+        }
+    }
+
+    boost::system::error_code renameError;
+    boost::filesystem::rename(tempPath, cataloguePath, renameError);
+    if (renameError)
+    {
+        LOG(WARNING) << "Failed to move asset catalogue into place at " << cataloguePath << ": " << renameError.message();
+    }
+}
+
+std::vector<AssetDirectoryStamp> AssetCatalogue::StampDirectories(const std::vector<std::string> &directoryPaths)
+{
+    std::vector<AssetDirectoryStamp> directoryStamps;
+    int64_t stampTime = static_cast<int64_t>(std::time(nullptr));
+
+    for (auto &directoryPath : directoryPaths)
+    {
+        boost::system::error_code statError;
+        int64_t lastWriteTime = static_cast<int64_t>(boost::filesystem::last_write_time(directoryPath, statError));
+        // Modification times only have a resolution of a second, so a directory changed within the last second may change again unnoticed. Those, and
+        // directories that can't be stat'ed, are stamped such that they never match and the next start rescans.
+        bool trustworthy = !statError && lastWriteTime < stampTime - 1;
+        directoryStamps.push_back({directoryPath, trustworthy ? lastWriteTime : -1});
+    }
+
+    return directoryStamps;
+}
+
+bool AssetCatalogue::IsValidFor(const std::string &resourcePath) const
+{
+    if (this->version != ASSET_CATALOGUE_VERSION || this->resourcePath != resourcePath || directoryStamps.empty())
+    {
+        return false;
+    }
+
+    for (auto &directoryStamp : directoryStamps)
+    {
+        boost::system::error_code statError;
+        int64_t lastWriteTime = static_cast<int64_t>(boost::filesystem::last_write_time(directoryStamp.path, statError));
+        if (statError || directoryStamp.lastWriteTime == -1 || lastWriteTime != directoryStamp.lastWriteTime)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const std::vector<NfsAssetList> &AssetCatalogue::GetInstalledNFS() const
+{
+    return installedNFS;
+}
+
+bool AssetCatalogue::GetAssets(NFSVer nfsVersion, NfsAssetList &assetList) const
+{
+    auto nfsItr = std::find_if(installedNFS.begin(), installedNFS.end(), [nfsVersion](const NfsAssetList &nfs) { return nfs.tag == nfsVersion; });
+    if (nfsItr == installedNFS.end())
+    {
+        return false;
+    }
+    assetList = *nfsItr;
+
+    return true;
+}
+
+bool AssetCatalogue::_SerializeIn(std::ifstream &ifstream)
+{
+    uint32_t signature;
+    SAFE_READ(ifstream, &signature, sizeof(uint32_t));
+    if (signature != ASSET_CATALOGUE_SIGNATURE)
+    {
+        LOG(WARNING) << "Not an asset catalogue, ignoring";
+        return false;
+    }
+    SAFE_READ(ifstream, &version, sizeof(uint32_t));
+    if (version != ASSET_CATALOGUE_VERSION)
+    {
+        // Layout may well differ, don't attempt to read any further
+        return true;
+    }
+    if (!_ReadString(ifstream, resourcePath))
+    {
+        return false;
+    }
+
+    uint32_t nDirectories;
+    SAFE_READ(ifstream, &nDirectories, sizeof(uint32_t));
+    if (nDirectories > MAX_CATALOGUE_ENTRIES)
+    {
+        return false;
+    }
+    directoryStamps.resize(nDirectories);
+    for (auto &directoryStamp : directoryStamps)
+    {
+        if (!_ReadString(ifstream, directoryStamp.path))
+        {
+            return false;
+        }
+        SAFE_READ(ifstream, &directoryStamp.lastWriteTime, sizeof(int64_t));
+    }
+
+    uint32_t nInstalledNFS;
+    SAFE_READ(ifstream, &nInstalledNFS, sizeof(uint32_t));
+    if (nInstalledNFS > MAX_CATALOGUE_ENTRIES)
+    {
+        return false;
+    }
+    installedNFS.resize(nInstalledNFS);
+    for (auto &nfs : installedNFS)
+    {
+        uint32_t tag, nTracks, nCars;
+        SAFE_READ(ifstream, &tag, sizeof(uint32_t));
+        nfs.tag = static_cast<NFSVer>(tag);
+
+        SAFE_READ(ifstream, &nTracks, sizeof(uint32_t));
+        if (nTracks > MAX_CATALOGUE_ENTRIES)
+        {
+            return false;
+        }
+        nfs.tracks.resize(nTracks);
+        for (auto &track : nfs.tracks)
+        {
+            if (!_ReadString(ifstream, track))
+            {
+                return false;
+            }
+        }
+
+        SAFE_READ(ifstream, &nCars, sizeof(uint32_t));
+        if (nCars > MAX_CATALOGUE_ENTRIES)
+        {
+            return false;
+        }
+        nfs.cars.resize(nCars);
+        for (auto &car : nfs.cars)
+        {
+            if (!_ReadString(ifstream, car))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void AssetCatalogue::_SerializeOut(std::ofstream &ofstream)
+{
+    uint32_t nDirectories  = static_cast<uint32_t>(directoryStamps.size());
+    uint32_t nInstalledNFS = static_cast<uint32_t>(installedNFS.size());
+
+    ofstream.write((char *) &ASSET_CATALOGUE_SIGNATURE, sizeof(uint32_t));
+    ofstream.write((char *) &version, sizeof(uint32_t));
+    _WriteString(ofstream, resourcePath);
+
+    ofstream.write((char *) &nDirectories, sizeof(uint32_t));
+    for (auto &directoryStamp : directoryStamps)
+    {
+        _WriteString(ofstream, directoryStamp.path);
+        ofstream.write((char *) &directoryStamp.lastWriteTime, sizeof(int64_t));
+    }
+
+    ofstream.write((char *) &nInstalledNFS, sizeof(uint32_t));
+    for (auto &nfs : installedNFS)
+    {
+        uint32_t tag     = static_cast<uint32_t>(nfs.tag);
+        uint32_t nTracks = static_cast<uint32_t>(nfs.tracks.size());
+        uint32_t nCars   = static_cast<uint32_t>(nfs.cars.size());
+
+        ofstream.write((char *) &tag, sizeof(uint32_t));
+        ofstream.write((char *) &nTracks, sizeof(uint32_t));
+        for (auto &track : nfs.tracks)
+        {
+            _WriteString(ofstream, track);
+        }
+        ofstream.write((char *) &nCars, sizeof(uint32_t));
+        for (auto &car : nfs.cars)
+        {
+            _WriteString(ofstream, car);
+        }
+    }
+}
+
+bool AssetCatalogue::_ReadString(std::ifstream &ifstream, std::string &string)
+{
+    uint32_t length;
+    SAFE_READ(ifstream, &length, sizeof(uint32_t));
+    if (length > MAX_CATALOGUE_ENTRIES)
+    {
+        return false;
+    }
+    string.resize(length);
+    if (length > 0)
+    {
+        SAFE_READ(ifstream, &string[0], length);
+    }
+
+    return true;
+}
+
+void AssetCatalogue::_WriteString(std::ofstream &ofstream, const std::string &string)
+{
+    uint32_t length = static_cast<uint32_t>(string.size());
+    ofstream.write((char *) &length, sizeof(uint32_t));
+    ofstream.write(string.data(), length);
+}
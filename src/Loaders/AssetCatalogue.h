@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+#include "../Config.h"
+#include "Common/IRawData.h"
+
+const std::string ASSET_CATALOGUE_PATH = ASSET_PATH + "resources.catalogue";
+static const uint32_t ASSET_CATALOGUE_SIGNATURE = 0xCA7A1065;
+// Bump whenever the layout below, or what AssetScanner picks up as an asset, changes. Stale catalogues are rebuilt.
+const uint32_t ASSET_CATALOGUE_VERSION = 1;
+
+// Modification time of a directory the catalogue was built by listing. Adding, removing or renaming an entry bumps it.
+struct AssetDirectoryStamp
+{
+    std::string path;
+    int64_t lastWriteTime;
+};
+
+// Persisted result of AssetScanner::ScanResources, so that startup doesn't have to walk the whole resources directory. Only the directories the
+// scan listed are stat'ed to check it's still current, and queries are answered from memory.
+class AssetCatalogue : IRawData
+{
+public:
+    AssetCatalogue() = default;
+    // Loads the catalogue at cataloguePath if it is still current for resourcePath, otherwise rescans resourcePath and rewrites it
+    static AssetCatalogue Open(const std::string &resourcePath, const std::string &cataloguePath = ASSET_CATALOGUE_PATH);
+    static bool Load(const std::string &cataloguePath, AssetCatalogue &catalogue);
+    static void Save(const std::string &cataloguePath, AssetCatalogue &catalogue);
+    static std::vector<AssetDirectoryStamp> StampDirectories(const std::vector<std::string> &directoryPaths);
+    // True if built by this version of ONFS from resourcePath, and none of the directories it listed have changed since
+    bool IsValidFor(const std::string &resourcePath) const;
+
+    const std::vector<NfsAssetList> &GetInstalledNFS() const;
+    bool GetAssets(NFSVer nfsVersion, NfsAssetList &assetList) const;
+
+    uint32_t version = ASSET_CATALOGUE_VERSION;
+    std::string resourcePath;
+    std::vector<AssetDirectoryStamp> directoryStamps;
+    std::vector<NfsAssetList> installedNFS;
+
+private:
+    bool _SerializeIn(std::ifstream &ifstream) override;
+    void _SerializeOut(std::ofstream &ofstream) override;
+
+    static bool _ReadString(std::ifstream &ifstream, std::string &string);
+    static void _WriteString(std::ofstream &ofstream, const std::string &string);
+};
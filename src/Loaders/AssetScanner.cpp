@@ -0,0 +1,308 @@
+#include "AssetScanner.h"
+
+using namespace boost::filesystem;
+
+std::vector<NfsAssetList> AssetScanner::ScanResources(const std::string &resourcePath, std::vector<std::string> *scannedDirectories)
+{
+    std::vector<NfsAssetList> installedNFS;
+    path basePath(resourcePath);
+    bool hasMisc = false;
+    bool hasUI   = false;
+
+    // Every listing goes through here, so that callers can tell which directories the result depends upon
+    auto listDirectory = [scannedDirectories](const path &directoryPath) {
+        if (scannedDirectories != nullptr)
+        {
+            scannedDirectories->push_back(directoryPath.string());
+        }
+        return directory_iterator(directoryPath);
+    };
+
+    for (directory_iterator itr = listDirectory(basePath); itr != directory_iterator(); ++itr)
+    {
+        NfsAssetList currentNFS;
+        currentNFS.tag = UNKNOWN;
+
+        if (itr->path().filename().string() == ToString(NFS_2_SE))
+        {
+            currentNFS.tag = NFS_2_SE;
+
+            std::stringstream trackBasePathStream;
+            trackBasePathStream << itr->path().string() << NFS_2_SE_TRACK_PATH;
+            std::string trackBasePath(trackBasePathStream.str());
+            ASSERT(exists(trackBasePath), "NFS 2 Special Edition track folder: " << trackBasePath << " is missing");
+
+            for (directory_iterator trackItr = listDirectory(trackBasePath); trackItr != directory_iterator(); ++trackItr)
+            {
+                if (trackItr->path().filename().string().find(".trk") != std::string::npos)
+                {
+                    currentNFS.tracks.emplace_back(trackItr->path().filename().replace_extension("").string());
+                }
+            }
+
+            std::stringstream carBasePathStream;
+            carBasePathStream << itr->path().string() << NFS_2_SE_CAR_PATH;
+            std::string carBasePath(carBasePathStream.str());
+            ASSERT(exists(carBasePath), "NFS 2 Special Edition car folder: " << carBasePath << " is missing");
+
+            // TODO: Work out where NFS2 SE Cars are stored
+        }
+        else if (itr->path().filename().string() == ToString(NFS_2))
+        {
+            currentNFS.tag = NFS_2;
+
+            std::stringstream trackBasePathStream;
+            trackBasePathStream << itr->path().string() << NFS_2_TRACK_PATH;
+            std::string trackBasePath(trackBasePathStream.str());
+            ASSERT(exists(trackBasePath), "NFS 2 track folder: " << trackBasePath << " is missing");
+
+            for (directory_iterator trackItr = listDirectory(trackBasePath); trackItr != directory_iterator(); ++trackItr)
+            {
+                if (trackItr->path().filename().string().find(".trk") != std::string::npos)
+                {
+                    currentNFS.tracks.emplace_back(trackItr->path().filename().replace_extension("").string());
+                }
+            }
+
+            std::stringstream carBasePathStream;
+            carBasePathStream << itr->path().string() << NFS_2_CAR_PATH;
+            std::string carBasePath(carBasePathStream.str());
+            ASSERT(exists(carBasePath), "NFS 2 car folder: " << carBasePath << " is missing");
+
+            for (directory_iterator carItr = listDirectory(carBasePath); carItr != directory_iterator(); ++carItr)
+            {
+                if (carItr->path().filename().string().find(".geo") != std::string::npos)
+                {
+                    currentNFS.cars.emplace_back(carItr->path().filename().replace_extension("").string());
+                }
+            }
+        }
+        else if (itr->path().filename().string() == ToString(NFS_2_PS1))
+        {
+            currentNFS.tag = NFS_2_PS1;
+
+            for (directory_iterator trackItr = listDirectory(itr->path().string()); trackItr != directory_iterator(); ++trackItr)
+            {
+                if (trackItr->path().filename().string().find(".trk") != std::string::npos)
+                {
+                    currentNFS.tracks.emplace_back(trackItr->path().filename().replace_extension("").string());
+                }
+            }
+
+            for (directory_iterator carItr = listDirectory(itr->path().string()); carItr != directory_iterator(); ++carItr)
+            {
+                if (carItr->path().filename().string().find(".geo") != std::string::npos)
+                {
+                    currentNFS.cars.emplace_back(carItr->path().filename().replace_extension("").string());
+                }
+            }
+        }
+        else if (itr->path().filename().string() == ToString(NFS_3_PS1))
+        {
+            currentNFS.tag = NFS_3_PS1;
+
+            for (directory_iterator trackItr = listDirectory(itr->path().string()); trackItr != directory_iterator(); ++trackItr)
+            {
+                if (trackItr->path().filename().string().find(".trk") != std::string::npos)
+                {
+                    currentNFS.tracks.emplace_back(trackItr->path().filename().replace_extension("").string());
+                }
+            }
+
+            for (directory_iterator carItr = listDirectory(itr->path().string()); carItr != directory_iterator(); ++carItr)
+            {
+                if (carItr->path().filename().string().find(".geo") != std::string::npos)
+                {
+                    currentNFS.cars.emplace_back(carItr->path().filename().replace_extension("").string());
+                }
+            }
+        }
+        else if (itr->path().filename().string() == ToString(NFS_3))
+        {
+            currentNFS.tag = NFS_3;
+
+            std::stringstream trackBasePathStream;
+            trackBasePathStream << itr->path().string() << NFS_3_TRACK_PATH;
+            std::string trackBasePath(trackBasePathStream.str());
+            ASSERT(exists(trackBasePath), "NFS 3 Hot Pursuit track folder: " << trackBasePath << " is missing");
+
+            for (directory_iterator trackItr = listDirectory(trackBasePath); trackItr != directory_iterator(); ++trackItr)
+            {
+                currentNFS.tracks.emplace_back(trackItr->path().filename().string());
+            }
+
+            std::stringstream carBasePathStream;
+            carBasePathStream << itr->path().string() << NFS_3_CAR_PATH;
+            std::string carBasePath(carBasePathStream.str());
+            ASSERT(exists(carBasePath), "NFS 3 Hot Pursuit car folder: " << carBasePath << " is missing");
+
+            for (directory_iterator carItr = listDirectory(carBasePath); carItr != directory_iterator(); ++carItr)
+            {
+                if (carItr->path().filename().string().find("traffic") == std::string::npos)
+                {
+                    currentNFS.cars.emplace_back(carItr->path().filename().string());
+                }
+            }
+
+            carBasePathStream << "traffic/";
+            for (directory_iterator carItr = listDirectory(carBasePathStream.str()); carItr != directory_iterator(); ++carItr)
+            {
+                currentNFS.cars.emplace_back("traffic/" + carItr->path().filename().string());
+            }
+
+            carBasePathStream << "pursuit/";
+            for (directory_iterator carItr = listDirectory(carBasePathStream.str()); carItr != directory_iterator(); ++carItr)
+            {
+                if (carItr->path().filename().string().find("pursuit") == std::string::npos)
+                {
+                    currentNFS.cars.emplace_back("traffic/pursuit/" + carItr->path().filename().string());
+                }
+            }
+        }
+        else if (itr->path().filename().string() == ToString(NFS_4_PS1))
+        {
+            currentNFS.tag = NFS_4_PS1;
+
+            for (directory_iterator dirItr = listDirectory(itr->path().string()); dirItr != directory_iterator(); ++dirItr)
+            {
+                if (dirItr->path().filename().string().find("zzz") == 0 && dirItr->path().filename().string().find(".viv") != std::string::npos)
+                {
+                    currentNFS.cars.emplace_back(dirItr->path().filename().replace_extension("").string());
+                }
+                else if (dirItr->path().filename().string().find("ztr") == 0 && dirItr->path().filename().string().find(".grp") != std::string::npos)
+                {
+                    currentNFS.tracks.emplace_back(dirItr->path().filename().replace_extension("").string());
+                }
+            }
+        }
+        else if (itr->path().filename().string() == ToString(NFS_4))
+        {
+            currentNFS.tag = NFS_4;
+
+            std::stringstream trackBasePathStream;
+            trackBasePathStream << itr->path().string() << NFS_4_TRACK_PATH;
+            std::string trackBasePath(trackBasePathStream.str());
+            ASSERT(exists(trackBasePath), "NFS 4 High Stakes track folder: " << trackBasePath << " is missing");
+
+            for (directory_iterator trackItr = listDirectory(trackBasePath); trackItr != directory_iterator(); ++trackItr)
+            {
+                currentNFS.tracks.emplace_back(trackItr->path().filename().string());
+            }
+
+            std::stringstream carBasePathStream;
+            carBasePathStream << itr->path().string() << NFS_4_CAR_PATH;
+            std::string carBasePath(carBasePathStream.str());
+            ASSERT(exists(carBasePath), "NFS 4 High Stakes car folder: " << carBasePath << " is missing");
+
+            for (directory_iterator carItr = listDirectory(carBasePath); carItr != directory_iterator(); ++carItr)
+            {
+                if (carItr->path().filename().string().find("traffic") == std::string::npos)
+                {
+                    currentNFS.cars.emplace_back(carItr->path().filename().string());
+                }
+            }
+
+            carBasePathStream << "traffic/";
+            for (directory_iterator carItr = listDirectory(carBasePathStream.str()); carItr != directory_iterator(); ++carItr)
+            {
+                if ((carItr->path().filename().string().find("choppers") == std::string::npos) && (carItr->path().filename().string().find("pursuit") == std::string::npos))
+                {
+                    currentNFS.cars.emplace_back("traffic/" + carItr->path().filename().string());
+                }
+            }
+
+            carBasePathStream << "choppers/";
+            for (directory_iterator carItr = listDirectory(carBasePathStream.str()); carItr != directory_iterator(); ++carItr)
+            {
+                currentNFS.cars.emplace_back("traffic/choppers/" + carItr->path().filename().string());
+            }
+
+            carBasePathStream.str(std::string());
+            carBasePathStream << itr->path().string() << NFS_4_CAR_PATH << "traffic/"
+                              << "pursuit/";
+            for (directory_iterator carItr = listDirectory(carBasePathStream.str()); carItr != directory_iterator(); ++carItr)
+            {
+                currentNFS.cars.emplace_back("traffic/pursuit/" + carItr->path().filename().string());
+            }
+        }
+        else if (itr->path().filename().string() == ToString(MCO))
+        {
+            currentNFS.tag = MCO;
+
+            std::string trackBasePath = itr->path().string() + MCO_TRACK_PATH;
+            ASSERT(exists(trackBasePath), "Motor City Online track folder: " << trackBasePath << " is missing");
+
+            for (directory_iterator trackItr = listDirectory(trackBasePath); trackItr != directory_iterator(); ++trackItr)
+            {
+                currentNFS.tracks.emplace_back(trackItr->path().filename().string());
+            }
+
+            std::string carBasePath = itr->path().string() + MCO_CAR_PATH;
+            ASSERT(exists(carBasePath), "Motor City Online car folder: " << carBasePath << " is missing");
+            for (directory_iterator carItr = listDirectory(carBasePath); carItr != directory_iterator(); ++carItr)
+            {
+                currentNFS.cars.emplace_back(carItr->path().filename().replace_extension("").string());
+            }
+        }
+        else if (itr->path().filename().string() == ToString(NFS_5))
+        {
+            currentNFS.tag = NFS_5;
+
+            std::stringstream trackBasePathStream;
+            trackBasePathStream << itr->path().string() << NFS_5_TRACK_PATH;
+            std::string trackBasePath(trackBasePathStream.str());
+            ASSERT(exists(trackBasePath), "NFS 5 track folder: " << trackBasePath << " is missing");
+
+            for (directory_iterator trackItr = listDirectory(trackBasePath); trackItr != directory_iterator(); ++trackItr)
+            {
+                if (trackItr->path().filename().string().find(".crp") != std::string::npos)
+                {
+                    currentNFS.tracks.emplace_back(trackItr->path().filename().replace_extension("").string());
+                }
+            }
+
+            std::stringstream carBasePathStream;
+            carBasePathStream << itr->path().string() << NFS_5_CAR_PATH;
+            std::string carBasePath(carBasePathStream.str());
+            ASSERT(exists(carBasePath), "NFS 5 car folder: " << carBasePath << " is missing");
+
+            for (directory_iterator carItr = listDirectory(carBasePath); carItr != directory_iterator(); ++carItr)
+            {
+                if (carItr->path().filename().string().find(".crp") != std::string::npos)
+                {
+                    currentNFS.cars.emplace_back(carItr->path().filename().replace_extension("").string());
+                }
+            }
+        }
+        else if (itr->path().filename().string() == "misc" || itr->path().filename().string() == "ui" || itr->path().filename().string() == "asset")
+        {
+            // OpenNFS's own resources, not a game
+            hasMisc |= itr->path().filename().string() == "misc";
+            hasUI |= itr->path().filename().string() == "ui";
+            continue;
+        }
+        else
+        {
+            LOG(WARNING) << "Unknown folder in resources directory: " << itr->path().filename().string();
+            continue;
+        }
+        installedNFS.emplace_back(currentNFS);
+    }
+    ASSERT(hasMisc, "Missing \'misc\' folder in resources directory");
+    ASSERT(hasUI, "Missing \'ui\' folder in resources directory");
+
+    return installedNFS;
+}
+
+void AssetScanner::ExtractSharedResources(const std::string &resourcePath, const std::vector<NfsAssetList> &installedNFS)
+{
+    for (auto &nfs : installedNFS)
+    {
+        if (nfs.tag == NFS_3)
+        {
+            std::string sfxPath = resourcePath + ToString(NFS_3) + "/gamedata/render/pc/sfx.fsh";
+            ASSERT(exists(sfxPath), "NFS 3 SFX Resource: " << sfxPath << " is missing");
+            ASSERT(ImageLoader::ExtractQFS(sfxPath, resourcePath + "sfx/"), "Unable to extract SFX textures from " << sfxPath);
+        }
+    }
+}
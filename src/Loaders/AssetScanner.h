@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <boost/filesystem.hpp>
+
+#include "../Config.h"
+#include "../Util/ImageLoader.h"
+
+class AssetScanner
+{
+public:
+    // Walks an OpenNFS resources directory (NFS_3/, NFS_2/ etc.) and lists the tracks and cars each installed game provides. Optionally returns
+    // every directory that was listed along the way.
+    static std::vector<NfsAssetList> ScanResources(const std::string &resourcePath, std::vector<std::string> *scannedDirectories = nullptr);
+    // Unpacks resources shared between all assets of a game (NFS3 sfx.fsh) into the resources directory, if not already done
+    static void ExtractSharedResources(const std::string &resourcePath, const std::vector<NfsAssetList> &installedNFS);
+};
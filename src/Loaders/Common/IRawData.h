@@ -7,6 +7,7 @@
 #include <array>
 
 #include "../../Util/Utils.h"
+#include "MappedStream.h"
 
 static const uint32_t ONFS_SIGNATURE              = 0x15B001C0;
 const std::array<uint8_t, 6> quadToTriVertNumbers = {0, 1, 2, 0, 2, 3};
@@ -17,3 +18,11 @@ protected:
     virtual bool _SerializeIn(std::ifstream &ifstream)  = 0;
     virtual void _SerializeOut(std::ofstream &ofstream) = 0;
 };
+
+// Variant of IRawData for parsers that deserialize straight out of a memory-mapped file, rather than through std::ifstream
+class IMappedRawData
+{
+protected:
+    virtual bool _SerializeIn(MappedStream &mappedStream) = 0;
+    virtual void _SerializeOut(std::ofstream &ofstream)   = 0;
+};
@@ -0,0 +1,123 @@
+#include "MappedStream.h"
+
+using namespace boost::interprocess;
+
+MappedFile::MappedFile(const std::string &filePath)
+{
+    try
+    {
+        m_fileMapping  = file_mapping(filePath.c_str(), read_only);
+        m_mappedRegion = mapped_region(m_fileMapping, read_only);
+        m_isOpen       = true;
+    }
+    catch (const interprocess_exception &)
+    {
+        // Missing or empty file, leave it to the parser to report the failure to load
+        m_isOpen = false;
+    }
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_isOpen;
+}
+
+const char *MappedFile::Data() const
+{
+    return static_cast<const char *>(m_mappedRegion.get_address());
+}
+
+size_t MappedFile::Size() const
+{
+    return m_isOpen ? m_mappedRegion.get_size() : 0;
+}
+
+MappedStream::MappedStream(std::shared_ptr<MappedFile> mappedFile) : MappedStream(mappedFile, 0, mappedFile->Size())
+{
+}
+
+MappedStream::MappedStream(std::shared_ptr<MappedFile> mappedFile, size_t offset, size_t size) : m_mappedFile(std::move(mappedFile))
+{
+    m_failed = !m_mappedFile->IsOpen() || offset > m_mappedFile->Size() || size > m_mappedFile->Size() - offset;
+    if (!m_failed)
+    {
+        m_data = m_mappedFile->Data() + offset;
+        m_size = size;
+    }
+}
+
+MappedStream &MappedStream::read(char *destination, std::streamsize count)
+{
+    m_lastRead = 0;
+    if (m_failed || count <= 0)
+    {
+        return *this;
+    }
+
+    size_t available = m_size - m_cursor;
+    size_t toRead    = static_cast<size_t>(count);
+    if (toRead > available)
+    {
+        // Match std::ifstream behaviour on a short read, hand back what's left and mark the stream as failed
+        toRead   = available;
+        m_failed = true;
+    }
+    memcpy(destination, m_data + m_cursor, toRead);
+    m_cursor += toRead;
+    m_lastRead = static_cast<std::streamsize>(toRead);
+
+    return *this;
+}
+
+std::streamsize MappedStream::gcount() const
+{
+    return m_lastRead;
+}
+
+MappedStream &MappedStream::seekg(std::streamoff offset, std::ios_base::seekdir direction)
+{
+    if (m_failed)
+    {
+        return *this;
+    }
+
+    std::streamoff base = 0;
+    if (direction == std::ios_base::cur)
+    {
+        base = static_cast<std::streamoff>(m_cursor);
+    }
+    else if (direction == std::ios_base::end)
+    {
+        base = static_cast<std::streamoff>(m_size);
+    }
+
+    std::streamoff target = base + offset;
+    if (target < 0 || target > static_cast<std::streamoff>(m_size))
+    {
+        m_failed = true;
+        return *this;
+    }
+    m_cursor = static_cast<size_t>(target);
+
+    return *this;
+}
+
+std::streampos MappedStream::tellg() const
+{
+    return m_failed ? std::streampos(-1) : std::streampos(static_cast<std::streamoff>(m_cursor));
+}
+
+bool MappedStream::eof() const
+{
+    return m_cursor >= m_size;
+}
+
+bool MappedStream::fail() const
+{
+    return m_failed;
+}
+
+const std::shared_ptr<MappedFile> &MappedStream::GetMappedFile() const
+{
+    return m_mappedFile;
+}
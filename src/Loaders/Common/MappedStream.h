@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// Zero-copy equivalent of SAFE_READ for POD tables, points the RawView straight into the mapping
+#define SAFE_VIEW(stream, rawView, count) \
+    if (!(stream).view((rawView), (count))) \
+    return false
+
+// Read-only memory mapping of an entire file on disk
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &filePath);
+    bool IsOpen() const;
+    const char *Data() const;
+    size_t Size() const;
+
+private:
+    boost::interprocess::file_mapping m_fileMapping;
+    boost::interprocess::mapped_region m_mappedRegion;
+    bool m_isOpen = false;
+};
+
+// Non-owning, read-only view of a POD table inside a MappedFile. Only valid for as long as the MappedFile it was taken from.
+template <typename T>
+class RawView
+{
+public:
+    RawView() = default;
+    RawView(const T *data, size_t count) : m_data(data), m_count(count)
+    {
+    }
+    // Fallback for tables that can't be aliased in place, as they are not suitably aligned within the file
+    explicit RawView(std::vector<T> &&alignedCopy) : m_alignedCopy(std::make_shared<std::vector<T>>(std::move(alignedCopy)))
+    {
+        m_data  = m_alignedCopy->data();
+        m_count = m_alignedCopy->size();
+    }
+
+    const T &operator[](size_t idx) const
+    {
+        return m_data[idx];
+    }
+    const T *data() const
+    {
+        return m_data;
+    }
+    size_t size() const
+    {
+        return m_count;
+    }
+    bool empty() const
+    {
+        return m_count == 0;
+    }
+    const T *begin() const
+    {
+        return m_data;
+    }
+    const T *end() const
+    {
+        return m_data + m_count;
+    }
+
+private:
+    const T *m_data = nullptr;
+    size_t m_count  = 0;
+    std::shared_ptr<std::vector<T>> m_alignedCopy;
+};
+
+// Bounds checked cursor over a MappedFile. Mirrors the subset of the std::ifstream API used by SAFE_READ and the LibOpenNFS
+// parsers (hence the lowercase naming), so parsers can be ported between the two without touching their bodies.
+class MappedStream
+{
+public:
+    explicit MappedStream(std::shared_ptr<MappedFile> mappedFile);
+    // Stream over just [offset, offset + size) of the file, e.g. a single file inside an archive. Offsets are relative to the start of the window.
+    MappedStream(std::shared_ptr<MappedFile> mappedFile, size_t offset, size_t size);
+
+    MappedStream &read(char *destination, std::streamsize count);
+    std::streamsize gcount() const;
+    MappedStream &seekg(std::streamoff offset, std::ios_base::seekdir direction = std::ios_base::beg);
+    std::streampos tellg() const;
+    bool eof() const;
+    bool fail() const;
+
+    template <typename T>
+    bool view(RawView<T> &rawView, size_t count)
+    {
+        if (m_failed || (count > (m_size - m_cursor) / sizeof(T)))
+        {
+            m_failed = true;
+            return false;
+        }
+
+        const char *tableStart = m_data + m_cursor;
+        if (reinterpret_cast<uintptr_t>(tableStart) % alignof(T) == 0)
+        {
+            rawView = RawView<T>(reinterpret_cast<const T *>(tableStart), count);
+        }
+        else
+        {
+            std::vector<T> alignedCopy(count);
+            memcpy(alignedCopy.data(), tableStart, count * sizeof(T));
+            rawView = RawView<T>(std::move(alignedCopy));
+        }
+        m_cursor += count * sizeof(T);
+
+        return true;
+    }
+
+    const std::shared_ptr<MappedFile> &GetMappedFile() const;
+
+private:
+    std::shared_ptr<MappedFile> m_mappedFile;
+    const char *m_data         = nullptr;
+    size_t m_size              = 0;
+    size_t m_cursor            = 0;
+    std::streamsize m_lastRead = 0;
+    bool m_failed              = false;
+};
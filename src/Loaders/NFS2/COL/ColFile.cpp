@@ -6,13 +6,10 @@ template <typename Platform>
 bool ColFile<Platform>::Load(const std::string &colPath, ColFile &colFile, NFSVer version)
 {
     LOG(INFO) << "Loading COL File located at " << colPath;
-    std::ifstream col(colPath, std::ios::in | std::ios::binary);
+    MappedStream col(std::make_shared<MappedFile>(colPath));
     colFile.version = version;
 
-    bool loadStatus = colFile._SerializeIn(col);
-    col.close();
-
-    return loadStatus;
+    return colFile._SerializeIn(col);
 }
 
 template <typename Platform>
@@ -24,30 +21,30 @@ void ColFile<Platform>::Save(const std::string &colPath, ColFile &colFile)
 }
 
 template <typename Platform>
-bool ColFile<Platform>::_SerializeIn(std::ifstream &ifstream)
+bool ColFile<Platform>::_SerializeIn(MappedStream &mappedStream)
 {
     // Check we're in a valid TRK file
-    SAFE_READ(ifstream, header, HEADER_LENGTH);
+    SAFE_READ(mappedStream, header, HEADER_LENGTH);
     if (memcmp(header, "COLL", sizeof(header)) != 0)
         return false;
 
-    SAFE_READ(ifstream, &colVersion, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &colVersion, sizeof(uint32_t));
     if (colVersion != 11)
         return false;
 
-    SAFE_READ(ifstream, &size, sizeof(uint32_t));
-    SAFE_READ(ifstream, &nExtraBlocks, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &size, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nExtraBlocks, sizeof(uint32_t));
 
     extraBlockOffsets.resize(nExtraBlocks);
-    SAFE_READ(ifstream, extraBlockOffsets.data(), nExtraBlocks * sizeof(uint32_t));
+    SAFE_READ(mappedStream, extraBlockOffsets.data(), nExtraBlocks * sizeof(uint32_t));
 
     LOG(INFO) << "Version: " << colVersion << " nExtraBlocks: " << nExtraBlocks;
     LOG(DEBUG) << "Parsing COL Extrablocks";
 
     for (uint32_t extraBlockIdx = 0; extraBlockIdx < nExtraBlocks; ++extraBlockIdx)
     {
-        ifstream.seekg(16 + extraBlockOffsets[extraBlockIdx], std::ios_base::beg);
-        extraObjectBlocks.push_back(ExtraObjectBlock<Platform>(ifstream, this->version));
+        mappedStream.seekg(16 + extraBlockOffsets[extraBlockIdx], std::ios_base::beg);
+        extraObjectBlocks.push_back(ExtraObjectBlock<Platform>(mappedStream, this->version));
         // Map the the block type to the vector index, gross, original ordering is then maintained for output serialisation
         extraObjectBlockMap[(ExtraBlockID)extraObjectBlocks.back().id] = extraBlockIdx;
     }
@@ -11,7 +11,7 @@ namespace LibOpenNFS
     namespace NFS2
     {
         template <typename Platform>
-        class ColFile : IRawData
+        class ColFile : IMappedRawData
         {
         public:
             ColFile() = default;
@@ -34,7 +34,7 @@ namespace LibOpenNFS
             std::vector<ExtraObjectBlock<Platform>> extraObjectBlocks;
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
             void _SerializeOut(std::ofstream &ofstream) override;
 
             // Allows lookup by block type for parsers
@@ -8,12 +8,9 @@ namespace LibOpenNFS
         bool GeoFile<Platform>::Load(const std::string &geoPath, GeoFile &geoFile)
         {
             LOG(INFO) << "Loading GEO File located at " << geoPath;
-            std::ifstream geo(geoPath, std::ios::in | std::ios::binary);
+            MappedStream geo(std::make_shared<MappedFile>(geoPath));
 
-            bool loadStatus = geoFile._SerializeIn(geo);
-            geo.close();
-
-            return loadStatus;
+            return geoFile._SerializeIn(geo);
         }
 
         template <typename Platform>
@@ -25,7 +22,7 @@ namespace LibOpenNFS
         }
 
         template <>
-        bool GeoFile<PC>::_SerializeIn(std::ifstream &ifstream)
+        bool GeoFile<PC>::_SerializeIn(MappedStream &mappedStream)
         {
             // std::vector<CarModel> NFS2<PC>::LoadGEO(const std::string &geo_path, std::map<unsigned int, Texture> car_textures, std::map<std::string, uint32_t> remapped_texture_ids)
             float carScaleFactor     = 2000.f;
@@ -33,13 +30,13 @@ namespace LibOpenNFS
 
             std::vector<CarModel> car_meshes;
 
-            /*SAFE_READ(ifstream, &header, sizeof(PC::HEADER));
+            /*SAFE_READ(mappedStream, &header, sizeof(PC::HEADER));
 
             uint32_t part_Idx = -1;
 
             while (true)
             {
-                std::streamoff start = ifstream.tellg();
+                std::streamoff start = mappedStream.tellg();
 
                 auto *geoBlockHeader = new PC::BLOCK_HEADER();
                 while (geoBlockHeader->nVerts == 0)
@@ -105,12 +102,12 @@ namespace LibOpenNFS
                     indices.emplace_back(polygons[poly_Idx].vertex[2]);
                     indices.emplace_back(polygons[poly_Idx].vertex[3]);
 
-                    uvs.emplace_back(0.0f * gl_texture.maxU, 0.0f * gl_texture.maxV);
-                    uvs.emplace_back(1.0f * gl_texture.maxU, 0.0f * gl_texture.maxV);
-                    uvs.emplace_back(1.0f * gl_texture.maxU, 1.0f * gl_texture.maxV);
-                    uvs.emplace_back(0.0f * gl_texture.maxU, 0.0f * gl_texture.maxV);
-                    uvs.emplace_back(1.0f * gl_texture.maxU, 1.0f * gl_texture.maxV);
-                    uvs.emplace_back(0.0f * gl_texture.maxU, 1.0f * gl_texture.maxV);
+                    uvs.emplace_back(gl_texture.LayerUV(glm::vec2(0.0f, 0.0f)));
+                    uvs.emplace_back(gl_texture.LayerUV(glm::vec2(1.0f, 0.0f)));
+                    uvs.emplace_back(gl_texture.LayerUV(glm::vec2(1.0f, 1.0f)));
+                    uvs.emplace_back(gl_texture.LayerUV(glm::vec2(0.0f, 0.0f)));
+                    uvs.emplace_back(gl_texture.LayerUV(glm::vec2(1.0f, 1.0f)));
+                    uvs.emplace_back(gl_texture.LayerUV(glm::vec2(0.0f, 1.0f)));
 
                     glm::vec3 normal = rotationMatrix * CalculateQuadNormal(PointToVec(vertices[polygons[poly_Idx].vertex[0]]),
                                                                             PointToVec(vertices[polygons[poly_Idx].vertex[1]]),
@@ -149,7 +146,7 @@ namespace LibOpenNFS
         }
 
         template <>
-        bool GeoFile<PS1>::_SerializeIn(std::ifstream &ifstream)
+        bool GeoFile<PS1>::_SerializeIn(MappedStream &mappedStream)
         {
             // std::vector<CarModel> NFS2<PS1>::LoadGEO(const std::string &geo_path, std::map<unsigned int, Texture> car_textures, std::map<std::string, uint32_t> remapped_texture_ids)
             /*glm::quat rotationMatrix = glm::normalize(glm::quat(glm::vec3(0, 0, 0)));
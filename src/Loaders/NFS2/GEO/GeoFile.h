@@ -8,7 +8,7 @@ namespace LibOpenNFS
     namespace NFS2
     {
         template <typename Platform>
-        class GeoFile : IRawData
+        class GeoFile : IMappedRawData
         {
         public:
             GeoFile() = default;
@@ -17,7 +17,7 @@ namespace LibOpenNFS
             static void Save(const std::string &geoPath, GeoFile &geoFile);
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
             void _SerializeOut(std::ofstream &ofstream) override;
         };
     } // namespace NFS2
@@ -74,7 +74,7 @@ std::shared_ptr<Car> NFS2Loader<Platform>::LoadCar(const std::string &carBasePat
     ASSERT(GeoFile<Platform>::Load(geoPath, geoFile), "Could not load GEO file: " << geoPath);
 
     // This must run before geometry load, as it will affect UV's
-    GLint textureArrayID = Texture::MakeTextureArray(carTextures, false);
+    GLint textureArrayID = Texture::MakeTextureArray(carTextures);
     CarData carData      = _ParseGEOModels(geoFile);
     // carData.meshes = LoadGEO(geo_path.str(), car_textures, remapped_texture_ids);
     return std::make_shared<Car>(carData, NFSVer::NFS_2, carName, textureArrayID);
@@ -85,7 +85,7 @@ std::shared_ptr<Track> NFS2Loader<PC>::LoadTrack(const std::string &trackBasePat
 {
     LOG(INFO) << "Loading Track located at " << trackBasePath;
 
-    auto track        = std::make_shared<Track>(Track());
+    auto track        = std::make_shared<Track>();
     track->nfsVersion = nfsVersion;
 
     boost::filesystem::path p(trackBasePath);
@@ -118,12 +118,9 @@ std::shared_ptr<Track> NFS2Loader<PC>::LoadTrack(const std::string &trackBasePat
 
     // Load up the textures
     auto textureBlock = colFile.GetExtraObjectBlock(ExtraBlockID::TEXTURE_BLOCK_ID);
-    for (uint32_t texIdx = 0; texIdx < textureBlock.nTextures; texIdx++)
-    {
-        track->textureMap[textureBlock.polyToQfsTexTable[texIdx].texNumber] = Texture::LoadTexture(track->nfsVersion, textureBlock.polyToQfsTexTable[texIdx], track->name);
-    }
+    track->textureMap = Texture::LoadTextures(track->nfsVersion, textureBlock.polyToQfsTexTable, track->name);
 
-    track->textureArrayID  = Texture::MakeTextureArray(track->textureMap, false);
+    track->textureArrayID  = Texture::MakeTextureArray(track->textureMap);
     track->nBlocks         = trkFile.nBlocks;
     track->cameraAnimation = canFile.animPoints;
     track->trackBlocks     = _ParseTRKModels(trkFile, colFile, track);
@@ -139,7 +136,7 @@ template <>
 std::shared_ptr<Track> NFS2Loader<PS1>::LoadTrack(const std::string &trackBasePath, NFSVer nfsVersion)
 {
     LOG(INFO) << "Loading Track located at " << trackBasePath;
-    auto track        = std::make_shared<Track>(Track());
+    auto track        = std::make_shared<Track>();
     track->nfsVersion = nfsVersion;
 
     boost::filesystem::path p(trackBasePath);
@@ -159,12 +156,9 @@ std::shared_ptr<Track> NFS2Loader<PS1>::LoadTrack(const std::string &trackBasePa
 
     // Load up the textures
     auto textureBlock = colFile.GetExtraObjectBlock(ExtraBlockID::TEXTURE_BLOCK_ID);
-    for (uint32_t texIdx = 0; texIdx < textureBlock.nTextures; texIdx++)
-    {
-        track->textureMap[textureBlock.polyToQfsTexTable[texIdx].texNumber] = Texture::LoadTexture(track->nfsVersion, textureBlock.polyToQfsTexTable[texIdx], track->name);
-    }
+    track->textureMap = Texture::LoadTextures(track->nfsVersion, textureBlock.polyToQfsTexTable, track->name);
 
-    track->textureArrayID = Texture::MakeTextureArray(track->textureMap, false);
+    track->textureArrayID = Texture::MakeTextureArray(track->textureMap);
     track->nBlocks        = trkFile.nBlocks;
     track->trackBlocks    = _ParseTRKModels(trkFile, colFile, track);
     track->globalObjects  = _ParseCOLModels(colFile, track);
@@ -320,7 +314,7 @@ std::vector<OpenNFS::TrackBlock> NFS2Loader<Platform>::_ParseTRKModels(const Trk
                         {
                             structureNormals.emplace_back(normal);
                             structureVertexIndices.emplace_back(structures[structureIdx].polygonTable[polyIdx].vertex[quadToTriVertNumber]);
-                            structureTextureIndices.emplace_back(polygonTexture.texNumber);
+                            structureTextureIndices.emplace_back(glTexture.layer);
                         }
                     }
 
@@ -392,7 +386,7 @@ std::vector<OpenNFS::TrackBlock> NFS2Loader<Platform>::_ParseTRKModels(const Trk
                 {
                     trackBlockNormals.emplace_back(normal);
                     trackBlockVertexIndices.emplace_back(rawTrackBlock.polygonTable[polyIdx].vertex[quadToTriVertNumber]);
-                    trackBlockTextureIndices.emplace_back(polygonTexture.texNumber);
+                    trackBlockTextureIndices.emplace_back(glTexture.layer);
                 }
             }
 
@@ -516,19 +510,19 @@ std::vector<Entity> NFS2Loader<Platform>::_ParseCOLModels(ColFile<Platform> &col
                                                           globalStructureVertices[structures[structureIdx].polygonTable[polyIdx].vertex[3]]);
 
             // TODO: Use textures alignment data to modify these UV's
-            globalStructureUVs.emplace_back(1.0f * glTexture.maxU, 1.0f * glTexture.maxV);
-            globalStructureUVs.emplace_back(0.0f * glTexture.maxU, 1.0f * glTexture.maxV);
-            globalStructureUVs.emplace_back(0.0f * glTexture.maxU, 0.0f * glTexture.maxV);
-            globalStructureUVs.emplace_back(1.0f * glTexture.maxU, 1.0f * glTexture.maxV);
-            globalStructureUVs.emplace_back(0.0f * glTexture.maxU, 0.0f * glTexture.maxV);
-            globalStructureUVs.emplace_back(1.0f * glTexture.maxU, 0.0f * glTexture.maxV);
+            globalStructureUVs.emplace_back(glTexture.LayerUV(glm::vec2(1.0f, 1.0f)));
+            globalStructureUVs.emplace_back(glTexture.LayerUV(glm::vec2(0.0f, 1.0f)));
+            globalStructureUVs.emplace_back(glTexture.LayerUV(glm::vec2(0.0f, 0.0f)));
+            globalStructureUVs.emplace_back(glTexture.LayerUV(glm::vec2(1.0f, 1.0f)));
+            globalStructureUVs.emplace_back(glTexture.LayerUV(glm::vec2(0.0f, 0.0f)));
+            globalStructureUVs.emplace_back(glTexture.LayerUV(glm::vec2(1.0f, 0.0f)));
 
             // Two triangles per raw quad, hence 6 vertices. Normal data and texture index required per-vertex.
             for (auto &quadToTriVertNumber : quadToTriVertNumbers)
             {
                 globalStructureNormals.push_back(normal);
                 globalStructureVertexIndices.push_back(structures[structureIdx].polygonTable[polyIdx].vertex[quadToTriVertNumber]);
-                globalStructureTextureIndices.push_back(polygonTexture.texNumber);
+                globalStructureTextureIndices.push_back(glTexture.layer);
             }
         }
 
@@ -3,39 +3,39 @@
 using namespace LibOpenNFS::NFS2;
 
 template <typename Platform>
-ExtraObjectBlock<Platform>::ExtraObjectBlock(std::ifstream &trk, NFSVer version)
+ExtraObjectBlock<Platform>::ExtraObjectBlock(MappedStream &trk, NFSVer version)
 {
     this->version = version;
     ASSERT(this->_SerializeIn(trk), "Failed to serialize ExtraObjectBlock from file stream");
 }
 
 template <typename Platform>
-bool ExtraObjectBlock<Platform>::_SerializeIn(std::ifstream &ifstream)
+bool ExtraObjectBlock<Platform>::_SerializeIn(MappedStream &mappedStream)
 {
     // Read the header
-    SAFE_READ(ifstream, &recSize, sizeof(uint32_t));
-    SAFE_READ(ifstream, &id, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nRecords, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &recSize, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &id, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nRecords, sizeof(uint16_t));
 
     switch (id)
     {
     case 2: // First xblock always texture table (in COL)
         nTextures = nRecords;
         polyToQfsTexTable.resize(nTextures);
-        SAFE_READ(ifstream, polyToQfsTexTable.data(), nTextures * sizeof(TEXTURE_BLOCK));
+        SAFE_READ(mappedStream, polyToQfsTexTable.data(), nTextures * sizeof(TEXTURE_BLOCK));
         break;
     case 4:
         nNeighbours = nRecords;
         blockNeighbours.resize(nRecords);
-        SAFE_READ(ifstream, blockNeighbours.data(), nRecords * sizeof(uint16_t));
+        SAFE_READ(mappedStream, blockNeighbours.data(), nRecords * sizeof(uint16_t));
         break;
     case 5:
         polyTypes.resize(nRecords);
-        SAFE_READ(ifstream, polyTypes.data(), nRecords * sizeof(POLY_TYPE));
+        SAFE_READ(mappedStream, polyTypes.data(), nRecords * sizeof(POLY_TYPE));
         break;
     case 6:
         medianData.resize(nRecords);
-        SAFE_READ(ifstream, medianData.data(), nRecords * sizeof(MEDIAN_BLOCK));
+        SAFE_READ(mappedStream, medianData.data(), nRecords * sizeof(MEDIAN_BLOCK));
         break;
     case 7:
     case 18:
@@ -43,20 +43,20 @@ bool ExtraObjectBlock<Platform>::_SerializeIn(std::ifstream &ifstream)
         nStructureReferences = nRecords;
         for (uint32_t structureRefIdx = 0; structureRefIdx < nStructureReferences; ++structureRefIdx)
         {
-            structureReferences.push_back(StructureRefBlock(ifstream));
+            structureReferences.push_back(StructureRefBlock(mappedStream));
         }
         break;
     case 8: // XBID 8 3D Structure data: This block is only present if nExtraBlocks != 2 (COL)
         nStructures = nRecords;
         for (uint32_t structureIdx = 0; structureIdx < nStructures; ++structureIdx)
         {
-            structures.push_back(StructureBlock<Platform>(ifstream));
+            structures.push_back(StructureBlock<Platform>(mappedStream));
         }
         break;
     case 9:
         nLanes = nRecords;
         laneData.resize(nRecords);
-        SAFE_READ(ifstream, laneData.data(), nLanes * sizeof(LANE_BLOCK));
+        SAFE_READ(mappedStream, laneData.data(), nLanes * sizeof(LANE_BLOCK));
         break;
     // case 10: // PS1 Specific id, Misc purpose
     // {
@@ -82,18 +82,18 @@ bool ExtraObjectBlock<Platform>::_SerializeIn(std::ifstream &ifstream)
         if(this->version == NFS_2_PS1)
         {
             ps1VroadData.resize(nVroad);
-            SAFE_READ(ifstream, ps1VroadData.data(), nVroad * sizeof(VROAD_VEC));
+            SAFE_READ(mappedStream, ps1VroadData.data(), nVroad * sizeof(VROAD_VEC));
         }
         else
         {
             vroadData.resize(nVroad);
-            SAFE_READ(ifstream, vroadData.data(), nVroad * sizeof(VROAD));
+            SAFE_READ(mappedStream, vroadData.data(), nVroad * sizeof(VROAD));
         }
         break;
     case 15:
         nCollisionData = nRecords;
         collisionData.resize(nCollisionData);
-        SAFE_READ(ifstream, collisionData.data(), nCollisionData * sizeof(COLLISION_BLOCK));
+        SAFE_READ(mappedStream, collisionData.data(), nCollisionData * sizeof(COLLISION_BLOCK));
         break;
     default:
         LOG(WARNING) << "Unknown XBID: " << id << " nRecords: " << nRecords << " RecSize: " << recSize;
@@ -99,11 +99,11 @@ namespace LibOpenNFS
         };
 
         template <typename Platform>
-        class ExtraObjectBlock : IRawData
+        class ExtraObjectBlock : IMappedRawData
         {
         public:
             ExtraObjectBlock() = default;
-            explicit ExtraObjectBlock(std::ifstream &trk, NFSVer version);
+            explicit ExtraObjectBlock(MappedStream &trk, NFSVer version);
             void _SerializeOut(std::ofstream &ofstream) override;
 
             // ONFS attribute
@@ -155,7 +155,7 @@ namespace LibOpenNFS
             std::vector<COLLISION_BLOCK> collisionData;
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
         };
 
     } // namespace NFS2
@@ -3,27 +3,27 @@
 using namespace LibOpenNFS::NFS2;
 
 template <typename Platform>
-StructureBlock<Platform>::StructureBlock(std::ifstream &ifstream)
+StructureBlock<Platform>::StructureBlock(MappedStream &mappedStream)
 {
-    ASSERT(this->_SerializeIn(ifstream), "Failed to serialize StructureBlock from file stream");
+    ASSERT(this->_SerializeIn(mappedStream), "Failed to serialize StructureBlock from file stream");
 }
 
 template <typename Platform>
-bool StructureBlock<Platform>::_SerializeIn(std::ifstream &ifstream)
+bool StructureBlock<Platform>::_SerializeIn(MappedStream &mappedStream)
 {
-    std::streamoff padCheck = ifstream.tellg();
+    std::streamoff padCheck = mappedStream.tellg();
 
-    SAFE_READ(ifstream, &recSize, sizeof(uint32_t));
-    SAFE_READ(ifstream, &nVerts, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nPoly, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &recSize, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nVerts, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nPoly, sizeof(uint16_t));
 
     vertexTable.resize(nVerts);
-    SAFE_READ(ifstream, vertexTable.data(), nVerts * sizeof(typename Platform::VERT));
+    SAFE_READ(mappedStream, vertexTable.data(), nVerts * sizeof(typename Platform::VERT));
 
     polygonTable.resize(nPoly);
-    SAFE_READ(ifstream, polygonTable.data(), nPoly * sizeof(typename Platform::POLYGONDATA));
+    SAFE_READ(mappedStream, polygonTable.data(), nPoly * sizeof(typename Platform::POLYGONDATA));
 
-    ifstream.seekg(recSize - (ifstream.tellg() - padCheck), std::ios_base::cur); // Eat possible padding
+    mappedStream.seekg(recSize - (mappedStream.tellg() - padCheck), std::ios_base::cur); // Eat possible padding
 
     return true;
 }
@@ -10,11 +10,11 @@ namespace LibOpenNFS
     namespace NFS2
     {
         template <typename Platform>
-        class StructureBlock : private IRawData
+        class StructureBlock : private IMappedRawData
         {
         public:
             StructureBlock() = default;
-            explicit StructureBlock(std::ifstream &ifstream);
+            explicit StructureBlock(MappedStream &mappedStream);
             void _SerializeOut(std::ofstream &ofstream) override;
 
             uint32_t recSize;
@@ -24,7 +24,7 @@ namespace LibOpenNFS
             std::vector<typename Platform::POLYGONDATA> polygonTable;
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
         };
 
     } // namespace NFS2
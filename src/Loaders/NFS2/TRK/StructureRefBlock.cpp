@@ -2,36 +2,36 @@
 
 using namespace LibOpenNFS::NFS2;
 
-StructureRefBlock::StructureRefBlock(std::ifstream &trk)
+StructureRefBlock::StructureRefBlock(MappedStream &trk)
 {
     ASSERT(this->_SerializeIn(trk), "Failed to serialize StructureRefBlock from file stream");
 }
 
-bool StructureRefBlock::_SerializeIn(std::ifstream &ifstream)
+bool StructureRefBlock::_SerializeIn(MappedStream &mappedStream)
 {
-    std::streamoff padCheck = ifstream.tellg();
+    std::streamoff padCheck = mappedStream.tellg();
 
-    SAFE_READ(ifstream, &recSize, sizeof(uint16_t));
-    SAFE_READ(ifstream, &recType, sizeof(uint8_t));
-    SAFE_READ(ifstream, &structureRef, sizeof(uint8_t));
+    SAFE_READ(mappedStream, &recSize, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &recType, sizeof(uint8_t));
+    SAFE_READ(mappedStream, &structureRef, sizeof(uint8_t));
 
     if (recType == 1)
     {
         // Fixed type
-        SAFE_READ(ifstream, &refCoordinates, sizeof(VERT_HIGHP));
+        SAFE_READ(mappedStream, &refCoordinates, sizeof(VERT_HIGHP));
     }
     else if (recType == 3)
     {
         // Animated type
-        SAFE_READ(ifstream, &animLength, sizeof(uint16_t));
-        SAFE_READ(ifstream, &unknown, sizeof(uint16_t));
+        SAFE_READ(mappedStream, &animLength, sizeof(uint16_t));
+        SAFE_READ(mappedStream, &unknown, sizeof(uint16_t));
         animationData.resize(animLength);
-        SAFE_READ(ifstream, animationData.data(), animLength * sizeof(ANIM_POS));
+        SAFE_READ(mappedStream, animationData.data(), animLength * sizeof(ANIM_POS));
     }
     else if (recType == 4)
     {
         // 4 Component PSX Vert data? TODO: Restructure to allow the 4th component to be read
-        SAFE_READ(ifstream, &refCoordinates, sizeof(VERT_HIGHP));
+        SAFE_READ(mappedStream, &refCoordinates, sizeof(VERT_HIGHP));
     }
     else
     {
@@ -39,7 +39,7 @@ bool StructureRefBlock::_SerializeIn(std::ifstream &ifstream)
         return true;
     }
 
-    ifstream.seekg(recSize - (ifstream.tellg() - padCheck), std::ios_base::cur); // Eat possible padding
+    mappedStream.seekg(recSize - (mappedStream.tellg() - padCheck), std::ios_base::cur); // Eat possible padding
 
     return true;
 }
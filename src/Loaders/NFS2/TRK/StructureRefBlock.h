@@ -7,11 +7,11 @@ namespace LibOpenNFS
 {
     namespace NFS2
     {
-        class StructureRefBlock : private IRawData
+        class StructureRefBlock : private IMappedRawData
         {
         public:
             StructureRefBlock() = default;
-            explicit StructureRefBlock(std::ifstream &trk);
+            explicit StructureRefBlock(MappedStream &trk);
             void _SerializeOut(std::ofstream &ofstream) override;
 
             // XBID = 7, 18
@@ -26,7 +26,7 @@ namespace LibOpenNFS
             std::vector<ANIM_POS> animationData; // Sequence of positions which animation follows
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
         };
     } // namespace NFS2
 } // namespace LibOpenNFS
@@ -3,33 +3,33 @@
 using namespace LibOpenNFS::NFS2;
 
 template <typename Platform>
-SuperBlock<Platform>::SuperBlock(std::ifstream &trk, NFSVer version)
+SuperBlock<Platform>::SuperBlock(MappedStream &trk, NFSVer version)
 {
     this->version = version;
     ASSERT(this->_SerializeIn(trk), "Failed to serialize SuperBlock from file stream");
 }
 
 template <typename Platform>
-bool SuperBlock<Platform>::_SerializeIn(std::ifstream &ifstream)
+bool SuperBlock<Platform>::_SerializeIn(MappedStream &mappedStream)
 {
     // TODO: Gross, needs to be relative//passed in
-    std::streampos superblockOffset = ifstream.tellg();
-    SAFE_READ(ifstream, &superBlockSize, sizeof(uint32_t));
-    SAFE_READ(ifstream, &nBlocks, sizeof(uint32_t));
-    SAFE_READ(ifstream, &padding, sizeof(uint32_t));
+    std::streampos superblockOffset = mappedStream.tellg();
+    SAFE_READ(mappedStream, &superBlockSize, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nBlocks, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &padding, sizeof(uint32_t));
 
     if (nBlocks != 0)
     {
         // Get the offsets of the child blocks within superblock
         blockOffsets.resize(nBlocks);
-        SAFE_READ(ifstream, blockOffsets.data(), nBlocks * sizeof(uint32_t));
+        SAFE_READ(mappedStream, blockOffsets.data(), nBlocks * sizeof(uint32_t));
 
         for (uint32_t blockIdx = 0; blockIdx < nBlocks; ++blockIdx)
         {
             // LOG(DEBUG) << "  Block " << block_Idx + 1 << " of " << superblock->nBlocks << " [" << trackblock->header->serialNum << "]";
             // TODO: Fix this
-            ifstream.seekg((uint32_t) superblockOffset + blockOffsets[blockIdx], std::ios_base::beg);
-            trackBlocks.push_back(TrackBlock<Platform>(ifstream, this->version));
+            mappedStream.seekg((uint32_t) superblockOffset + blockOffsets[blockIdx], std::ios_base::beg);
+            trackBlocks.push_back(TrackBlock<Platform>(mappedStream, this->version));
         }
     }
 
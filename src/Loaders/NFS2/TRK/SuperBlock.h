@@ -9,11 +9,11 @@ namespace LibOpenNFS
     namespace NFS2
     {
         template <typename Platform>
-        class SuperBlock : IRawData
+        class SuperBlock : IMappedRawData
         {
         public:
             SuperBlock() = default;
-            explicit SuperBlock(std::ifstream &trk, NFSVer version);
+            explicit SuperBlock(MappedStream &trk, NFSVer version);
             void _SerializeOut(std::ofstream &ofstream) override;
 
             // ONFS attribute
@@ -27,7 +27,7 @@ namespace LibOpenNFS
             std::vector<uint32_t> blockOffsets;
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
         };
     } // namespace NFS2
 } // namespace LibOpenNFS
@@ -3,32 +3,32 @@
 using namespace LibOpenNFS::NFS2;
 
 template <typename Platform>
-TrackBlock<Platform>::TrackBlock(std::ifstream &trk, NFSVer version)
+TrackBlock<Platform>::TrackBlock(MappedStream &trk, NFSVer version)
 {
     this->version = version;
     ASSERT(this->_SerializeIn(trk), "Failed to serialize TrackBlock from file stream");
 }
 
 template <typename Platform>
-bool TrackBlock<Platform>::_SerializeIn(std::ifstream &ifstream)
+bool TrackBlock<Platform>::_SerializeIn(MappedStream &mappedStream)
 {
-    std::streampos trackBlockOffset = ifstream.tellg();
+    std::streampos trackBlockOffset = mappedStream.tellg();
     // Read Header
-    SAFE_READ(ifstream, &blockSize, sizeof(uint32_t));
-    SAFE_READ(ifstream, &blockSizeDup, sizeof(uint32_t));
-    SAFE_READ(ifstream, &nExtraBlocks, sizeof(uint16_t));
-    SAFE_READ(ifstream, &unknown, sizeof(uint16_t));
-    SAFE_READ(ifstream, &serialNum, sizeof(uint32_t));
-    SAFE_READ(ifstream, clippingRect, 4 * sizeof(VERT_HIGHP));
-    SAFE_READ(ifstream, &extraBlockTblOffset, sizeof(uint32_t));
-    SAFE_READ(ifstream, &nStickToNextVerts, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nLowResVert, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nMedResVert, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nHighResVert, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nLowResPoly, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nMedResPoly, sizeof(uint16_t));
-    SAFE_READ(ifstream, &nHighResPoly, sizeof(uint16_t));
-    SAFE_READ(ifstream, unknownPad, 3 * sizeof(uint16_t));
+    SAFE_READ(mappedStream, &blockSize, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &blockSizeDup, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nExtraBlocks, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &unknown, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &serialNum, sizeof(uint32_t));
+    SAFE_READ(mappedStream, clippingRect, 4 * sizeof(VERT_HIGHP));
+    SAFE_READ(mappedStream, &extraBlockTblOffset, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nStickToNextVerts, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nLowResVert, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nMedResVert, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nHighResVert, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nLowResPoly, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nMedResPoly, sizeof(uint16_t));
+    SAFE_READ(mappedStream, &nHighResPoly, sizeof(uint16_t));
+    SAFE_READ(mappedStream, unknownPad, 3 * sizeof(uint16_t));
 
     // Sanity Checks
     if (blockSize != blockSizeDup)
@@ -39,21 +39,21 @@ bool TrackBlock<Platform>::_SerializeIn(std::ifstream &ifstream)
 
     // Read 3D Data
     vertexTable.resize(nStickToNextVerts + nHighResVert);
-    SAFE_READ(ifstream, vertexTable.data(), (nStickToNextVerts + nHighResVert) * sizeof(typename Platform::VERT));
+    SAFE_READ(mappedStream, vertexTable.data(), (nStickToNextVerts + nHighResVert) * sizeof(typename Platform::VERT));
 
     polygonTable.resize(nLowResPoly + nMedResPoly + nHighResPoly);
-    SAFE_READ(ifstream, polygonTable.data(), (nLowResPoly + nMedResPoly + nHighResPoly) * sizeof(typename Platform::POLYGONDATA));
+    SAFE_READ(mappedStream, polygonTable.data(), (nLowResPoly + nMedResPoly + nHighResPoly) * sizeof(typename Platform::POLYGONDATA));
 
     // Read Extrablock data
-    ifstream.seekg((uint32_t) trackBlockOffset + 64u + extraBlockTblOffset, std::ios_base::beg);
+    mappedStream.seekg((uint32_t) trackBlockOffset + 64u + extraBlockTblOffset, std::ios_base::beg);
     // Get extrablock offsets (relative to beginning of TrackBlock)
     extraBlockOffsets.resize(nExtraBlocks);
-    SAFE_READ(ifstream, extraBlockOffsets.data(), nExtraBlocks * sizeof(uint32_t));
+    SAFE_READ(mappedStream, extraBlockOffsets.data(), nExtraBlocks * sizeof(uint32_t));
 
     for (uint32_t extraBlockIdx = 0; extraBlockIdx < nExtraBlocks; ++extraBlockIdx)
     {
-        ifstream.seekg((uint32_t) trackBlockOffset + extraBlockOffsets[extraBlockIdx], std::ios_base::beg);
-        extraObjectBlocks.push_back(ExtraObjectBlock<Platform>(ifstream, this->version));
+        mappedStream.seekg((uint32_t) trackBlockOffset + extraBlockOffsets[extraBlockIdx], std::ios_base::beg);
+        extraObjectBlocks.push_back(ExtraObjectBlock<Platform>(mappedStream, this->version));
         // Map the the block type to the vector index, original ordering is then maintained for output serialisation
         extraObjectBlockMap[(ExtraBlockID)extraObjectBlocks.back().id] = extraBlockIdx;
     }
@@ -11,11 +11,11 @@ namespace LibOpenNFS
     namespace NFS2
     {
         template <typename Platform>
-        class TrackBlock : IRawData
+        class TrackBlock : IMappedRawData
         {
         public:
             TrackBlock() = default;
-            explicit TrackBlock(std::ifstream &trk, NFSVer version);
+            explicit TrackBlock(MappedStream &trk, NFSVer version);
             void _SerializeOut(std::ofstream &ofstream) override;
             ExtraObjectBlock<Platform> GetExtraObjectBlock(ExtraBlockID eBlockType);
             bool IsBlockPresent(ExtraBlockID eBlockType);
@@ -40,7 +40,7 @@ namespace LibOpenNFS
             std::vector<ExtraObjectBlock<Platform>> extraObjectBlocks;
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
 
             // Allows lookup by block type for parsers
             std::map<ExtraBlockID, uint8_t> extraObjectBlockMap;
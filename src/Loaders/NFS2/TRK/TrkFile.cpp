@@ -6,13 +6,10 @@ template <typename Platform>
 bool TrkFile<Platform>::Load(const std::string &trkPath, TrkFile &trkFile, NFSVer version)
 {
     LOG(INFO) << "Loading TRK File located at " << trkPath;
-    std::ifstream trk(trkPath, std::ios::in | std::ios::binary);
+    MappedStream trk(std::make_shared<MappedFile>(trkPath));
     trkFile.version = version;
 
-    bool loadStatus = trkFile._SerializeIn(trk);
-    trk.close();
-
-    return loadStatus;
+    return trkFile._SerializeIn(trk);
 }
 
 template <typename Platform>
@@ -24,10 +21,10 @@ void TrkFile<Platform>::Save(const std::string &trkPath, TrkFile &trkFile)
 }
 
 template <typename Platform>
-bool TrkFile<Platform>::_SerializeIn(std::ifstream &ifstream)
+bool TrkFile<Platform>::_SerializeIn(MappedStream &mappedStream)
 {
     // Check we're in a valid TRK file
-    SAFE_READ(ifstream, header, HEADER_LENGTH);
+    SAFE_READ(mappedStream, header, HEADER_LENGTH);
 
     // Header should contain TRAC
     if (memcmp(header, "TRAC", sizeof(header)) != 0)
@@ -37,27 +34,27 @@ bool TrkFile<Platform>::_SerializeIn(std::ifstream &ifstream)
     }
 
     // Unknown header data
-    SAFE_READ(ifstream, unknownHeader, UNKNOWN_HEADER_LENGTH * sizeof(uint32_t));
+    SAFE_READ(mappedStream, unknownHeader, UNKNOWN_HEADER_LENGTH * sizeof(uint32_t));
 
     // Basic Track data
-    SAFE_READ(ifstream, &nSuperBlocks, sizeof(uint32_t));
-    SAFE_READ(ifstream, &nBlocks, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nSuperBlocks, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nBlocks, sizeof(uint32_t));
 
     // Offsets of Superblocks in TRK file
     superBlockOffsets.resize(nSuperBlocks);
-    SAFE_READ(ifstream, superBlockOffsets.data(), nSuperBlocks * sizeof(uint32_t));
+    SAFE_READ(mappedStream, superBlockOffsets.data(), nSuperBlocks * sizeof(uint32_t));
 
     // Reference coordinates for each block
     blockReferenceCoords.resize(nBlocks);
-    SAFE_READ(ifstream, blockReferenceCoords.data(), nBlocks * sizeof(VERT_HIGHP));
+    SAFE_READ(mappedStream, blockReferenceCoords.data(), nBlocks * sizeof(VERT_HIGHP));
 
     // Go read the superblocks in
     for (uint32_t superBlockIdx = 0; superBlockIdx < nSuperBlocks; ++superBlockIdx)
     {
         LOG(DEBUG) << "SuperBlock " << superBlockIdx + 1 << " of " << nSuperBlocks;
         // Jump to the super block
-        ifstream.seekg(superBlockOffsets[superBlockIdx], std::ios_base::beg);
-        superBlocks.push_back(SuperBlock<Platform>(ifstream, this->version));
+        mappedStream.seekg(superBlockOffsets[superBlockIdx], std::ios_base::beg);
+        superBlocks.push_back(SuperBlock<Platform>(mappedStream, this->version));
     }
 
     return true;
@@ -9,7 +9,7 @@ namespace LibOpenNFS
     namespace NFS2
     {
         template <typename Platform>
-        class TrkFile : IRawData
+        class TrkFile : IMappedRawData
         {
         public:
             TrkFile() = default;
@@ -32,7 +32,7 @@ namespace LibOpenNFS
             std::vector<VERT_HIGHP> blockReferenceCoords;
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
             void _SerializeOut(std::ofstream &ofstream) override;
         };
     } // namespace NFS2
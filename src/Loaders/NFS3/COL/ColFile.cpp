@@ -5,12 +5,10 @@ using namespace LibOpenNFS::NFS3;
 bool ColFile::Load(const std::string &colPath, ColFile &colFile)
 {
     LOG(INFO) << "Loading COL File located at " << colPath;
-    std::ifstream col(colPath, std::ios::in | std::ios::binary);
+    colFile.mappedFile = std::make_shared<MappedFile>(colPath);
+    MappedStream col(colFile.mappedFile);
 
-    bool loadStatus = colFile._SerializeIn(col);
-    col.close();
-
-    return loadStatus;
+    return colFile._SerializeIn(col);
 }
 
 void ColFile::Save(const std::string &colPath, ColFile &colFile)
@@ -20,12 +18,12 @@ void ColFile::Save(const std::string &colPath, ColFile &colFile)
     colFile._SerializeOut(col);
 }
 
-bool ColFile::_SerializeIn(std::ifstream &ifstream)
+bool ColFile::_SerializeIn(MappedStream &mappedStream)
 {
-    SAFE_READ(ifstream, &header, sizeof(char) * 4);
-    SAFE_READ(ifstream, &version, sizeof(uint32_t));
-    SAFE_READ(ifstream, &fileLength, sizeof(uint32_t));
-    SAFE_READ(ifstream, &nBlocks, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &header, sizeof(char) * 4);
+    SAFE_READ(mappedStream, &version, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &fileLength, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nBlocks, sizeof(uint32_t));
 
     if ((memcmp(header, "COLL", sizeof(char)) != 0) || (version != 11) || ((nBlocks != 2) && (nBlocks != 4) && (nBlocks != 5)))
     {
@@ -33,21 +31,20 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
         return false;
     }
 
-    SAFE_READ(ifstream, xbTable, sizeof(uint32_t) * nBlocks);
+    SAFE_READ(mappedStream, xbTable, sizeof(uint32_t) * nBlocks);
 
     // texture XB
-    SAFE_READ(ifstream, &textureHead, sizeof(ExtraBlockHeader));
+    SAFE_READ(mappedStream, &textureHead, sizeof(ExtraBlockHeader));
     if (textureHead.xbid != XBID_TEXTUREINFO)
     {
         return false;
     }
-    texture.resize(textureHead.nrec);
-    SAFE_READ(ifstream, texture.data(), sizeof(ColTextureInfo) * textureHead.nrec);
+    SAFE_VIEW(mappedStream, texture, textureHead.nrec);
 
     // struct3D XB
     if (nBlocks >= 4)
     {
-        SAFE_READ(ifstream, &struct3DHead, sizeof(ExtraBlockHeader));
+        SAFE_READ(mappedStream, &struct3DHead, sizeof(ExtraBlockHeader));
         if (struct3DHead.xbid != XBID_STRUCT3D)
         {
             return false;
@@ -55,9 +52,9 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
         struct3D.resize(struct3DHead.nrec);
         for (uint32_t colRec_Idx = 0; colRec_Idx < struct3DHead.nrec; colRec_Idx++)
         {
-            SAFE_READ(ifstream, &struct3D[colRec_Idx].size, sizeof(uint32_t));
-            SAFE_READ(ifstream, &struct3D[colRec_Idx].nVert, sizeof(uint16_t));
-            SAFE_READ(ifstream, &struct3D[colRec_Idx].nPoly, sizeof(uint16_t));
+            SAFE_READ(mappedStream, &struct3D[colRec_Idx].size, sizeof(uint32_t));
+            SAFE_READ(mappedStream, &struct3D[colRec_Idx].nVert, sizeof(uint16_t));
+            SAFE_READ(mappedStream, &struct3D[colRec_Idx].nPoly, sizeof(uint16_t));
 
             int32_t delta = (8 + sizeof(ColVertex) * struct3D[colRec_Idx].nVert + sizeof(ColPolygon) * struct3D[colRec_Idx].nPoly) % 4;
             delta         = (4 - delta) % 4;
@@ -69,24 +66,22 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
             }
 
             // Grab the vertices
-            struct3D[colRec_Idx].vertex.resize(struct3D[colRec_Idx].nVert);
-            SAFE_READ(ifstream, struct3D[colRec_Idx].vertex.data(), sizeof(ColVertex) * struct3D[colRec_Idx].nVert);
+            SAFE_VIEW(mappedStream, struct3D[colRec_Idx].vertex, struct3D[colRec_Idx].nVert);
 
             // And Polygons
-            struct3D[colRec_Idx].polygon.resize(struct3D[colRec_Idx].nPoly);
-            SAFE_READ(ifstream, struct3D[colRec_Idx].polygon.data(), sizeof(ColPolygon) * struct3D[colRec_Idx].nPoly);
+            SAFE_VIEW(mappedStream, struct3D[colRec_Idx].polygon, struct3D[colRec_Idx].nPoly);
 
             // Consume the delta, to eat alignment bytes
             int dummy;
             if (delta > 0)
             {
-                SAFE_READ(ifstream, &dummy, delta);
+                SAFE_READ(mappedStream, &dummy, delta);
             }
         }
 
         // TODO: Share this code between both XOBJ parse runs
         // object XB
-        SAFE_READ(ifstream, &objectHead, sizeof(ExtraBlockHeader));
+        SAFE_READ(mappedStream, &objectHead, sizeof(ExtraBlockHeader));
         if ((objectHead.xbid != XBID_OBJECT) && (objectHead.xbid != XBID_OBJECT2))
         {
             return false;
@@ -94,9 +89,9 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
         object.resize(objectHead.nrec);
         for (uint32_t xobjIdx = 0; xobjIdx < objectHead.nrec; xobjIdx++)
         {
-            SAFE_READ(ifstream, &object[xobjIdx].size, sizeof(uint16_t));
-            SAFE_READ(ifstream, &object[xobjIdx].type, sizeof(uint8_t));
-            SAFE_READ(ifstream, &object[xobjIdx].struct3D, sizeof(uint8_t));
+            SAFE_READ(mappedStream, &object[xobjIdx].size, sizeof(uint16_t));
+            SAFE_READ(mappedStream, &object[xobjIdx].type, sizeof(uint8_t));
+            SAFE_READ(mappedStream, &object[xobjIdx].struct3D, sizeof(uint8_t));
 
             if (object[xobjIdx].type == 1)
             {
@@ -104,19 +99,19 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
                 {
                     return false;
                 }
-                SAFE_READ(ifstream, &object[xobjIdx].ptRef, sizeof(glm::ivec3));
+                SAFE_READ(mappedStream, &object[xobjIdx].ptRef, sizeof(glm::ivec3));
             }
             else if (object[xobjIdx].type == 3)
             {
-                SAFE_READ(ifstream, &object[xobjIdx].animLength, sizeof(uint16_t));
-                SAFE_READ(ifstream, &object[xobjIdx].unknown, sizeof(uint16_t));
+                SAFE_READ(mappedStream, &object[xobjIdx].animLength, sizeof(uint16_t));
+                SAFE_READ(mappedStream, &object[xobjIdx].unknown, sizeof(uint16_t));
                 if (object[xobjIdx].size != 8 + 20 * object[xobjIdx].animLength)
                 {
                     return false;
                 }
 
                 object[xobjIdx].animData.resize(object[xobjIdx].animLength);
-                SAFE_READ(ifstream, object[xobjIdx].animData.data(), sizeof(AnimData) * object[xobjIdx].animLength);
+                SAFE_READ(mappedStream, object[xobjIdx].animData.data(), sizeof(AnimData) * object[xobjIdx].animLength);
                 // Make a ref point from first anim position
                 object[xobjIdx].ptRef = Utils::FixedToFloat(object[xobjIdx].animData[0].pt);
             }
@@ -131,7 +126,7 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
     // object2 XB
     if (nBlocks == 5)
     {
-        SAFE_READ(ifstream, &object2Head, 8);
+        SAFE_READ(mappedStream, &object2Head, 8);
         if ((object2Head.xbid != XBID_OBJECT) && (object2Head.xbid != XBID_OBJECT2))
         {
             return false;
@@ -139,9 +134,9 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
         object2.resize(object2Head.nrec);
         for (uint32_t xobjIdx = 0; xobjIdx < object2Head.nrec; xobjIdx++)
         {
-            SAFE_READ(ifstream, &object2[xobjIdx].size, sizeof(uint16_t));
-            SAFE_READ(ifstream, &object2[xobjIdx].type, sizeof(uint8_t));
-            SAFE_READ(ifstream, &object2[xobjIdx].struct3D, sizeof(uint8_t));
+            SAFE_READ(mappedStream, &object2[xobjIdx].size, sizeof(uint16_t));
+            SAFE_READ(mappedStream, &object2[xobjIdx].type, sizeof(uint8_t));
+            SAFE_READ(mappedStream, &object2[xobjIdx].struct3D, sizeof(uint8_t));
 
             if (object2[xobjIdx].type == 1)
             {
@@ -149,19 +144,19 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
                 {
                     return false;
                 }
-                SAFE_READ(ifstream, &object2[xobjIdx].ptRef, sizeof(glm::ivec3));
+                SAFE_READ(mappedStream, &object2[xobjIdx].ptRef, sizeof(glm::ivec3));
             }
             else if (object2[xobjIdx].type == 3)
             {
-                SAFE_READ(ifstream, &object2[xobjIdx].animLength, sizeof(uint16_t));
-                SAFE_READ(ifstream, &object2[xobjIdx].unknown, sizeof(uint16_t));
+                SAFE_READ(mappedStream, &object2[xobjIdx].animLength, sizeof(uint16_t));
+                SAFE_READ(mappedStream, &object2[xobjIdx].unknown, sizeof(uint16_t));
                 if (object2[xobjIdx].size != 8 + 20 * object2[xobjIdx].animLength)
                 {
                     return false;
                 }
 
                 object2[xobjIdx].animData.resize(object2[xobjIdx].animLength);
-                SAFE_READ(ifstream, object2[xobjIdx].animData.data(), sizeof(AnimData) * object2[xobjIdx].animLength);
+                SAFE_READ(mappedStream, object2[xobjIdx].animData.data(), sizeof(AnimData) * object2[xobjIdx].animLength);
                 // Make a ref point from first anim position
                 object2[xobjIdx].ptRef = Utils::FixedToFloat(object2[xobjIdx].animData[0].pt);
             }
@@ -174,13 +169,12 @@ bool ColFile::_SerializeIn(std::ifstream &ifstream)
     }
 
     // vroad XB
-    SAFE_READ(ifstream, &vroadHead, 8);
+    SAFE_READ(mappedStream, &vroadHead, 8);
     if (vroadHead.xbid != XBID_VROAD || (vroadHead.size != 8 + sizeof(ColVRoad) * vroadHead.nrec))
     {
         return false;
     }
-    vroad.resize(vroadHead.nrec);
-    SAFE_READ(ifstream, vroad.data(), sizeof(ColVRoad) * vroadHead.nrec);
+    SAFE_VIEW(mappedStream, vroad, vroadHead.nrec);
 
     return true;
 }
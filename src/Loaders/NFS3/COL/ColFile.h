@@ -44,8 +44,8 @@ namespace LibOpenNFS
         {
             uint32_t size;
             uint16_t nVert, nPoly;
-            std::vector<ColVertex> vertex;
-            std::vector<ColPolygon> polygon;
+            RawView<ColVertex> vertex;
+            RawView<ColPolygon> polygon;
         };
 
         struct ColObject
@@ -69,7 +69,7 @@ namespace LibOpenNFS
             uint32_t leftWall, rightWall;
         };
 
-        class ColFile : IRawData
+        class ColFile : IMappedRawData
         {
         public:
             ColFile() = default;
@@ -82,7 +82,7 @@ namespace LibOpenNFS
             uint32_t nBlocks;                    // Number of Xtra blocks in file
             uint32_t xbTable[5];                 // Offsets of Xtra blocks
             ExtraBlockHeader textureHead = {};   // Record detailing texture table data
-            std::vector<ColTextureInfo> texture; // Texture table
+            RawView<ColTextureInfo> texture;    // Texture table
             ExtraBlockHeader struct3DHead = {};  // Record detailing struct3D table data
             std::vector<ColStruct3D> struct3D;   // Struct 3D table
             ExtraBlockHeader objectHead = {};    // Record detailing object table data
@@ -90,11 +90,14 @@ namespace LibOpenNFS
             ExtraBlockHeader object2Head = {};   // Record detailing extra object data
             std::vector<ColObject> object2;      // Extra object data
             ExtraBlockHeader vroadHead = {};     // Unknown Record detailing unknown table data
-            std::vector<ColVRoad> vroad;         // Unknown table
+            RawView<ColVRoad> vroad;            // Unknown table
             uint32_t *hs_extra = nullptr;        // for the extra HS data in ColVRoad
 
+            // Backing storage for the RawView tables above, must outlive them
+            std::shared_ptr<MappedFile> mappedFile;
+
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
             void _SerializeOut(std::ofstream &ofstream) override;
         };
     } // namespace NFS3
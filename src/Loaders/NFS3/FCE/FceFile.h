@@ -22,17 +22,19 @@ namespace LibOpenNFS
 
         struct CarPart
         {
-            std::vector<glm::vec3> vertices;
-            std::vector<glm::vec3> normals;
-            std::vector<Triangle> triangles;
+            RawView<glm::vec3> vertices;
+            RawView<glm::vec3> normals;
+            RawView<Triangle> triangles;
         };
 
-        class FceFile : IRawData
+        class FceFile : IMappedRawData
         {
         public:
             FceFile() = default;
 
             static bool Load(const std::string &fcePath, FceFile &fceFile);
+            // Parse an FCE held elsewhere, e.g. inside a car VIV
+            static bool Load(MappedStream &fceStream, FceFile &fceFile);
             static void Save(const std::string &fcePath, FceFile &fceFile);
 
             uint32_t unknown;
@@ -63,8 +65,11 @@ namespace LibOpenNFS
             uint32_t unknownTable[64];
             std::vector<CarPart> carParts;
 
+            // Backing storage for the RawView tables of the car parts, must outlive them
+            std::shared_ptr<MappedFile> mappedFile;
+
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
             void _SerializeOut(std::ofstream &ofstream) override;
         };
     } // namespace NFS3
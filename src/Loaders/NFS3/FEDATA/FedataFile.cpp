@@ -5,13 +5,16 @@ using namespace LibOpenNFS::NFS3;
 bool FedataFile::Load(const std::string &fedataPath, FedataFile &fedataFile, uint8_t nPriColours)
 {
     LOG(INFO) << "Loading Fedata File located at " << fedataPath;
-    std::ifstream fedata(fedataPath, std::ios::in | std::ios::binary);
+    MappedStream fedata(std::make_shared<MappedFile>(fedataPath));
 
+    return Load(fedata, fedataFile, nPriColours);
+}
+
+bool FedataFile::Load(MappedStream &fedataStream, FedataFile &fedataFile, uint8_t nPriColours)
+{
     fedataFile.m_nPriColours = nPriColours;
-    bool loadStatus          = fedataFile._SerializeIn(fedata);
-    fedata.close();
 
-    return loadStatus;
+    return fedataFile._SerializeIn(fedataStream);
 }
 
 void FedataFile::Save(const std::string &fedataPath, FedataFile &fedataFile)
@@ -21,36 +24,48 @@ void FedataFile::Save(const std::string &fedataPath, FedataFile &fedataFile)
     fedataFile._SerializeOut(fedata);
 }
 
-bool FedataFile::_SerializeIn(std::ifstream &ifstream)
+bool FedataFile::_SerializeIn(MappedStream &mappedStream)
 {
     // TODO: Hugely incomplete. Old style parser shoehorned into new format, need all structs. No seekg. /AS
     // Go get the offset of car name
     uint32_t menuNameOffset = 0;
-    ifstream.seekg(MENU_NAME_FILEPOS_OFFSET, std::ios::beg);
-    SAFE_READ(ifstream, &menuNameOffset, sizeof(uint32_t));
-    ifstream.seekg(menuNameOffset, std::ios::beg);
+    mappedStream.seekg(MENU_NAME_FILEPOS_OFFSET, std::ios::beg);
+    SAFE_READ(mappedStream, &menuNameOffset, sizeof(uint32_t));
+    mappedStream.seekg(menuNameOffset, std::ios::beg);
 
     char carMenuName[64];
-    SAFE_READ(ifstream, &carMenuName, sizeof(char) * 64);
+    SAFE_READ(mappedStream, &carMenuName, sizeof(char) * 64);
     menuName = carMenuName;
 
     // Jump to location of FILEPOS table for car colour names
-    ifstream.seekg(COLOUR_TABLE_OFFSET, std::ios::beg);
+    mappedStream.seekg(COLOUR_TABLE_OFFSET, std::ios::beg);
     // Read that table in
     std::vector<uint32_t> colourNameOffsets(m_nPriColours);
-    SAFE_READ(ifstream, colourNameOffsets.data(), m_nPriColours * sizeof(uint32_t));
+    SAFE_READ(mappedStream, colourNameOffsets.data(), m_nPriColours * sizeof(uint32_t));
 
     for (uint8_t colourIdx = 0; colourIdx < m_nPriColours; ++colourIdx)
     {
-        ifstream.seekg(colourNameOffsets[colourIdx], std::ios::beg);
-        std::string colourName;
-        std::getline(ifstream, colourName, '\0');
+        mappedStream.seekg(colourNameOffsets[colourIdx], std::ios::beg);
+        std::string colourName = _ReadString(mappedStream);
         primaryColourNames.emplace_back(colourName.begin(), colourName.end());
     }
 
     return true;
 }
 
+std::string FedataFile::_ReadString(MappedStream &mappedStream)
+{
+    // Equivalent of std::getline(stream, string, '\0')
+    std::string string;
+    char c;
+    while (mappedStream.read(&c, sizeof(char)).gcount() == sizeof(char) && c != '\0')
+    {
+        string.push_back(c);
+    }
+
+    return string;
+}
+
 void FedataFile::_SerializeOut(std::ofstream &ofstream)
 {
     ASSERT(false, "Fedata output serialization is not currently implemented");
@@ -2,38 +2,76 @@
 
 using namespace LibOpenNFS::NFS3;
 
-ExtraObjectBlock::ExtraObjectBlock(std::ifstream &frd)
+ExtraObjectBlock::ExtraObjectBlock(MappedStream &frd)
 {
     ASSERT(this->_SerializeIn(frd), "Failed to serialize ExtraObjectBlock from file stream");
 }
 
-bool ExtraObjectBlock::_SerializeIn(std::ifstream &ifstream)
+bool ExtraObjectBlock::Skip(MappedStream &frd)
 {
-    SAFE_READ(ifstream, &(nobj), sizeof(uint32_t));
+    uint32_t nobj = 0;
+    SAFE_READ(frd, &nobj, sizeof(uint32_t));
+
+    for (uint32_t xobjIdx = 0; xobjIdx < nobj; ++xobjIdx)
+    {
+        uint32_t crosstype = 0;
+        SAFE_READ(frd, &crosstype, sizeof(uint32_t));
+        // crossno, unknown
+        frd.seekg(sizeof(uint32_t) * 2, std::ios_base::cur);
+
+        if (crosstype == 4)
+        {
+            // ptRef, AnimMemory
+            frd.seekg(sizeof(glm::vec3) + sizeof(uint32_t), std::ios_base::cur);
+        }
+        else if (crosstype == 3)
+        {
+            // unknown3, type3, objno
+            uint16_t nAnimLength = 0;
+            frd.seekg((sizeof(uint16_t) * 9) + (sizeof(uint8_t) * 2), std::ios_base::cur);
+            SAFE_READ(frd, &nAnimLength, sizeof(uint16_t));
+            frd.seekg(sizeof(uint16_t) + (sizeof(AnimData) * nAnimLength), std::ios_base::cur);
+        }
+        else
+            return false; // unknown object type
+
+        uint32_t nVertices = 0, nPolygons = 0;
+        SAFE_READ(frd, &nVertices, sizeof(uint32_t));
+        frd.seekg((sizeof(glm::vec3) + sizeof(uint32_t)) * nVertices, std::ios_base::cur);
+        SAFE_READ(frd, &nPolygons, sizeof(uint32_t));
+        frd.seekg(sizeof(PolygonData) * nPolygons, std::ios_base::cur);
+    }
+
+    return !frd.fail();
+}
+
+bool ExtraObjectBlock::_SerializeIn(MappedStream &mappedStream)
+{
+    SAFE_READ(mappedStream, &(nobj), sizeof(uint32_t));
     obj.reserve(nobj);
 
     for (uint32_t xobjIdx = 0; xobjIdx < nobj; ++xobjIdx)
     {
         ExtraObjectData x;
 
-        SAFE_READ(ifstream, &x.crosstype, sizeof(uint32_t));
-        SAFE_READ(ifstream, &x.crossno, sizeof(uint32_t));
-        SAFE_READ(ifstream, &x.unknown, sizeof(uint32_t));
+        SAFE_READ(mappedStream, &x.crosstype, sizeof(uint32_t));
+        SAFE_READ(mappedStream, &x.crossno, sizeof(uint32_t));
+        SAFE_READ(mappedStream, &x.unknown, sizeof(uint32_t));
 
         if (x.crosstype == 4)
         {
             // Basic objects
-            SAFE_READ(ifstream, &x.ptRef, sizeof(glm::vec3));
-            SAFE_READ(ifstream, &x.AnimMemory, sizeof(uint32_t));
+            SAFE_READ(mappedStream, &x.ptRef, sizeof(glm::vec3));
+            SAFE_READ(mappedStream, &x.AnimMemory, sizeof(uint32_t));
         }
         else if (x.crosstype == 3)
         {
             // Animated objects
-            SAFE_READ(ifstream, &x.unknown3, sizeof(uint16_t) * 9);
-            SAFE_READ(ifstream, &x.type3, sizeof(uint8_t));
-            SAFE_READ(ifstream, &x.objno, sizeof(uint8_t));
-            SAFE_READ(ifstream, &x.nAnimLength, sizeof(uint16_t));
-            SAFE_READ(ifstream, &x.AnimDelay, sizeof(uint16_t));
+            SAFE_READ(mappedStream, &x.unknown3, sizeof(uint16_t) * 9);
+            SAFE_READ(mappedStream, &x.type3, sizeof(uint8_t));
+            SAFE_READ(mappedStream, &x.objno, sizeof(uint8_t));
+            SAFE_READ(mappedStream, &x.nAnimLength, sizeof(uint16_t));
+            SAFE_READ(mappedStream, &x.AnimDelay, sizeof(uint16_t));
 
             // Sanity Check
             if (x.type3 != 3)
@@ -42,7 +80,7 @@ bool ExtraObjectBlock::_SerializeIn(std::ifstream &ifstream)
             }
 
             x.animData.resize(x.nAnimLength);
-            SAFE_READ(ifstream, x.animData.data(), sizeof(AnimData) * x.nAnimLength);
+            SAFE_READ(mappedStream, x.animData.data(), sizeof(AnimData) * x.nAnimLength);
             // make a ref point from first anim position
             x.ptRef = Utils::FixedToFloat(x.animData[0].pt);
         }
@@ -50,22 +88,22 @@ bool ExtraObjectBlock::_SerializeIn(std::ifstream &ifstream)
             return false; // unknown object type
 
         // Get number of vertices
-        SAFE_READ(ifstream, &(x.nVertices), sizeof(uint32_t));
+        SAFE_READ(mappedStream, &(x.nVertices), sizeof(uint32_t));
 
         // Get vertices
         x.vert.resize(x.nVertices);
-        SAFE_READ(ifstream, x.vert.data(), sizeof(glm::vec3) * x.nVertices);
+        SAFE_READ(mappedStream, x.vert.data(), sizeof(glm::vec3) * x.nVertices);
 
         // Per vertex shading data (RGBA)
         x.vertShading.resize(x.nVertices);
-        SAFE_READ(ifstream, x.vertShading.data(), sizeof(uint32_t) * x.nVertices);
+        SAFE_READ(mappedStream, x.vertShading.data(), sizeof(uint32_t) * x.nVertices);
 
         // Get number of polygons
-        SAFE_READ(ifstream, &(x.nPolygons), sizeof(uint32_t));
+        SAFE_READ(mappedStream, &(x.nPolygons), sizeof(uint32_t));
 
         // Grab the polygons
         x.polyData.resize(x.nPolygons);
-        SAFE_READ(ifstream, x.polyData.data(), sizeof(PolygonData) * x.nPolygons);
+        SAFE_READ(mappedStream, x.polyData.data(), sizeof(PolygonData) * x.nPolygons);
 
         obj.push_back(x);
     }
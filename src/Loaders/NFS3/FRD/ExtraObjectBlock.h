@@ -29,12 +29,13 @@ namespace LibOpenNFS
             std::vector<PolygonData> polyData;
         };
 
-        class ExtraObjectBlock : IRawData
+        class ExtraObjectBlock : IMappedRawData
         {
         public:
             ExtraObjectBlock() = default;
 
-            explicit ExtraObjectBlock(std::ifstream &frd);
+            explicit ExtraObjectBlock(MappedStream &frd);
+            static bool Skip(MappedStream &frd);
 
             void _SerializeOut(std::ofstream &ofstream) override;
 
@@ -42,7 +43,7 @@ namespace LibOpenNFS
             std::vector<ExtraObjectData> obj;
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
         };
     } // namespace NFS3
 } // namespace LibOpenNFS
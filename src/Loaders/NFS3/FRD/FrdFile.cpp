@@ -1,16 +1,16 @@
 #include "FrdFile.h"
 
+#include "../../../Util/ThreadPool.h"
+
 using namespace LibOpenNFS::NFS3;
 
 bool FrdFile::Load(const std::string &frdPath, FrdFile &frdFile)
 {
     LOG(INFO) << "Loading FRD File located at " << frdPath;
-    std::ifstream frd(frdPath, std::ios::in | std::ios::binary);
-
-    bool loadStatus = frdFile._SerializeIn(frd);
-    frd.close();
+    frdFile.mappedFile = std::make_shared<MappedFile>(frdPath);
+    MappedStream frd(frdFile.mappedFile);
 
-    return loadStatus;
+    return frdFile._SerializeIn(frd);
 }
 
 void FrdFile::Save(const std::string &frdPath, FrdFile &frdFile)
@@ -32,10 +32,10 @@ void FrdFile::MergeFRD(const std::string &frdPath, FrdFile &frdFileA, FrdFile &f
     FrdFile::Save(frdPath, frdFileA);
 }
 
-bool FrdFile::_SerializeIn(std::ifstream &ifstream)
+bool FrdFile::_SerializeIn(MappedStream &mappedStream)
 {
-    SAFE_READ(ifstream, header, HEADER_LENGTH);
-    SAFE_READ(ifstream, &nBlocks, sizeof(uint32_t));
+    SAFE_READ(mappedStream, header, HEADER_LENGTH);
+    SAFE_READ(mappedStream, &nBlocks, sizeof(uint32_t));
     ++nBlocks;
 
     if (nBlocks < 1 || nBlocks > 500)
@@ -43,13 +43,9 @@ bool FrdFile::_SerializeIn(std::ifstream &ifstream)
         return false;
     }
 
-    trackBlocks.reserve(nBlocks);
-    polygonBlocks.reserve(nBlocks);
-    extraObjectBlocks.reserve((4 * nBlocks) + 1);
-
     // Detect NFS3 or NFSHS
     int32_t hsMagic = 0;
-    SAFE_READ(ifstream, &hsMagic, sizeof(int32_t));
+    SAFE_READ(mappedStream, &hsMagic, sizeof(int32_t));
 
     if ((hsMagic < 0) || (hsMagic > 5000))
     {
@@ -66,29 +62,61 @@ bool FrdFile::_SerializeIn(std::ifstream &ifstream)
     }
 
     // Back up a little, as this sizeof(int32_t) into a trackblock that we're about to deserialize
-    ifstream.seekg(-4, std::ios_base::cur);
+    mappedStream.seekg(-4, std::ios_base::cur);
 
-    // Track Data
-    for (uint32_t blockIdx = 0; blockIdx < nBlocks; ++blockIdx)
+    // Block sizes are only known once the preceding block is parsed, so do a cheap pass over the table counts to find where each block
+    // starts. The blocks can then be decoded independently of one another.
+    std::vector<std::streamoff> trkBlockOffsets(nBlocks), polyBlockOffsets(nBlocks), extraObjectBlockOffsets((4 * nBlocks) + 1);
+    for (auto &trkBlockOffset : trkBlockOffsets)
     {
-        trackBlocks.push_back(TrkBlock(ifstream));
+        trkBlockOffset = mappedStream.tellg();
+        if (!TrkBlock::Skip(mappedStream))
+        {
+            return false;
+        }
     }
-    // Geometry
-    for (uint32_t blockIdx = 0; blockIdx < nBlocks; ++blockIdx)
+    for (auto &polyBlockOffset : polyBlockOffsets)
     {
-        polygonBlocks.push_back(PolyBlock(ifstream, trackBlocks[blockIdx].nPolygons));
+        polyBlockOffset = mappedStream.tellg();
+        if (!PolyBlock::Skip(mappedStream))
+        {
+            return false;
+        }
     }
-    // Extra Track Geometry
-    for (uint32_t blockIdx = 0; blockIdx <= 4 * nBlocks; ++blockIdx)
+    for (auto &extraObjectBlockOffset : extraObjectBlockOffsets)
     {
-        extraObjectBlocks.push_back(ExtraObjectBlock(ifstream));
+        extraObjectBlockOffset = mappedStream.tellg();
+        if (!ExtraObjectBlock::Skip(mappedStream))
+        {
+            return false;
+        }
     }
+
+    trackBlocks.resize(nBlocks);
+    polygonBlocks.resize(nBlocks);
+    extraObjectBlocks.resize((4 * nBlocks) + 1);
+
+    // Track Data and Geometry. PolyBlocks sanity check against the polygon count of their TrkBlock, so decode them as a pair.
+    ThreadPool::Get().ParallelFor(nBlocks, [&](size_t blockIdx) {
+        MappedStream blockStream(mappedStream);
+        blockStream.seekg(trkBlockOffsets[blockIdx], std::ios_base::beg);
+        trackBlocks[blockIdx] = TrkBlock(blockStream);
+        blockStream.seekg(polyBlockOffsets[blockIdx], std::ios_base::beg);
+        polygonBlocks[blockIdx] = PolyBlock(blockStream, trackBlocks[blockIdx].nPolygons);
+    });
+    // Extra Track Geometry
+    ThreadPool::Get().ParallelFor(extraObjectBlocks.size(), [&](size_t blockIdx) {
+        MappedStream blockStream(mappedStream);
+        blockStream.seekg(extraObjectBlockOffsets[blockIdx], std::ios_base::beg);
+        extraObjectBlocks[blockIdx] = ExtraObjectBlock(blockStream);
+    });
+
     // Texture Table
-    SAFE_READ(ifstream, &nTextures, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nTextures, sizeof(uint32_t));
     textureBlocks.reserve(nTextures);
     for (uint32_t tex_Idx = 0; tex_Idx < nTextures; tex_Idx++)
     {
-        textureBlocks.push_back(TexBlock(ifstream));
+        textureBlocks.push_back(TexBlock(mappedStream));
     }
 
     return true;
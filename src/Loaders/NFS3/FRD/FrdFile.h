@@ -13,7 +13,7 @@ namespace LibOpenNFS
     {
         static const uint8_t HEADER_LENGTH = 28;
 
-        class FrdFile : IRawData
+        class FrdFile : IMappedRawData
         {
         public:
             FrdFile() = default;
@@ -31,8 +31,11 @@ namespace LibOpenNFS
             std::vector<ExtraObjectBlock> extraObjectBlocks;
             std::vector<TexBlock> textureBlocks;
 
+            // Backing storage for the RawView tables inside the blocks above, must outlive them
+            std::shared_ptr<MappedFile> mappedFile;
+
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
             void _SerializeOut(std::ofstream &ofstream) override;
         };
     } // namespace NFS3
@@ -2,25 +2,62 @@
 
 using namespace LibOpenNFS::NFS3;
 
-PolyBlock::PolyBlock(std::ifstream &frd, uint32_t nTrackBlockPolys) : m_nTrackBlockPolys(nTrackBlockPolys), obj{}
+PolyBlock::PolyBlock(MappedStream &frd, uint32_t nTrackBlockPolys) : m_nTrackBlockPolys(nTrackBlockPolys), obj{}
 {
     ASSERT(this->_SerializeIn(frd), "Failed to serialize PolyBlock from file stream");
 }
 
-bool PolyBlock::_SerializeIn(std::ifstream &ifstream)
+bool PolyBlock::Skip(MappedStream &frd)
 {
     for (uint32_t polyBlockIdx = 0; polyBlockIdx < NUM_POLYGON_BLOCKS; polyBlockIdx++)
     {
-        SAFE_READ(ifstream, &sz[polyBlockIdx], sizeof(uint32_t));
+        uint32_t sz = 0;
+        SAFE_READ(frd, &sz, sizeof(uint32_t));
+        if (sz != 0)
+        {
+            // Skip szdup and the polygons
+            frd.seekg(sizeof(uint32_t) + (sizeof(PolygonData) * sz), std::ios_base::cur);
+        }
+    }
+
+    for (uint32_t objChunkIdx = 0; objChunkIdx < NUM_POLYOBJ_CHUNKS; ++objChunkIdx)
+    {
+        uint32_t n1 = 0, n2 = 0;
+        SAFE_READ(frd, &n1, sizeof(uint32_t));
+        if (n1 > 0)
+        {
+            SAFE_READ(frd, &n2, sizeof(uint32_t));
+            for (uint32_t k = 0; k < n2; ++k)
+            {
+                uint32_t type = 0;
+                SAFE_READ(frd, &type, sizeof(uint32_t));
+                if (type == 1)
+                {
+                    uint32_t numpoly = 0;
+                    SAFE_READ(frd, &numpoly, sizeof(uint32_t));
+                    frd.seekg(sizeof(PolygonData) * numpoly, std::ios_base::cur);
+                }
+            }
+        }
+    }
+
+    return !frd.fail();
+}
+
+bool PolyBlock::_SerializeIn(MappedStream &mappedStream)
+{
+    for (uint32_t polyBlockIdx = 0; polyBlockIdx < NUM_POLYGON_BLOCKS; polyBlockIdx++)
+    {
+        SAFE_READ(mappedStream, &sz[polyBlockIdx], sizeof(uint32_t));
         if (sz[polyBlockIdx] != 0)
         {
-            SAFE_READ(ifstream, &szdup[polyBlockIdx], sizeof(uint32_t));
+            SAFE_READ(mappedStream, &szdup[polyBlockIdx], sizeof(uint32_t));
             if (szdup[polyBlockIdx] != sz[polyBlockIdx])
             {
                 return false;
             }
             poly[polyBlockIdx] = std::vector<PolygonData>(sz[polyBlockIdx]);
-            SAFE_READ(ifstream, poly[polyBlockIdx].data(), sizeof(PolygonData) * sz[polyBlockIdx]);
+            SAFE_READ(mappedStream, poly[polyBlockIdx].data(), sizeof(PolygonData) * sz[polyBlockIdx]);
         }
     }
 
@@ -32,10 +69,10 @@ bool PolyBlock::_SerializeIn(std::ifstream &ifstream)
 
     for (auto &o : obj)
     {
-        SAFE_READ(ifstream, &o.n1, sizeof(uint32_t));
+        SAFE_READ(mappedStream, &o.n1, sizeof(uint32_t));
         if (o.n1 > 0)
         {
-            SAFE_READ(ifstream, &o.n2, sizeof(uint32_t));
+            SAFE_READ(mappedStream, &o.n2, sizeof(uint32_t));
 
             o.types.resize(o.n2);
             o.numpoly.resize(o.n2);
@@ -46,14 +83,14 @@ bool PolyBlock::_SerializeIn(std::ifstream &ifstream)
 
             for (uint32_t k = 0; k < o.n2; ++k)
             {
-                SAFE_READ(ifstream, &o.types[k], sizeof(uint32_t));
+                SAFE_READ(mappedStream, &o.types[k], sizeof(uint32_t));
 
                 if (o.types[k] == 1)
                 {
-                    SAFE_READ(ifstream, &o.numpoly[o.nobj], sizeof(uint32_t));
+                    SAFE_READ(mappedStream, &o.numpoly[o.nobj], sizeof(uint32_t));
 
                     o.poly[o.nobj] = std::vector<PolygonData>(o.numpoly[o.nobj]);
-                    SAFE_READ(ifstream, o.poly[o.nobj].data(), sizeof(PolygonData) * o.numpoly[o.nobj]);
+                    SAFE_READ(mappedStream, o.poly[o.nobj].data(), sizeof(PolygonData) * o.numpoly[o.nobj]);
 
                     polygonCount += o.numpoly[o.nobj];
                     ++o.nobj;
@@ -22,11 +22,12 @@ namespace LibOpenNFS
             std::vector<std::vector<PolygonData>> poly; // the polygons themselves
         };
 
-        class PolyBlock : private IRawData
+        class PolyBlock : private IMappedRawData
         {
         public:
             PolyBlock() = default;
-            explicit PolyBlock(std::ifstream &frd, uint32_t nTrackBlockPolys);
+            explicit PolyBlock(MappedStream &frd, uint32_t nTrackBlockPolys);
+            static bool Skip(MappedStream &frd);
             void _SerializeOut(std::ofstream &ofstream) override;
 
             uint32_t m_nTrackBlockPolys;
@@ -40,7 +41,7 @@ namespace LibOpenNFS
             // the 1st chunk is described anyway in the TRKBLOCK
 
         private:
-            bool _SerializeIn(std::ifstream &ifstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
         };
 
     } // namespace NFS3
@@ -2,20 +2,20 @@
 
 using namespace LibOpenNFS::NFS3;
 
-TexBlock::TexBlock(std::ifstream &frd)
+TexBlock::TexBlock(MappedStream &frd)
 {
     ASSERT(this->_SerializeIn(frd), "Failed to serialize TextureBlock from file stream");
 }
 
-bool TexBlock::_SerializeIn(std::ifstream &ifstream)
+bool TexBlock::_SerializeIn(MappedStream &mappedStream)
 {
-    SAFE_READ(ifstream, &width, (sizeof(uint16_t)));
-    SAFE_READ(ifstream, &height, (sizeof(uint16_t)));
-    SAFE_READ(ifstream, &unknown1, (sizeof(uint32_t)));
-    SAFE_READ(ifstream, &corners, sizeof(float) * 8);
-    SAFE_READ(ifstream, &unknown2, (sizeof(uint32_t)));
-    SAFE_READ(ifstream, &isLane, (sizeof(bool)));
-    SAFE_READ(ifstream, &qfsIndex, (sizeof(uint16_t)));
+    SAFE_READ(mappedStream, &width, (sizeof(uint16_t)));
+    SAFE_READ(mappedStream, &height, (sizeof(uint16_t)));
+    SAFE_READ(mappedStream, &unknown1, (sizeof(uint32_t)));
+    SAFE_READ(mappedStream, &corners, sizeof(float) * 8);
+    SAFE_READ(mappedStream, &unknown2, (sizeof(uint32_t)));
+    SAFE_READ(mappedStream, &isLane, (sizeof(bool)));
+    SAFE_READ(mappedStream, &qfsIndex, (sizeof(uint16_t)));
 
     return true;
 }
@@ -6,12 +6,12 @@ namespace LibOpenNFS
 {
     namespace NFS3
     {
-        class TexBlock : public IRawData
+        class TexBlock : public IMappedRawData
         {
         public:
             TexBlock() = default;
-            explicit TexBlock(std::ifstream &frd);
-            void _SerializeOut(std::ofstream &ifstream) override;
+            explicit TexBlock(MappedStream &frd);
+            void _SerializeOut(std::ofstream &ofstream) override;
 
             uint16_t width, height;
             uint32_t unknown1; // Blending related, hometown covered bridges godrays `
@@ -21,7 +21,7 @@ namespace LibOpenNFS
             uint16_t qfsIndex; // index in QFS file
 
         private:
-            bool _SerializeIn(std::ifstream &ofstream) override;
+            bool _SerializeIn(MappedStream &mappedStream) override;
         };
     } // namespace NFS3
 } // namespace LibOpenNFS
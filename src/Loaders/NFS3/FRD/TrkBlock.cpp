@@ -2,12 +2,33 @@
 
 using namespace LibOpenNFS::NFS3;
 
-TrkBlock::TrkBlock(std::ifstream &frd)
+TrkBlock::TrkBlock(MappedStream &frd)
 {
     ASSERT(this->_SerializeIn(frd), "Failed to serialize TrkBlock from file stream");
 }
 
-bool TrkBlock::_SerializeIn(std::ifstream &frd)
+bool TrkBlock::Skip(MappedStream &frd)
+{
+    // Jump over ptCentre and ptBounding to reach the vertex count
+    uint32_t nVertices = 0;
+    frd.seekg(sizeof(glm::vec3) * 5, std::ios_base::cur);
+    SAFE_READ(frd, &nVertices, sizeof(uint32_t));
+
+    // Remaining LOD vert counts, vertex/shading tables, neighbour data and nStartPos
+    frd.seekg((sizeof(uint32_t) * 5) + ((sizeof(glm::vec3) + sizeof(uint32_t)) * nVertices) + (4 * 0x12c) + sizeof(uint32_t), std::ios_base::cur);
+
+    // nPositions, nPolygons, nVRoad, nXobj, nPolyobj, nSoundsrc, nLightsrc
+    uint32_t tableSizes[7];
+    SAFE_READ(frd, tableSizes, sizeof(uint32_t) * 7);
+    frd.seekg((sizeof(PositionData) * tableSizes[0]) + (sizeof(PolyVRoadData) * tableSizes[1]) + (sizeof(VRoadData) * tableSizes[2]) +
+                (sizeof(RefExtraObject) * tableSizes[3]) + (sizeof(PolyObject) * tableSizes[4]) + (sizeof(SoundSource) * tableSizes[5]) +
+                (sizeof(LightSource) * tableSizes[6]),
+              std::ios_base::cur);
+
+    return !frd.fail();
+}
+
+bool TrkBlock::_SerializeIn(MappedStream &frd)
 {
     SAFE_READ(frd, &ptCentre, sizeof(glm::vec3));
     SAFE_READ(frd, &ptBounding, sizeof(glm::vec3) * 4);
@@ -24,12 +45,10 @@ bool TrkBlock::_SerializeIn(std::ifstream &frd)
     }
 
     // Read Vertices
-    vert.resize(nVertices);
-    SAFE_READ(frd, vert.data(), sizeof(glm::vec3) * nVertices);
+    SAFE_VIEW(frd, vert, nVertices);
 
     // Read Vertices
-    vertShading.resize(nVertices);
-    SAFE_READ(frd, vertShading.data(), sizeof(uint32_t) * nVertices);
+    SAFE_VIEW(frd, vertShading, nVertices);
 
     // Read neighbouring block data
     SAFE_READ(frd, nbdData, 4 * 0x12c);
@@ -45,32 +64,25 @@ bool TrkBlock::_SerializeIn(std::ifstream &frd)
     SAFE_READ(frd, &nLightsrc, sizeof(uint32_t));
 
     // Read track position data
-    posData.resize(nPositions);
-    SAFE_READ(frd, posData.data(), sizeof(PositionData) * nPositions);
+    SAFE_VIEW(frd, posData, nPositions);
 
     // Read virtual road polygons
-    polyData.resize(nPolygons);
-    SAFE_READ(frd, polyData.data(), sizeof(PolyVRoadData) * nPolygons);
+    SAFE_VIEW(frd, polyData, nPolygons);
 
     // Read virtual road spline data
-    vroadData.resize(nVRoad);
-    SAFE_READ(frd, vroadData.data(), sizeof(VRoadData) * nVRoad);
+    SAFE_VIEW(frd, vroadData, nVRoad);
 
     // Read Extra object references
-    xobj.resize(nXobj);
-    SAFE_READ(frd, xobj.data(), sizeof(RefExtraObject) * nXobj);
+    SAFE_VIEW(frd, xobj, nXobj);
 
     // ?? Read unknown
-    polyObj.resize(nPolyobj);
-    SAFE_READ(frd, polyObj.data(), sizeof(PolyObject) * nPolyobj);
+    SAFE_VIEW(frd, polyObj, nPolyobj);
     // nPolyobj = 0;
 
     // Get the sound and light sources
-    soundsrc.resize(nSoundsrc);
-    SAFE_READ(frd, soundsrc.data(), sizeof(SoundSource) * nSoundsrc);
+    SAFE_VIEW(frd, soundsrc, nSoundsrc);
 
-    lightsrc.resize(nLightsrc);
-    SAFE_READ(frd, lightsrc.data(), sizeof(LightSource) * nLightsrc);
+    SAFE_VIEW(frd, lightsrc, nLightsrc);
 
     return true;
 }
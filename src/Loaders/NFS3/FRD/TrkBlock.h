@@ -59,11 +59,13 @@ namespace LibOpenNFS
             uint8_t unknown[20];
         };
 
-        class TrkBlock : public IRawData
+        class TrkBlock : public IMappedRawData
         {
         public:
             TrkBlock() = default;
-            explicit TrkBlock(std::ifstream &frd);
+            explicit TrkBlock(MappedStream &frd);
+            // Moves the stream past a TrkBlock reading only its table counts, to index block offsets ahead of a full parse
+            static bool Skip(MappedStream &frd);
             void _SerializeOut(std::ofstream &frd) override;
 
             glm::vec3 ptCentre;
@@ -71,23 +73,23 @@ namespace LibOpenNFS
             uint32_t nVertices;                           // Total num verties in block
             uint32_t nHiResVert, nLoResVert, nMedResVert; // LOD Vert numbers
             uint32_t nVerticesDup, nObjectVert;
-            std::vector<glm::vec3> vert;
-            std::vector<uint32_t> vertShading;
+            RawView<glm::vec3> vert;
+            RawView<uint32_t> vertShading;
             NeighbourData nbdData[0x12C]; // neighboring blocks
             uint32_t nStartPos, nPositions;
             uint32_t nPolygons, nVRoad, nXobj, nPolyobj, nSoundsrc, nLightsrc;
-            std::vector<PositionData> posData;   // positions auint32_t track
-            std::vector<PolyVRoadData> polyData; // polygon vroad references & flags
-            std::vector<VRoadData> vroadData;    // vroad vectors
-            std::vector<RefExtraObject> xobj;
-            std::vector<PolyObject> polyObj; // Unknown Currently!
-            std::vector<SoundSource> soundsrc;
-            std::vector<LightSource> lightsrc;
+            RawView<PositionData> posData;   // positions auint32_t track
+            RawView<PolyVRoadData> polyData; // polygon vroad references & flags
+            RawView<VRoadData> vroadData;    // vroad vectors
+            RawView<RefExtraObject> xobj;
+            RawView<PolyObject> polyObj; // Unknown Currently!
+            RawView<SoundSource> soundsrc;
+            RawView<LightSource> lightsrc;
             glm::vec3 hs_ptMin, hs_ptMax;
             uint32_t hs_neighbors[8];
 
         protected:
-            bool _SerializeIn(std::ifstream &frd) override;
+            bool _SerializeIn(MappedStream &frd) override;
         };
     } // namespace NFS3
 } // namespace LibOpenNFS
@@ -2,29 +2,111 @@
 
 using namespace LibOpenNFS::NFS3;
 
+namespace
+{
+    // FRD texture block and the texture it was loaded into, looked up by PolygonData::textureId
+    struct PolygonTexture
+    {
+        const TexBlock *texBlock;
+        const Texture *texture;
+    };
+
+    // Vertex table a set of quads indexes into. Normals are calculated from normalVertices, which may be unscaled/uncentred.
+    struct TrackMeshSource
+    {
+        const glm::vec3 *vertices;
+        const glm::vec4 *shadingData;
+        const glm::vec3 *normalVertices;
+    };
+
+    // De-indexed streams of a single TrackModel, appended to a quad at a time and then moved into the model
+    struct TrackMeshStreams
+    {
+        void Reserve(size_t nQuads)
+        {
+            size_t nVertices = nQuads * quadToTriVertNumbers.size();
+            vertices.reserve(nVertices);
+            normals.reserve(nVertices);
+            uvs.reserve(nVertices);
+            textureIndices.reserve(nVertices);
+            shadingData.reserve(nVertices);
+        }
+
+        TrackModel MakeModel(glm::vec3 centerPosition)
+        {
+            return TrackModel(std::move(vertices), std::move(normals), std::move(uvs), std::move(textureIndices), std::move(shadingData), std::vector<uint32_t>(),
+                              centerPosition);
+        }
+
+        std::vector<glm::vec3> vertices;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> uvs;
+        std::vector<uint32_t> textureIndices;
+        std::vector<glm::vec4> shadingData;
+        uint32_t accumulatedFlags = 0u;
+    };
+
+    void AppendQuads(TrackMeshStreams &mesh, EntityType meshType, const PolygonData *quads, size_t nQuads, const TrackMeshSource &source,
+                     const std::vector<PolygonTexture> &polygonTextures)
+    {
+        for (size_t quadIdx = 0; quadIdx < nQuads; ++quadIdx)
+        {
+            const PolygonData &quad              = quads[quadIdx];
+            const PolygonTexture &polygonTexture = polygonTextures[quad.textureId];
+            // Convert the UV's into ONFS space, to enable tiling/mirroring etc based on NFS texture flags
+            polygonTexture.texture->GenerateUVs(meshType, *polygonTexture.texBlock, mesh.uvs);
+
+            // Calculate the normal, as the provided data is a little suspect
+            glm::vec3 normal = Utils::CalculateQuadNormal(source.normalVertices[quad.vertex[0]],
+                                                          source.normalVertices[quad.vertex[1]],
+                                                          source.normalVertices[quad.vertex[2]],
+                                                          source.normalVertices[quad.vertex[3]]);
+
+            // Two triangles per raw quad, hence 6 vertices. Normal data and texture index required per-vertex.
+            for (auto &quadToTriVertNumber : quadToTriVertNumbers)
+            {
+                uint16_t vertexIdx = quad.vertex[quadToTriVertNumber];
+                mesh.vertices.emplace_back(source.vertices[vertexIdx]);
+                mesh.shadingData.emplace_back(source.shadingData[vertexIdx]);
+                mesh.normals.emplace_back(normal);
+                mesh.textureIndices.emplace_back(polygonTexture.texture->layer);
+            }
+
+            mesh.accumulatedFlags |= quad.flags;
+        }
+    }
+} // namespace
+
 std::shared_ptr<Car> NFS3Loader::LoadCar(const std::string &carBasePath)
 {
     boost::filesystem::path p(carBasePath);
     std::string carName = p.filename().string();
 
-    std::stringstream vivPath, carOutPath, fcePath, fedataPath;
+    std::stringstream vivPath;
     vivPath << carBasePath << "/car.viv";
-    carOutPath << CAR_PATH << ToString(NFS_3) << "/" << carName << "/";
-    fcePath << CAR_PATH << ToString(NFS_3) << "/" << carName << "/car.fce";
-    fedataPath << carOutPath.str() << "fedata.eng";
 
     FceFile fceFile;
     FedataFile fedataFile;
 
-    ASSERT(Utils::ExtractVIV(vivPath.str(), carOutPath.str()), "Unable to extract " << vivPath.str() << " to " << carOutPath.str());
-    ASSERT(FceFile::Load(fcePath.str(), fceFile), "Could not load FCE file: " << fcePath.str());
-    if (!FedataFile::Load(fedataPath.str(), fedataFile, fceFile.nPriColours))
+    // Parse straight out of the mapped archive rather than extracting it to disk first
+    VivArchive carViv(vivPath.str());
+    ASSERT(carViv.IsOpen(), "Unable to open " << vivPath.str());
+    MappedStream fceStream = carViv.OpenFile("car.fce");
+    ASSERT(FceFile::Load(fceStream, fceFile), "Could not load FCE file from " << vivPath.str());
+    MappedStream fedataStream = carViv.OpenFile("fedata.eng");
+    if (!FedataFile::Load(fedataStream, fedataFile, fceFile.nPriColours))
     {
-        LOG(WARNING) <<  "Could not load FeData file: " << fedataPath.str();
+        LOG(WARNING) << "Could not load FeData file from " << vivPath.str();
     }
 
     CarData carData = _ParseFCEModels(fceFile);
 
+    RawView<char> carTexture = carViv.GetFile("car00.tga");
+    if (!ImageLoader::DecodeImage(carTexture.data(), carTexture.size(), carData.texture, &carData.textureWidth, &carData.textureHeight))
+    {
+        LOG(WARNING) << "Could not decode car00.tga from " << vivPath.str();
+    }
+
     // Go get car metadata from FEDATA
     carData.carName = fedataFile.menuName;
     for (uint8_t colourIdx = 0; colourIdx < fceFile.nPriColours; ++colourIdx)
@@ -39,7 +121,7 @@ std::shared_ptr<Track> NFS3Loader::LoadTrack(const std::string &trackBasePath)
 {
     LOG(INFO) << "Loading Track located at " << trackBasePath;
 
-    auto track        = std::make_shared<Track>(Track());
+    auto track        = std::make_shared<Track>();
     track->nfsVersion = NFSVer::NFS_3;
 
     boost::filesystem::path p(trackBasePath);
@@ -64,26 +146,38 @@ std::shared_ptr<Track> NFS3Loader::LoadTrack(const std::string &trackBasePath)
     HrzFile hrzFile;
     SpeedsFile speedFile;
 
-    ASSERT(Texture::ExtractTrackTextures(trackBasePath, trackNameStripped, NFSVer::NFS_3), "Could not extract " << trackNameStripped << " QFS texture pack");
+    std::string qfsPath = trackBasePath + "/" + trackNameStripped + "0.qfs";
+    QfsArchive trackTextures(qfsPath);
+    ASSERT(trackTextures.IsOpen(), "Could not load " << trackNameStripped << " QFS texture pack: " << qfsPath);
+
+    // Skip parsing entirely if a previous load has already baked this track out to an up to date ONFS cache
+    std::string onfsPath                     = TRACK_PATH + ToString(NFS_3) + "/" + trackNameStripped + "/" + trackNameStripped + ".onfs";
+    std::vector<std::string> onfsSourcePaths = {frdPath, colPath, canPath};
+    OnfsFile onfsFile;
+    if (OnfsFile::Load(onfsPath, onfsFile) && onfsFile.IsValidFor(NFS_3, onfsSourcePaths) && _ParseOnfsFile(onfsFile, trackTextures, track))
+    {
+        LOG(INFO) << "Track loaded successfully from ONFS cache";
+        return track;
+    }
+
     ASSERT(FrdFile::Load(frdPath, frdFile), "Could not load FRD file: " << frdPath);                              // Load FRD file to get track block specific data
     ASSERT(ColFile::Load(colPath, colFile), "Could not load COL file: " << colPath);                              // Load Catalogue file to get global (non trkblock specific) data
     ASSERT(CanFile::Load(canPath, canFile), "Could not load CAN file (camera animation): " << canPath);           // Load camera intro/outro animation data
     ASSERT(HrzFile::Load(hrzPath, hrzFile), "Could not load HRZ file (skybox/lighting):" << hrzPath);             // Load HRZ Data
     ASSERT(SpeedsFile::Load(binPath, speedFile), "Could not load speedsf.bin file (AI vroad speeds:" << binPath); // Load AI speed data
 
-    // Load QFS textures into GL objects
-    for (auto &frdTexBlock : frdFile.textureBlocks)
-    {
-        track->textureMap[frdTexBlock.qfsIndex] = Texture::LoadTexture(NFSVer::NFS_3, frdTexBlock, trackNameStripped);
-    }
-
-    track->textureArrayID  = Texture::MakeTextureArray(track->textureMap, false);
+    // Decode QFS textures on the worker pool, then upload them into a GL texture array here
+    track->textureMap      = Texture::LoadTextures(frdFile.textureBlocks, trackTextures);
+    track->textureArrayID  = Texture::MakeTextureArray(track->textureMap);
     track->nBlocks         = frdFile.nBlocks;
     track->cameraAnimation = canFile.animPoints;
     track->trackBlocks     = _ParseTRKModels(frdFile, track);
     track->globalObjects   = _ParseCOLModels(colFile, track);
     track->virtualRoad     = _ParseVirtualRoad(colFile);
 
+    OnfsFile bakedOnfsFile = _BakeOnfsFile(frdFile, track, onfsSourcePaths);
+    OnfsFile::Save(onfsPath, bakedOnfsFile);
+
     LOG(INFO) << "Track loaded successfully";
 
     return track;
@@ -157,20 +251,30 @@ std::vector<OpenNFS::TrackBlock> NFS3Loader::_ParseTRKModels(const FrdFile &frdF
     std::vector<OpenNFS::TrackBlock> trackBlocks;
     trackBlocks.reserve(frdFile.nBlocks);
 
+    // Resolve every FRD texture block to its loaded texture up front, rather than with a map lookup per polygon
+    std::vector<PolygonTexture> polygonTextures;
+    polygonTextures.reserve(frdFile.textureBlocks.size());
+    for (auto &textureBlock : frdFile.textureBlocks)
+    {
+        polygonTextures.push_back({&textureBlock, &track->textureMap[textureBlock.qfsIndex]});
+    }
+
+    // Block vertex tables, reused across blocks
+    std::vector<glm::vec3> blockVertices;
+    std::vector<glm::vec4> blockShadingData;
+
     /* TRKBLOCKS - BASE TRACK GEOMETRY */
     for (uint32_t trackblockIdx = 0; trackblockIdx < frdFile.nBlocks; ++trackblockIdx)
     {
         // Get Verts from Trk block, indices from associated polygon block
-        TrkBlock rawTrackBlock      = frdFile.trackBlocks[trackblockIdx];
-        PolyBlock trackPolygonBlock = frdFile.polygonBlocks[trackblockIdx];
+        const TrkBlock &rawTrackBlock      = frdFile.trackBlocks[trackblockIdx];
+        const PolyBlock &trackPolygonBlock = frdFile.polygonBlocks[trackblockIdx];
 
         glm::vec3 rawTrackBlockCenter = rawTrackBlock.ptCentre / NFS3_SCALE_FACTOR;
         std::vector<uint32_t> trackBlockNeighbourIds;
-        std::vector<glm::vec3> trackBlockVerts;
-        std::vector<glm::vec4> trackBlockShadingData;
 
         // Get neighbouring block IDs
-        for (auto &neighbourBlockData : frdFile.trackBlocks[trackblockIdx].nbdData)
+        for (auto &neighbourBlockData : rawTrackBlock.nbdData)
         {
             if (neighbourBlockData.blk == -1)
             {
@@ -189,69 +293,40 @@ std::vector<OpenNFS::TrackBlock> NFS3Loader::_ParseTRKModels(const FrdFile &frdF
         for (uint32_t lightNum = 0; lightNum < rawTrackBlock.nLightsrc; ++lightNum)
         {
             glm::vec3 lightCenter = Utils::FixedToFloat(rawTrackBlock.lightsrc[lightNum].refpoint) / NFS3_SCALE_FACTOR;
-            trackBlock.lights.emplace_back(Entity(trackblockIdx, lightNum, NFS_3, LIGHT, TrackUtils::MakeLight(lightCenter, rawTrackBlock.lightsrc[lightNum].type), 0));
+            trackBlock.lights.emplace_back(trackblockIdx, lightNum, NFS_3, LIGHT, TrackUtils::MakeLight(lightCenter, rawTrackBlock.lightsrc[lightNum].type), 0);
         }
         for (uint32_t soundNum = 0; soundNum < rawTrackBlock.nSoundsrc; ++soundNum)
         {
             glm::vec3 soundCenter = Utils::FixedToFloat(rawTrackBlock.soundsrc[soundNum].refpoint) / NFS3_SCALE_FACTOR;
-            trackBlock.sounds.emplace_back(Entity(trackblockIdx, soundNum, NFS_3, SOUND, Sound(soundCenter, rawTrackBlock.soundsrc[soundNum].type), 0));
+            trackBlock.sounds.emplace_back(trackblockIdx, soundNum, NFS_3, SOUND, Sound(soundCenter, rawTrackBlock.soundsrc[soundNum].type), 0);
         }
 
-        // Get Trackblock roadVertices and per-vertex shading data
-        for (uint32_t vertIdx = 0; vertIdx < rawTrackBlock.nObjectVert; ++vertIdx)
+        // Trackblock vertices relative to the block centre, and per-vertex shading data. The object polygons index into the first nObjectVert of
+        // these, the road polygons into all nVertices.
+        blockVertices.clear();
+        blockShadingData.clear();
+        for (uint32_t vertIdx = 0; vertIdx < rawTrackBlock.nVertices; ++vertIdx)
         {
-            trackBlockVerts.emplace_back((rawTrackBlock.vert[vertIdx] / NFS3_SCALE_FACTOR) - rawTrackBlockCenter);
-            trackBlockShadingData.emplace_back(TrackUtils::ShadingDataToVec4(rawTrackBlock.vertShading[vertIdx]));
+            blockVertices.emplace_back((rawTrackBlock.vert[vertIdx] / NFS3_SCALE_FACTOR) - rawTrackBlockCenter);
+            blockShadingData.emplace_back(TrackUtils::ShadingDataToVec4(rawTrackBlock.vertShading[vertIdx]));
         }
+        TrackMeshSource blockSource = {blockVertices.data(), blockShadingData.data(), rawTrackBlock.vert.data()};
 
         // 4 OBJ Poly blocks
         for (uint32_t j = 0; j < 4; ++j)
         {
-            ObjectPolyBlock polygonBlock = trackPolygonBlock.obj[j];
+            const ObjectPolyBlock &polygonBlock = trackPolygonBlock.obj[j];
 
             if (polygonBlock.n1 > 0)
             {
                 // Iterate through objects in objpoly block up to num objects
                 for (uint32_t objectIdx = 0; objectIdx < polygonBlock.nobj; ++objectIdx)
                 {
-                    // Mesh Data
-                    std::vector<uint32_t> vertexIndices;
-                    std::vector<uint32_t> textureIndices;
-                    std::vector<glm::vec2> uvs;
-                    std::vector<glm::vec3> normals;
-                    uint32_t accumulatedObjectFlags = 0u;
-
-                    // Get Polygons in object
-                    std::vector<PolygonData> objectPolygons = polygonBlock.poly[objectIdx];
-
-                    for (uint32_t polyIdx = 0; polyIdx < polygonBlock.numpoly[objectIdx]; ++polyIdx)
-                    {
-                        // Texture for this polygon and it's loaded OpenGL equivalent
-                        TexBlock polygonTexture = frdFile.textureBlocks[objectPolygons[polyIdx].textureId];
-                        Texture glTexture       = track->textureMap[polygonTexture.qfsIndex];
-                        // Convert the UV's into ONFS space, to enable tiling/mirroring etc based on NFS texture flags
-                        std::vector<glm::vec2> transformedUVs = glTexture.GenerateUVs(OBJ_POLY, objectPolygons[polyIdx].hs_texflags, polygonTexture);
-                        uvs.insert(uvs.end(), transformedUVs.begin(), transformedUVs.end());
-
-                        // Calculate the normal, as the provided data is a little suspect
-                        glm::vec3 normal = Utils::CalculateQuadNormal(rawTrackBlock.vert[objectPolygons[polyIdx].vertex[0]],
-                                                                      rawTrackBlock.vert[objectPolygons[polyIdx].vertex[1]],
-                                                                      rawTrackBlock.vert[objectPolygons[polyIdx].vertex[2]],
-                                                                      rawTrackBlock.vert[objectPolygons[polyIdx].vertex[3]]);
-
-                        // Two triangles per raw quad, hence 6 vertices. Normal data and texture index required per-vertex.
-                        for (auto &quadToTriVertNumber : quadToTriVertNumbers)
-                        {
-                            normals.emplace_back(normal);
-                            vertexIndices.emplace_back(objectPolygons[polyIdx].vertex[quadToTriVertNumber]);
-                            textureIndices.emplace_back(polygonTexture.qfsIndex);
-                        }
-
-                        accumulatedObjectFlags |= objectPolygons[polyIdx].flags;
-                    }
-                    TrackModel trackBlockModel = TrackModel(trackBlockVerts, normals, uvs, textureIndices, vertexIndices, trackBlockShadingData, rawTrackBlockCenter);
-                    Entity trackBlockEntity    = Entity(trackblockIdx, (j + 1) * (objectIdx + 1), NFS_3, OBJ_POLY, trackBlockModel, accumulatedObjectFlags);
-                    trackBlock.objects.emplace_back(trackBlockEntity);
+                    TrackMeshStreams objectMesh;
+                    objectMesh.Reserve(polygonBlock.numpoly[objectIdx]);
+                    AppendQuads(objectMesh, OBJ_POLY, polygonBlock.poly[objectIdx].data(), polygonBlock.numpoly[objectIdx], blockSource, polygonTextures);
+                    trackBlock.objects.emplace_back(
+                      trackblockIdx, (j + 1) * (objectIdx + 1), NFS_3, OBJ_POLY, objectMesh.MakeModel(rawTrackBlockCenter), objectMesh.accumulatedFlags);
                 }
             }
         }
@@ -261,68 +336,32 @@ std::vector<OpenNFS::TrackBlock> NFS3Loader::_ParseTRKModels(const FrdFile &frdF
         {
             for (uint32_t j = 0; j < frdFile.extraObjectBlocks[l].nobj; ++j)
             {
-                // Mesh Data
-                std::vector<glm::vec3> extraObjectVerts;
-                std::vector<glm::vec4> extraObjectShadingData;
-                std::vector<uint32_t> vertexIndices;
-                std::vector<uint32_t> textureIndices;
-                std::vector<glm::vec2> uvs;
-                std::vector<glm::vec3> normals;
-                uint32_t accumulatedObjectFlags = 0u;
-
                 // Get the Extra object data for this trackblock object from the global xobj table
-                ExtraObjectData extraObjectData = frdFile.extraObjectBlocks[l].obj[j];
+                const ExtraObjectData &extraObjectData = frdFile.extraObjectBlocks[l].obj[j];
 
+                std::vector<glm::vec3> extraObjectVerts;
+                std::vector<glm::vec4> extraObjectShadingData;
+                extraObjectVerts.reserve(extraObjectData.nVertices);
+                extraObjectShadingData.reserve(extraObjectData.nVertices);
                 for (uint32_t vertIdx = 0; vertIdx < extraObjectData.nVertices; vertIdx++)
                 {
                     extraObjectVerts.emplace_back(extraObjectData.vert[vertIdx] / NFS3_SCALE_FACTOR);
                     extraObjectShadingData.emplace_back(TrackUtils::ShadingDataToVec4(extraObjectData.vertShading[vertIdx]));
                 }
+                TrackMeshSource extraObjectSource = {extraObjectVerts.data(), extraObjectShadingData.data(), extraObjectVerts.data()};
 
-                for (uint32_t k = 0; k < extraObjectData.nPolygons; k++)
-                {
-                    TexBlock blockTexture                 = frdFile.textureBlocks[extraObjectData.polyData[k].textureId];
-                    Texture glTexture                     = track->textureMap[blockTexture.qfsIndex];
-                    std::vector<glm::vec2> transformedUVs = glTexture.GenerateUVs(XOBJ, extraObjectData.polyData[k].hs_texflags, blockTexture);
-                    uvs.insert(uvs.end(), transformedUVs.begin(), transformedUVs.end());
-
-                    glm::vec3 normal = Utils::CalculateQuadNormal(extraObjectVerts[extraObjectData.polyData[k].vertex[0]],
-                                                                  extraObjectVerts[extraObjectData.polyData[k].vertex[1]],
-                                                                  extraObjectVerts[extraObjectData.polyData[k].vertex[2]],
-                                                                  extraObjectVerts[extraObjectData.polyData[k].vertex[3]]);
-
-                    // Two triangles per raw quad, hence 6 vertices. Normal data and texture index required per-vertex.
-                    for (auto &quadToTriVertNumber : quadToTriVertNumbers)
-                    {
-                        normals.emplace_back(normal);
-                        vertexIndices.emplace_back(extraObjectData.polyData[k].vertex[quadToTriVertNumber]);
-                        textureIndices.emplace_back(blockTexture.qfsIndex);
-                    }
-
-                    accumulatedObjectFlags |= extraObjectData.polyData[k].flags;
-                }
+                TrackMeshStreams extraObjectMesh;
+                extraObjectMesh.Reserve(extraObjectData.nPolygons);
+                AppendQuads(extraObjectMesh, XOBJ, extraObjectData.polyData.data(), extraObjectData.nPolygons, extraObjectSource, polygonTextures);
                 glm::vec3 extraObjectCenter = extraObjectData.ptRef / NFS3_SCALE_FACTOR;
-                TrackModel extraObjectModel = TrackModel(extraObjectVerts, normals, uvs, textureIndices, vertexIndices, extraObjectShadingData, extraObjectCenter);
-                Entity extraObjectEntity    = Entity(trackblockIdx, l, NFS_3, XOBJ, extraObjectModel, accumulatedObjectFlags);
-                trackBlock.objects.emplace_back(extraObjectEntity);
+                trackBlock.objects.emplace_back(trackblockIdx, l, NFS_3, XOBJ, extraObjectMesh.MakeModel(extraObjectCenter), extraObjectMesh.accumulatedFlags);
             }
         }
 
-        // Road Mesh data
-        std::vector<glm::vec3> roadVertices;
-        std::vector<glm::vec4> roadShadingData;
-        std::vector<uint32_t> vertexIndices;
-        std::vector<uint32_t> textureIndices;
-        std::vector<glm::vec2> uvs;
-        std::vector<glm::vec3> normals;
-        uint32_t accumulatedObjectFlags = 0u;
-
-        for (uint32_t vertIdx = 0; vertIdx < rawTrackBlock.nVertices; ++vertIdx)
-        {
-            roadVertices.emplace_back((rawTrackBlock.vert[vertIdx] / NFS3_SCALE_FACTOR) - rawTrackBlockCenter);
-            roadShadingData.emplace_back(TrackUtils::ShadingDataToVec4(rawTrackBlock.vertShading[vertIdx]));
-        }
-        // Get indices from Chunk 4 and 5 for High Res polys, Chunk 6 for Road Lanes
+        // Get indices from Chunk 4 and 5 for High Res polys, Chunk 6 for Road Lanes. Each chunk's model also holds the polygons of the chunks
+        // before it, as it always has.
+        TrackMeshStreams roadMesh;
+        roadMesh.Reserve(trackPolygonBlock.sz[4] + trackPolygonBlock.sz[5] + trackPolygonBlock.sz[6]);
         for (uint32_t lodChunkIdx = 4; lodChunkIdx <= 6; lodChunkIdx++)
         {
             // If there are no lane markers in the lane chunk, skip
@@ -331,44 +370,34 @@ std::vector<OpenNFS::TrackBlock> NFS3Loader::_ParseTRKModels(const FrdFile &frdF
                 continue;
             }
 
-            // Get the polygon data for this road section
-            std::vector<PolygonData> chunkPolygonData = trackPolygonBlock.poly[lodChunkIdx];
-
-            for (uint32_t polyIdx = 0; polyIdx < trackPolygonBlock.sz[lodChunkIdx]; polyIdx++)
-            {
-                TexBlock polygonTexture               = frdFile.textureBlocks[chunkPolygonData[polyIdx].textureId];
-                Texture glTexture                     = track->textureMap[polygonTexture.qfsIndex];
-                std::vector<glm::vec2> transformedUVs = glTexture.GenerateUVs(lodChunkIdx == 6 ? LANE : ROAD, chunkPolygonData[polyIdx].hs_texflags, polygonTexture);
-                uvs.insert(uvs.end(), transformedUVs.begin(), transformedUVs.end());
-
-                glm::vec3 normal = Utils::CalculateQuadNormal(rawTrackBlock.vert[chunkPolygonData[polyIdx].vertex[0]],
-                                                              rawTrackBlock.vert[chunkPolygonData[polyIdx].vertex[1]],
-                                                              rawTrackBlock.vert[chunkPolygonData[polyIdx].vertex[2]],
-                                                              rawTrackBlock.vert[chunkPolygonData[polyIdx].vertex[3]]);
-
-                // Two triangles per raw quad, hence 6 vertices. Normal data and texture index required per-vertex.
-                for (auto &quadToTriVertNumber : quadToTriVertNumbers)
-                {
-                    normals.emplace_back(normal);
-                    vertexIndices.emplace_back(chunkPolygonData[polyIdx].vertex[quadToTriVertNumber]);
-                    textureIndices.emplace_back(polygonTexture.qfsIndex);
-                }
-
-                accumulatedObjectFlags |= chunkPolygonData[polyIdx].flags;
-            }
-            TrackModel roadModel = TrackModel(roadVertices, normals, uvs, textureIndices, vertexIndices, roadShadingData, rawTrackBlockCenter);
+            AppendQuads(roadMesh, lodChunkIdx == 6 ? LANE : ROAD, trackPolygonBlock.poly[lodChunkIdx].data(), trackPolygonBlock.sz[lodChunkIdx], blockSource, polygonTextures);
             if (lodChunkIdx == 6)
             {
-                Entity laneEntity = Entity(trackblockIdx, -1, NFS_3, LANE, roadModel, accumulatedObjectFlags);
-                trackBlock.lanes.emplace_back(laneEntity);
+                // Last user of the streams, hand them over
+                trackBlock.lanes.emplace_back(trackblockIdx, -1, NFS_3, LANE, roadMesh.MakeModel(rawTrackBlockCenter), roadMesh.accumulatedFlags);
             }
             else
             {
-                Entity roadEntity = Entity(trackblockIdx, -1, NFS_3, ROAD, roadModel, accumulatedObjectFlags);
-                trackBlock.track.emplace_back(roadEntity);
+                TrackMeshStreams chunkMesh = roadMesh;
+                trackBlock.track.emplace_back(trackblockIdx, -1, NFS_3, ROAD, chunkMesh.MakeModel(rawTrackBlockCenter), chunkMesh.accumulatedFlags);
             }
         }
-        trackBlocks.emplace_back(trackBlock);
+
+        // Chunks 0 and 1 hold the Low Res road, 2 and 3 the Medium Res, paired up the same way as the High Res
+        for (uint32_t lodChunkIdx = 0; lodChunkIdx < 4; lodChunkIdx += 2)
+        {
+            if (trackPolygonBlock.sz[lodChunkIdx] + trackPolygonBlock.sz[lodChunkIdx + 1] == 0)
+            {
+                continue;
+            }
+            TrackMeshStreams lodMesh;
+            lodMesh.Reserve(trackPolygonBlock.sz[lodChunkIdx] + trackPolygonBlock.sz[lodChunkIdx + 1]);
+            AppendQuads(lodMesh, ROAD, trackPolygonBlock.poly[lodChunkIdx].data(), trackPolygonBlock.sz[lodChunkIdx], blockSource, polygonTextures);
+            AppendQuads(lodMesh, ROAD, trackPolygonBlock.poly[lodChunkIdx + 1].data(), trackPolygonBlock.sz[lodChunkIdx + 1], blockSource, polygonTextures);
+            std::vector<Entity> &lodTrack = lodChunkIdx == 0 ? trackBlock.loResTrack : trackBlock.medResTrack;
+            lodTrack.emplace_back(trackblockIdx, -1, NFS_3, ROAD, lodMesh.MakeModel(rawTrackBlockCenter), lodMesh.accumulatedFlags);
+        }
+        trackBlocks.emplace_back(std::move(trackBlock));
     }
     return trackBlocks;
 }
@@ -413,7 +442,7 @@ std::vector<Entity> NFS3Loader::_ParseCOLModels(const ColFile &colFile, const st
         std::vector<glm::vec4> shading_data;
         std::vector<glm::vec3> norms;
 
-        ColStruct3D s = colFile.struct3D[colFile.object[i].struct3D];
+        const ColStruct3D &s = colFile.struct3D[colFile.object[i].struct3D];
 
         for (uint32_t vertIdx = 0; vertIdx < s.nVert; ++vertIdx)
         {
@@ -423,18 +452,18 @@ std::vector<Entity> NFS3Loader::_ParseCOLModels(const ColFile &colFile, const st
         for (uint32_t polyIdx = 0; polyIdx < s.nPoly; ++polyIdx)
         {
             // Remap the COL TextureID's using the COL texture block (XBID2)
-            ColTextureInfo colTexture = colFile.texture[s.polygon[polyIdx].texture];
+            const ColTextureInfo &colTexture = colFile.texture[s.polygon[polyIdx].texture];
             // Retrieve the GL texture for it so can scale UVs into texture array
-            Texture glTexture = track->textureMap[colTexture.id];
+            const Texture &glTexture = track->textureMap[colTexture.id];
             // Lookup the remapped COL->FRD texture ID in the FRD texture table
-            TexBlock blockTexture = boost::get<TexBlock>(glTexture.rawTextureInfo);
+            const TexBlock &blockTexture = boost::get<TexBlock>(glTexture.rawTextureInfo);
 
-            uvs.emplace_back(blockTexture.corners[0] * glTexture.maxU, (1.0f - blockTexture.corners[1]) * glTexture.maxV);
-            uvs.emplace_back(blockTexture.corners[2] * glTexture.maxU, (1.0f - blockTexture.corners[3]) * glTexture.maxV);
-            uvs.emplace_back(blockTexture.corners[4] * glTexture.maxU, (1.0f - blockTexture.corners[5]) * glTexture.maxV);
-            uvs.emplace_back(blockTexture.corners[0] * glTexture.maxU, (1.0f - blockTexture.corners[1]) * glTexture.maxV);
-            uvs.emplace_back(blockTexture.corners[4] * glTexture.maxU, (1.0f - blockTexture.corners[5]) * glTexture.maxV);
-            uvs.emplace_back(blockTexture.corners[6] * glTexture.maxU, (1.0f - blockTexture.corners[7]) * glTexture.maxV);
+            uvs.emplace_back(glTexture.LayerUV(glm::vec2(blockTexture.corners[0], 1.0f - blockTexture.corners[1])));
+            uvs.emplace_back(glTexture.LayerUV(glm::vec2(blockTexture.corners[2], 1.0f - blockTexture.corners[3])));
+            uvs.emplace_back(glTexture.LayerUV(glm::vec2(blockTexture.corners[4], 1.0f - blockTexture.corners[5])));
+            uvs.emplace_back(glTexture.LayerUV(glm::vec2(blockTexture.corners[0], 1.0f - blockTexture.corners[1])));
+            uvs.emplace_back(glTexture.LayerUV(glm::vec2(blockTexture.corners[4], 1.0f - blockTexture.corners[5])));
+            uvs.emplace_back(glTexture.LayerUV(glm::vec2(blockTexture.corners[6], 1.0f - blockTexture.corners[7])));
 
             glm::vec3 normal =
               Utils::CalculateQuadNormal(verts[s.polygon[polyIdx].v[0]], verts[s.polygon[polyIdx].v[1]], verts[s.polygon[polyIdx].v[2]], verts[s.polygon[polyIdx].v[3]]);
@@ -444,7 +473,7 @@ std::vector<Entity> NFS3Loader::_ParseCOLModels(const ColFile &colFile, const st
             {
                 indices.emplace_back(s.polygon[polyIdx].v[quadToTriVertNumber]);
                 norms.emplace_back(normal);
-                texture_indices.emplace_back(blockTexture.qfsIndex);
+                texture_indices.emplace_back(glTexture.layer);
             }
         }
         glm::vec3 position = glm::vec3(colFile.object[i].ptRef) / NFS3_SCALE_FACTOR;
@@ -452,4 +481,216 @@ std::vector<Entity> NFS3Loader::_ParseCOLModels(const ColFile &colFile, const st
     }
 
     return colEntities;
-}
\ No newline at end of file
+}
+
+OnfsFile NFS3Loader::_BakeOnfsFile(const FrdFile &frdFile, const std::shared_ptr<Track> &track, const std::vector<std::string> &sourcePaths)
+{
+    LOG(INFO) << "Baking ONFS structures out to cache";
+    OnfsFile onfsFile;
+    onfsFile.nfsVersion   = NFS_3;
+    onfsFile.sourceStamps = OnfsFile::StampSources(sourcePaths);
+
+    // Texture table, keyed identically to the texture map (later FRD texture blocks replace earlier ones sharing a QFS index)
+    std::map<uint32_t, OnfsTexture> onfsTextures;
+    for (auto &frdTexBlock : frdFile.textureBlocks)
+    {
+        const Texture &glTexture = track->textureMap.at(frdTexBlock.qfsIndex);
+        OnfsTexture onfsTexture{};
+        onfsTexture.textureId = frdTexBlock.qfsIndex;
+        onfsTexture.layer     = glTexture.layer;
+        onfsTexture.minU      = glTexture.minU;
+        onfsTexture.minV      = glTexture.minV;
+        onfsTexture.maxU      = glTexture.maxU;
+        onfsTexture.maxV      = glTexture.maxV;
+        onfsTexture.width     = frdTexBlock.width;
+        onfsTexture.height    = frdTexBlock.height;
+        onfsTexture.unknown1  = frdTexBlock.unknown1;
+        memcpy(onfsTexture.corners, frdTexBlock.corners, sizeof(frdTexBlock.corners));
+        onfsTexture.unknown2               = frdTexBlock.unknown2;
+        onfsTexture.isLane                 = frdTexBlock.isLane;
+        onfsTexture.qfsIndex               = frdTexBlock.qfsIndex;
+        onfsTextures[frdTexBlock.qfsIndex] = onfsTexture;
+    }
+    for (auto &onfsTexture : onfsTextures)
+    {
+        onfsFile.textures.emplace_back(onfsTexture.second);
+    }
+
+    onfsFile.virtualRoad = track->virtualRoad;
+    onfsFile.animPoints  = track->cameraAnimation;
+
+    for (auto &trackBlock : track->trackBlocks)
+    {
+        OnfsBlock onfsBlock{};
+        onfsBlock.header.id                    = trackBlock.id;
+        onfsBlock.header.position              = trackBlock.position;
+        onfsBlock.header.virtualRoadStartIndex = trackBlock.virtualRoadStartIndex;
+        onfsBlock.header.nVirtualRoadPositions = trackBlock.nVirtualRoadPositions;
+        onfsBlock.neighbourIds                 = trackBlock.neighbourIds;
+
+        for (auto &trackEntity : trackBlock.track)
+        {
+            onfsBlock.trackMeshes.emplace_back(_BakeOnfsMesh(trackEntity));
+        }
+        for (auto &objectEntity : trackBlock.objects)
+        {
+            onfsBlock.objectMeshes.emplace_back(_BakeOnfsMesh(objectEntity));
+        }
+        for (auto &laneEntity : trackBlock.lanes)
+        {
+            onfsBlock.laneMeshes.emplace_back(_BakeOnfsMesh(laneEntity));
+        }
+        for (auto &medResTrackEntity : trackBlock.medResTrack)
+        {
+            onfsBlock.medResTrackMeshes.emplace_back(_BakeOnfsMesh(medResTrackEntity));
+        }
+        for (auto &loResTrackEntity : trackBlock.loResTrack)
+        {
+            onfsBlock.loResTrackMeshes.emplace_back(_BakeOnfsMesh(loResTrackEntity));
+        }
+        for (auto &lightEntity : trackBlock.lights)
+        {
+            std::shared_ptr<TrackLight> trackLight = std::static_pointer_cast<TrackLight>(boost::get<std::shared_ptr<BaseLight>>(lightEntity.raw));
+            onfsBlock.lights.push_back({lightEntity.entityID, trackLight->nfsType, trackLight->position});
+        }
+        for (auto &soundEntity : trackBlock.sounds)
+        {
+            Sound sound = boost::get<Sound>(soundEntity.raw);
+            onfsBlock.sounds.push_back({soundEntity.entityID, sound.type, sound.position});
+        }
+        onfsFile.blocks.emplace_back(std::move(onfsBlock));
+    }
+
+    for (auto &globalEntity : track->globalObjects)
+    {
+        onfsFile.globalObjects.emplace_back(_BakeOnfsMesh(globalEntity));
+    }
+
+    return onfsFile;
+}
+
+bool NFS3Loader::_ParseOnfsFile(OnfsFile &onfsFile, const QfsArchive &trackTextures, const std::shared_ptr<Track> &track)
+{
+    LOG(INFO) << "Parsing ONFS cache into ONFS GL structures";
+
+    // Texture IDs were baked as the QFS index, so the texture map comes back keyed identically
+    std::vector<TexBlock> frdTexBlocks(onfsFile.textures.size());
+    for (size_t textureIdx = 0; textureIdx < onfsFile.textures.size(); ++textureIdx)
+    {
+        const OnfsTexture &onfsTexture = onfsFile.textures[textureIdx];
+        TexBlock &frdTexBlock          = frdTexBlocks[textureIdx];
+        frdTexBlock.width              = onfsTexture.width;
+        frdTexBlock.height             = onfsTexture.height;
+        frdTexBlock.unknown1           = onfsTexture.unknown1;
+        memcpy(frdTexBlock.corners, onfsTexture.corners, sizeof(onfsTexture.corners));
+        frdTexBlock.unknown2 = onfsTexture.unknown2;
+        frdTexBlock.isLane   = onfsTexture.isLane != 0;
+        frdTexBlock.qfsIndex = static_cast<uint16_t>(onfsTexture.qfsIndex);
+    }
+    track->textureMap     = Texture::LoadTextures(frdTexBlocks, trackTextures);
+    track->textureArrayID = Texture::MakeTextureArray(track->textureMap);
+
+    // UVs were scaled into the texture array at bake time, so are only still valid if the array comes out laid out identically
+    for (auto &onfsTexture : onfsFile.textures)
+    {
+        const Texture &glTexture = track->textureMap[onfsTexture.textureId];
+        if (glTexture.layer != onfsTexture.layer || glTexture.minU != onfsTexture.minU || glTexture.minV != onfsTexture.minV || glTexture.maxU != onfsTexture.maxU ||
+            glTexture.maxV != onfsTexture.maxV)
+        {
+            LOG(WARNING) << "ONFS cache texture layout no longer matches extracted textures, reparsing track";
+            if (track->textureArrayID != 0)
+            {
+                UploadManager::Get().CancelTextureUploads(track->textureArrayID);
+                glDeleteTextures(1, &track->textureArrayID);
+            }
+            track->textureArrayID = 0;
+            track->textureMap.clear();
+            return false;
+        }
+    }
+
+    track->nBlocks         = onfsFile.nBlocks;
+    track->cameraAnimation = std::move(onfsFile.animPoints);
+    track->virtualRoad     = std::move(onfsFile.virtualRoad);
+
+    track->trackBlocks.reserve(onfsFile.blocks.size());
+    for (auto &onfsBlock : onfsFile.blocks)
+    {
+        uint32_t trackblockIdx = onfsBlock.header.id;
+        OpenNFS::TrackBlock trackBlock(
+          trackblockIdx, onfsBlock.header.position, onfsBlock.header.virtualRoadStartIndex, onfsBlock.header.nVirtualRoadPositions, onfsBlock.neighbourIds);
+
+        for (auto &onfsLight : onfsBlock.lights)
+        {
+            trackBlock.lights.emplace_back(Entity(trackblockIdx, onfsLight.entityId, NFS_3, LIGHT, TrackUtils::MakeLight(onfsLight.position, onfsLight.type), 0));
+        }
+        for (auto &onfsSound : onfsBlock.sounds)
+        {
+            trackBlock.sounds.emplace_back(Entity(trackblockIdx, onfsSound.entityId, NFS_3, SOUND, Sound(onfsSound.position, onfsSound.type), 0));
+        }
+        for (auto &onfsMesh : onfsBlock.objectMeshes)
+        {
+            trackBlock.objects.emplace_back(_ParseOnfsMesh(trackblockIdx, onfsMesh));
+        }
+        for (auto &onfsMesh : onfsBlock.laneMeshes)
+        {
+            trackBlock.lanes.emplace_back(_ParseOnfsMesh(trackblockIdx, onfsMesh));
+        }
+        for (auto &onfsMesh : onfsBlock.trackMeshes)
+        {
+            trackBlock.track.emplace_back(_ParseOnfsMesh(trackblockIdx, onfsMesh));
+        }
+        for (auto &onfsMesh : onfsBlock.medResTrackMeshes)
+        {
+            trackBlock.medResTrack.emplace_back(_ParseOnfsMesh(trackblockIdx, onfsMesh));
+        }
+        for (auto &onfsMesh : onfsBlock.loResTrackMeshes)
+        {
+            trackBlock.loResTrack.emplace_back(_ParseOnfsMesh(trackblockIdx, onfsMesh));
+        }
+        track->trackBlocks.emplace_back(std::move(trackBlock));
+    }
+
+    for (auto &onfsMesh : onfsFile.globalObjects)
+    {
+        track->globalObjects.emplace_back(_ParseOnfsMesh(-1, onfsMesh));
+    }
+
+    return true;
+}
+
+OnfsMesh NFS3Loader::_BakeOnfsMesh(const Entity &entity)
+{
+    const TrackModel &trackModel = boost::get<TrackModel>(entity.raw);
+    ASSERT(trackModel.m_normals.size() == trackModel.m_vertices.size() && trackModel.m_uvs.size() == trackModel.m_vertices.size() &&
+             trackModel.m_textureIndices.size() == trackModel.m_vertices.size() && trackModel.m_shadingData.size() == trackModel.m_vertices.size(),
+           "Track model streams must hold an entry per vertex before baking to ONFS cache");
+
+    OnfsMesh onfsMesh;
+    onfsMesh.header.entityType = entity.type;
+    onfsMesh.header.entityId   = entity.entityID;
+    onfsMesh.header.flags      = entity.flags;
+    onfsMesh.header.nVertices  = static_cast<uint32_t>(trackModel.m_vertices.size());
+    onfsMesh.header.nIndices   = static_cast<uint32_t>(trackModel.m_vertexIndices.size());
+    onfsMesh.header.position   = trackModel.initialPosition;
+    onfsMesh.vertices          = trackModel.m_vertices;
+    onfsMesh.normals           = trackModel.m_normals;
+    onfsMesh.uvs               = trackModel.m_uvs;
+    onfsMesh.textureIndices    = trackModel.m_textureIndices;
+    onfsMesh.shadingData       = trackModel.m_shadingData;
+    onfsMesh.vertexIndices     = trackModel.m_vertexIndices;
+
+    return onfsMesh;
+}
+
+Entity NFS3Loader::_ParseOnfsMesh(uint32_t parentTrackblockID, OnfsMesh &onfsMesh)
+{
+    TrackModel trackModel(std::move(onfsMesh.vertices),
+                          std::move(onfsMesh.normals),
+                          std::move(onfsMesh.uvs),
+                          std::move(onfsMesh.textureIndices),
+                          std::move(onfsMesh.shadingData),
+                          std::move(onfsMesh.vertexIndices),
+                          onfsMesh.header.position);
+    return Entity(parentTrackblockID, onfsMesh.header.entityId, NFS_3, static_cast<EntityType>(onfsMesh.header.entityType), trackModel, onfsMesh.header.flags);
+}
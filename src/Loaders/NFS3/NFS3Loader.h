@@ -12,6 +12,8 @@
 #include "SPEEDS/SpeedsFile.h"
 #include "../Shared/CanFile.h"
 #include "../Shared/HrzFile.h"
+#include "../Shared/OnfsFile.h"
+#include "../Shared/VivArchive.h"
 #include "../Common/TrackUtils.h"
 #include "../../Config.h"
 #include "../../Util/Utils.h"
@@ -34,4 +36,8 @@ private:
     static std::vector<OpenNFS::TrackBlock> _ParseTRKModels(const LibOpenNFS::NFS3::FrdFile &frdFile, const std::shared_ptr<Track> &track);
     static std::vector<VirtualRoad> _ParseVirtualRoad(const LibOpenNFS::NFS3::ColFile &colFile);
     static std::vector<Entity> _ParseCOLModels(const LibOpenNFS::NFS3::ColFile &colFile, const std::shared_ptr<Track> &track);
+    static OnfsFile _BakeOnfsFile(const LibOpenNFS::NFS3::FrdFile &frdFile, const std::shared_ptr<Track> &track, const std::vector<std::string> &sourcePaths);
+    static bool _ParseOnfsFile(OnfsFile &onfsFile, const QfsArchive &trackTextures, const std::shared_ptr<Track> &track);
+    static OnfsMesh _BakeOnfsMesh(const Entity &entity);
+    static Entity _ParseOnfsMesh(uint32_t parentTrackblockID, OnfsMesh &onfsMesh);
 };
@@ -0,0 +1,254 @@
+#include "OnfsFile.h"
+
+#include <boost/filesystem.hpp>
+
+bool OnfsFile::Load(const std::string &onfsPath, OnfsFile &onfsFile)
+{
+    if (!boost::filesystem::exists(onfsPath))
+    {
+        return false;
+    }
+
+    LOG(INFO) << "Loading ONFS File located at " << onfsPath;
+    MappedStream onfs(std::make_shared<MappedFile>(onfsPath));
+
+    return onfsFile._SerializeIn(onfs);
+}
+
+void OnfsFile::Save(const std::string &onfsPath, OnfsFile &onfsFile)
+{
+    LOG(INFO) << "Saving ONFS File to " << onfsPath;
+    // Write alongside and move into place once complete, so an interrupted save can never leave a truncated cache behind
+    std::string tempPath = onfsPath + ".tmp";
+    boost::filesystem::create_directories(boost::filesystem::path(onfsPath).parent_path());
+    {
+        std::ofstream onfs(tempPath, std::ios::out | std::ios::binary);
+        onfsFile._SerializeOut(onfs);
+        if (!onfs.good())
+        {
+            LOG(WARNING) << "Failed to write ONFS File to " << tempPath;
+            return;
+        }
+    }
+
+    boost::system::error_code renameError;
+    boost::filesystem::rename(tempPath, onfsPath, renameError);
+    if (renameError)
+    {
+        LOG(WARNING) << "Failed to move ONFS File into place at " << onfsPath << ": " << renameError.message();
+    }
+}
+
+std::vector<OnfsSourceStamp> OnfsFile::StampSources(const std::vector<std::string> &sourcePaths)
+{
+    std::vector<OnfsSourceStamp> sourceStamps;
+
+    for (auto &sourcePath : sourcePaths)
+    {
+        boost::system::error_code statError;
+        OnfsSourceStamp sourceStamp{};
+        sourceStamp.fileSize      = boost::filesystem::file_size(sourcePath, statError);
+        sourceStamp.lastWriteTime = statError ? 0 : static_cast<int64_t>(boost::filesystem::last_write_time(sourcePath, statError));
+        sourceStamps.push_back(sourceStamp);
+    }
+
+    return sourceStamps;
+}
+
+bool OnfsFile::IsValidFor(NFSVer nfsVersion, const std::vector<std::string> &sourcePaths) const
+{
+    if (this->version != ONFS_CACHE_VERSION || this->nfsVersion != static_cast<uint32_t>(nfsVersion))
+    {
+        return false;
+    }
+
+    std::vector<OnfsSourceStamp> currentStamps = StampSources(sourcePaths);
+    if (currentStamps.size() != sourceStamps.size())
+    {
+        return false;
+    }
+    for (size_t sourceIdx = 0; sourceIdx < currentStamps.size(); ++sourceIdx)
+    {
+        if (currentStamps[sourceIdx].fileSize != sourceStamps[sourceIdx].fileSize || currentStamps[sourceIdx].lastWriteTime != sourceStamps[sourceIdx].lastWriteTime)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool OnfsFile::_SerializeIn(MappedStream &mappedStream)
+{
+    uint32_t signature;
+    SAFE_READ(mappedStream, &signature, sizeof(uint32_t));
+    if (signature != ONFS_SIGNATURE)
+    {
+        LOG(WARNING) << "Not an ONFS File, ignoring";
+        return false;
+    }
+    SAFE_READ(mappedStream, &version, sizeof(uint32_t));
+    if (version != ONFS_CACHE_VERSION)
+    {
+        // Layout may well differ, don't attempt to read any further
+        return true;
+    }
+    SAFE_READ(mappedStream, &nfsVersion, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nSources, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nBlocks, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nTextures, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nVirtualRoad, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nAnimPoints, sizeof(uint32_t));
+    SAFE_READ(mappedStream, &nGlobalObjects, sizeof(uint32_t));
+    if (!(_Fits(mappedStream, nSources, sizeof(OnfsSourceStamp)) && _Fits(mappedStream, nBlocks, sizeof(OnfsBlockHeader)) &&
+          _Fits(mappedStream, nTextures, sizeof(OnfsTexture)) && _Fits(mappedStream, nVirtualRoad, sizeof(VirtualRoad)) &&
+          _Fits(mappedStream, nAnimPoints, sizeof(CameraAnimPoint)) && _Fits(mappedStream, nGlobalObjects, sizeof(OnfsMeshHeader))))
+    {
+        return false;
+    }
+
+    sourceStamps.resize(nSources);
+    SAFE_READ(mappedStream, sourceStamps.data(), nSources * sizeof(OnfsSourceStamp));
+    textures.resize(nTextures);
+    SAFE_READ(mappedStream, textures.data(), nTextures * sizeof(OnfsTexture));
+    virtualRoad.resize(nVirtualRoad);
+    SAFE_READ(mappedStream, virtualRoad.data(), nVirtualRoad * sizeof(VirtualRoad));
+    animPoints.resize(nAnimPoints);
+    SAFE_READ(mappedStream, animPoints.data(), nAnimPoints * sizeof(CameraAnimPoint));
+
+    blocks.resize(nBlocks);
+    for (auto &block : blocks)
+    {
+        SAFE_READ(mappedStream, &block.header, sizeof(OnfsBlockHeader));
+        if (!(_Fits(mappedStream, block.header.nNeighbours, sizeof(uint32_t)) && _Fits(mappedStream, block.header.nTrackMeshes, sizeof(OnfsMeshHeader)) &&
+              _Fits(mappedStream, block.header.nObjectMeshes, sizeof(OnfsMeshHeader)) && _Fits(mappedStream, block.header.nLaneMeshes, sizeof(OnfsMeshHeader)) &&
+              _Fits(mappedStream, block.header.nMedResTrackMeshes, sizeof(OnfsMeshHeader)) && _Fits(mappedStream, block.header.nLoResTrackMeshes, sizeof(OnfsMeshHeader)) &&
+              _Fits(mappedStream, block.header.nLights, sizeof(OnfsPointSource)) && _Fits(mappedStream, block.header.nSounds, sizeof(OnfsPointSource))))
+        {
+            return false;
+        }
+        block.neighbourIds.resize(block.header.nNeighbours);
+        SAFE_READ(mappedStream, block.neighbourIds.data(), block.header.nNeighbours * sizeof(uint32_t));
+        if (!(_SerializeMeshesIn(mappedStream, block.trackMeshes, block.header.nTrackMeshes) &&
+              _SerializeMeshesIn(mappedStream, block.objectMeshes, block.header.nObjectMeshes) &&
+              _SerializeMeshesIn(mappedStream, block.laneMeshes, block.header.nLaneMeshes) &&
+              _SerializeMeshesIn(mappedStream, block.medResTrackMeshes, block.header.nMedResTrackMeshes) &&
+              _SerializeMeshesIn(mappedStream, block.loResTrackMeshes, block.header.nLoResTrackMeshes)))
+        {
+            return false;
+        }
+        block.lights.resize(block.header.nLights);
+        SAFE_READ(mappedStream, block.lights.data(), block.header.nLights * sizeof(OnfsPointSource));
+        block.sounds.resize(block.header.nSounds);
+        SAFE_READ(mappedStream, block.sounds.data(), block.header.nSounds * sizeof(OnfsPointSource));
+    }
+
+    return _SerializeMeshesIn(mappedStream, globalObjects, nGlobalObjects);
+}
+
+void OnfsFile::_SerializeOut(std::ofstream &ofstream)
+{
+    nSources       = static_cast<uint32_t>(sourceStamps.size());
+    nBlocks        = static_cast<uint32_t>(blocks.size());
+    nTextures      = static_cast<uint32_t>(textures.size());
+    nVirtualRoad   = static_cast<uint32_t>(virtualRoad.size());
+    nAnimPoints    = static_cast<uint32_t>(animPoints.size());
+    nGlobalObjects = static_cast<uint32_t>(globalObjects.size());
+
+    ofstream.write((char *) &ONFS_SIGNATURE, sizeof(uint32_t));
+    ofstream.write((char *) &version, sizeof(uint32_t));
+    ofstream.write((char *) &nfsVersion, sizeof(uint32_t));
+    ofstream.write((char *) &nSources, sizeof(uint32_t));
+    ofstream.write((char *) &nBlocks, sizeof(uint32_t));
+    ofstream.write((char *) &nTextures, sizeof(uint32_t));
+    ofstream.write((char *) &nVirtualRoad, sizeof(uint32_t));
+    ofstream.write((char *) &nAnimPoints, sizeof(uint32_t));
+    ofstream.write((char *) &nGlobalObjects, sizeof(uint32_t));
+
+    ofstream.write((char *) sourceStamps.data(), nSources * sizeof(OnfsSourceStamp));
+    ofstream.write((char *) textures.data(), nTextures * sizeof(OnfsTexture));
+    ofstream.write((char *) virtualRoad.data(), nVirtualRoad * sizeof(VirtualRoad));
+    ofstream.write((char *) animPoints.data(), nAnimPoints * sizeof(CameraAnimPoint));
+
+    for (auto &block : blocks)
+    {
+        block.header.nNeighbours        = static_cast<uint32_t>(block.neighbourIds.size());
+        block.header.nTrackMeshes       = static_cast<uint32_t>(block.trackMeshes.size());
+        block.header.nObjectMeshes      = static_cast<uint32_t>(block.objectMeshes.size());
+        block.header.nLaneMeshes        = static_cast<uint32_t>(block.laneMeshes.size());
+        block.header.nMedResTrackMeshes = static_cast<uint32_t>(block.medResTrackMeshes.size());
+        block.header.nLoResTrackMeshes  = static_cast<uint32_t>(block.loResTrackMeshes.size());
+        block.header.nLights            = static_cast<uint32_t>(block.lights.size());
+        block.header.nSounds            = static_cast<uint32_t>(block.sounds.size());
+
+        ofstream.write((char *) &block.header, sizeof(OnfsBlockHeader));
+        ofstream.write((char *) block.neighbourIds.data(), block.header.nNeighbours * sizeof(uint32_t));
+        _SerializeMeshesOut(ofstream, block.trackMeshes);
+        _SerializeMeshesOut(ofstream, block.objectMeshes);
+        _SerializeMeshesOut(ofstream, block.laneMeshes);
+        _SerializeMeshesOut(ofstream, block.medResTrackMeshes);
+        _SerializeMeshesOut(ofstream, block.loResTrackMeshes);
+        ofstream.write((char *) block.lights.data(), block.header.nLights * sizeof(OnfsPointSource));
+        ofstream.write((char *) block.sounds.data(), block.header.nSounds * sizeof(OnfsPointSource));
+    }
+
+    _SerializeMeshesOut(ofstream, globalObjects);
+}
+
+bool OnfsFile::_SerializeMeshesIn(MappedStream &mappedStream, std::vector<OnfsMesh> &meshes, uint32_t nMeshes)
+{
+    meshes.resize(nMeshes);
+    for (auto &mesh : meshes)
+    {
+        SAFE_READ(mappedStream, &mesh.header, sizeof(OnfsMeshHeader));
+        uint32_t nVertices = mesh.header.nVertices;
+        uint32_t nIndices  = mesh.header.nIndices;
+        if (!(_Fits(mappedStream, nVertices, sizeof(glm::vec3)) && _Fits(mappedStream, nIndices, sizeof(uint32_t))))
+        {
+            return false;
+        }
+        mesh.vertices.resize(nVertices);
+        SAFE_READ(mappedStream, mesh.vertices.data(), nVertices * sizeof(glm::vec3));
+        mesh.normals.resize(nVertices);
+        SAFE_READ(mappedStream, mesh.normals.data(), nVertices * sizeof(glm::vec3));
+        mesh.uvs.resize(nVertices);
+        SAFE_READ(mappedStream, mesh.uvs.data(), nVertices * sizeof(glm::vec2));
+        mesh.textureIndices.resize(nVertices);
+        SAFE_READ(mappedStream, mesh.textureIndices.data(), nVertices * sizeof(uint32_t));
+        mesh.shadingData.resize(nVertices);
+        SAFE_READ(mappedStream, mesh.shadingData.data(), nVertices * sizeof(glm::vec4));
+        mesh.vertexIndices.resize(nIndices);
+        SAFE_READ(mappedStream, mesh.vertexIndices.data(), nIndices * sizeof(uint32_t));
+        // A corrupt index would otherwise only show up as a bad draw
+        for (auto &vertexIndex : mesh.vertexIndices)
+        {
+            if (vertexIndex >= nVertices)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool OnfsFile::_Fits(const MappedStream &mappedStream, uint64_t count, size_t elementSize)
+{
+    // Catch corrupt counts before they're used to size any allocations
+    return count <= mappedStream.GetMappedFile()->Size() / elementSize;
+}
+
+void OnfsFile::_SerializeMeshesOut(std::ofstream &ofstream, const std::vector<OnfsMesh> &meshes)
+{
+    for (auto &mesh : meshes)
+    {
+        uint32_t nVertices = mesh.header.nVertices;
+        ofstream.write((char *) &mesh.header, sizeof(OnfsMeshHeader));
+        ofstream.write((char *) mesh.vertices.data(), nVertices * sizeof(glm::vec3));
+        ofstream.write((char *) mesh.normals.data(), nVertices * sizeof(glm::vec3));
+        ofstream.write((char *) mesh.uvs.data(), nVertices * sizeof(glm::vec2));
+        ofstream.write((char *) mesh.textureIndices.data(), nVertices * sizeof(uint32_t));
+        ofstream.write((char *) mesh.shadingData.data(), nVertices * sizeof(glm::vec4));
+        ofstream.write((char *) mesh.vertexIndices.data(), mesh.header.nIndices * sizeof(uint32_t));
+    }
+}
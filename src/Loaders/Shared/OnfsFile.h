@@ -0,0 +1,118 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "CanFile.h"
+#include "../Common/IRawData.h"
+#include "../../Scene/VirtualRoad.h"
+
+// Bump whenever the layout below, or the processing baked into it (UV generation, scaling etc.), changes. Stale caches are rebuilt.
+const uint32_t ONFS_CACHE_VERSION = 4;
+
+// Size and modification time of an original game file the cache was baked from, so edits to the source invalidate the cache
+struct OnfsSourceStamp
+{
+    uint64_t fileSize;
+    int64_t lastWriteTime;
+};
+
+// Texture array layer table entry. Holds the raw NFS3 texture block so the texture can be reloaded, and the layer/UV region it was baked against.
+struct OnfsTexture
+{
+    uint32_t textureId;
+    uint32_t layer;
+    float minU, minV, maxU, maxV;
+    uint16_t width, height;
+    uint32_t unknown1;
+    float corners[8];
+    uint32_t unknown2;
+    uint32_t isLane;
+    uint32_t qfsIndex;
+};
+
+struct OnfsMeshHeader
+{
+    uint32_t entityType;
+    uint32_t entityId;
+    uint32_t flags;
+    uint32_t nVertices;
+    uint32_t nIndices;
+    glm::vec3 position;
+};
+
+// Welded TrackModel streams, every vertex stream holds nVertices entries and the triangle list nIndices entries into them. Ready for upload as-is.
+struct OnfsMesh
+{
+    OnfsMeshHeader header;
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> uvs;
+    std::vector<uint32_t> textureIndices;
+    std::vector<glm::vec4> shadingData;
+    std::vector<uint32_t> vertexIndices;
+};
+
+// Track lights and sound sources
+struct OnfsPointSource
+{
+    uint32_t entityId;
+    uint32_t type;
+    glm::vec3 position;
+};
+
+struct OnfsBlockHeader
+{
+    uint32_t id;
+    glm::vec3 position;
+    uint32_t virtualRoadStartIndex;
+    uint32_t nVirtualRoadPositions;
+    uint32_t nNeighbours;
+    uint32_t nTrackMeshes, nObjectMeshes, nLaneMeshes;
+    uint32_t nMedResTrackMeshes, nLoResTrackMeshes;
+    uint32_t nLights, nSounds;
+};
+
+struct OnfsBlock
+{
+    OnfsBlockHeader header;
+    std::vector<uint32_t> neighbourIds;
+    std::vector<OnfsMesh> trackMeshes;
+    std::vector<OnfsMesh> objectMeshes;
+    std::vector<OnfsMesh> laneMeshes;
+    std::vector<OnfsMesh> medResTrackMeshes;
+    std::vector<OnfsMesh> loResTrackMeshes;
+    std::vector<OnfsPointSource> lights;
+    std::vector<OnfsPointSource> sounds;
+};
+
+// Pre-baked, fully processed ONFS track. Written after a cold load, and read back on later loads in place of the original game files.
+class OnfsFile : IMappedRawData
+{
+public:
+    OnfsFile() = default;
+    static bool Load(const std::string &onfsPath, OnfsFile &onfsFile);
+    static void Save(const std::string &onfsPath, OnfsFile &onfsFile);
+    static std::vector<OnfsSourceStamp> StampSources(const std::vector<std::string> &sourcePaths);
+    // True if the cache was baked by this version of ONFS from exactly these source files
+    bool IsValidFor(NFSVer nfsVersion, const std::vector<std::string> &sourcePaths) const;
+
+    uint32_t version = ONFS_CACHE_VERSION;
+    uint32_t nfsVersion;
+    uint32_t nSources;
+    uint32_t nBlocks, nTextures, nVirtualRoad, nAnimPoints, nGlobalObjects;
+
+    std::vector<OnfsSourceStamp> sourceStamps;
+    std::vector<OnfsTexture> textures;
+    std::vector<VirtualRoad> virtualRoad;
+    std::vector<CameraAnimPoint> animPoints;
+    std::vector<OnfsBlock> blocks;
+    std::vector<OnfsMesh> globalObjects;
+
+private:
+    bool _SerializeIn(MappedStream &mappedStream) override;
+    void _SerializeOut(std::ofstream &ofstream) override;
+
+    static bool _SerializeMeshesIn(MappedStream &mappedStream, std::vector<OnfsMesh> &meshes, uint32_t nMeshes);
+    static void _SerializeMeshesOut(std::ofstream &ofstream, const std::vector<OnfsMesh> &meshes);
+    static bool _Fits(const MappedStream &mappedStream, uint64_t count, size_t elementSize);
+};
@@ -0,0 +1,92 @@
+#include "VivArchive.h"
+
+#include <algorithm>
+#include <cctype>
+
+VivArchive::VivArchive(const std::string &vivPath) : m_vivFile(std::make_shared<MappedFile>(vivPath))
+{
+    LOG(INFO) << "Opening VIV file located at " << vivPath;
+    MappedStream viv(m_vivFile);
+
+    char vivHeader[4];
+    uint32_t vivSize, nFiles, startPos;
+    viv.read(vivHeader, sizeof(vivHeader));
+    viv.read((char *) &vivSize, sizeof(uint32_t));
+    viv.read((char *) &nFiles, sizeof(uint32_t));
+    viv.read((char *) &startPos, sizeof(uint32_t));
+    if (viv.fail() || memcmp(vivHeader, "BIGF", sizeof(vivHeader)) != 0)
+    {
+        LOG(WARNING) << "Not a valid VIV file (BIGF header missing): " << vivPath;
+        return;
+    }
+    nFiles = Utils::SwapEndian(nFiles);
+    LOG(INFO) << "VIV contains " << nFiles << " files";
+
+    for (uint32_t fileIdx = 0; fileIdx < nFiles; ++fileIdx)
+    {
+        VivEntry vivEntry{};
+        viv.read((char *) &vivEntry.offset, sizeof(uint32_t));
+        viv.read((char *) &vivEntry.size, sizeof(uint32_t));
+        vivEntry.offset = Utils::SwapEndian(vivEntry.offset);
+        vivEntry.size   = Utils::SwapEndian(vivEntry.size);
+
+        std::string fileName;
+        char c;
+        while (viv.read(&c, sizeof(char)).gcount() == sizeof(char) && c != '\0')
+        {
+            fileName.push_back(c);
+        }
+        if (viv.fail())
+        {
+            LOG(WARNING) << "VIV directory is truncated: " << vivPath;
+            return;
+        }
+        if (vivEntry.offset > m_vivFile->Size() || vivEntry.size > m_vivFile->Size() - vivEntry.offset)
+        {
+            LOG(WARNING) << "VIV entry " << fileName << " lies outside of the archive, skipping";
+            continue;
+        }
+        m_entries[_ToLower(fileName)] = vivEntry;
+    }
+
+    m_isOpen = true;
+}
+
+bool VivArchive::IsOpen() const
+{
+    return m_isOpen;
+}
+
+bool VivArchive::HasFile(const std::string &fileName) const
+{
+    return m_entries.count(_ToLower(fileName)) != 0;
+}
+
+MappedStream VivArchive::OpenFile(const std::string &fileName) const
+{
+    auto entry = m_entries.find(_ToLower(fileName));
+    if (entry == m_entries.end())
+    {
+        return MappedStream(m_vivFile, 0, 0);
+    }
+
+    return MappedStream(m_vivFile, entry->second.offset, entry->second.size);
+}
+
+RawView<char> VivArchive::GetFile(const std::string &fileName) const
+{
+    auto entry = m_entries.find(_ToLower(fileName));
+    if (entry == m_entries.end())
+    {
+        return RawView<char>();
+    }
+
+    return RawView<char>(m_vivFile->Data() + entry->second.offset, entry->second.size);
+}
+
+std::string VivArchive::_ToLower(const std::string &fileName)
+{
+    std::string lowerFileName(fileName);
+    std::transform(lowerFileName.begin(), lowerFileName.end(), lowerFileName.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+    return lowerFileName;
+}
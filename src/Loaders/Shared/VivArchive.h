@@ -0,0 +1,33 @@
+#pragma once
+
+#include <map>
+
+#include "../Common/IRawData.h"
+
+// Memory-mapped BIGF (VIV) archive. The directory is parsed once on open, files are then handed out as views straight into the mapping
+// rather than being extracted to disk as Utils::ExtractVIV does.
+class VivArchive
+{
+public:
+    explicit VivArchive(const std::string &vivPath);
+    bool IsOpen() const;
+    bool HasFile(const std::string &fileName) const;
+    // Stream over a single file, for the LibOpenNFS parsers. A missing file gives an empty stream that fails on first read.
+    MappedStream OpenFile(const std::string &fileName) const;
+    // Raw bytes of a single file, empty if missing. Only valid for as long as the archive is.
+    RawView<char> GetFile(const std::string &fileName) const;
+
+private:
+    struct VivEntry
+    {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    // File names are matched case insensitively, as they were once extracted
+    static std::string _ToLower(const std::string &fileName);
+
+    std::shared_ptr<MappedFile> m_vivFile;
+    std::map<std::string, VivEntry> m_entries;
+    bool m_isOpen = false;
+};
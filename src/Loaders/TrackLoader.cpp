@@ -54,7 +54,10 @@ std::shared_ptr<Track> TrackLoader::LoadTrack(NFSVer trackVersion, const std::st
     }
 
     loadedTrack->GenerateSpline();
+    loadedTrack->GenerateGeometryPool();
     loadedTrack->GenerateAabbTree();
+    loadedTrack->GeneratePotentiallyVisibleSet();
+    loadedTrack->GenerateSpatialIndex();
 
     return loadedTrack;
 }
\ No newline at end of file
@@ -1,304 +1,305 @@
 #include "AABBTree.h"
 
+#include <algorithm>
 #include <cassert>
-#include <stack>
+#include <cfloat>
 
-AABBTree::AABBTree(unsigned initialSize) : _rootNodeIndex(AABB_NULL_NODE), _allocatedNodeCount(0), _nextFreeNodeIndex(0), _nodeCapacity(initialSize), _growthSize(initialSize)
-{
-    _nodes.resize(initialSize);
-    for (unsigned nodeIndex = 0; nodeIndex < initialSize; nodeIndex++)
-    {
-        AABBNode& node     = _nodes[nodeIndex];
-        node.nextNodeIndex = nodeIndex + 1;
-    }
-    _nodes[initialSize - 1].nextNodeIndex = AABB_NULL_NODE;
-}
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define AABB_TREE_SSE
+#include <xmmintrin.h>
+#endif
 
-AABBTree::~AABBTree()
+namespace
 {
-}
+    const uint32_t SAH_BIN_COUNT = 16;
+    // Beyond this depth objects are split at the median, bounding the traversal stack whatever the input
+    const uint32_t MAX_SAH_DEPTH       = 32;
+    const uint32_t MAX_TRAVERSAL_DEPTH = 256;
 
-unsigned AABBTree::allocateNode()
-{
-    // if we have no free tree nodes then grow the pool
-    if (_nextFreeNodeIndex == AABB_NULL_NODE)
+    float HalfSurfaceArea(const glm::vec3 &min, const glm::vec3 &max)
     {
-        assert(_allocatedNodeCount == _nodeCapacity);
+        glm::vec3 extent = max - min;
+        return extent.x * extent.y + extent.x * extent.z + extent.y * extent.z;
+    }
 
-        _nodeCapacity += _growthSize;
-        _nodes.resize(_nodeCapacity);
-        for (unsigned nodeIndex = _allocatedNodeCount; nodeIndex < _nodeCapacity; nodeIndex++)
+    // p-vertex test of the four child bounds against every plane: a box is outside if the corner furthest along a plane's normal is behind it.
+    // That corner only depends on the sign of the normal, so each plane picks whole min or max lanes rather than per box.
+    uint32_t IntersectFrustum(const AABBNode &node, const std::array<glm::vec4, FrustumPlanes::Length> &planes)
+    {
+#ifdef AABB_TREE_SSE
+        __m128 outside = _mm_setzero_ps();
+        for (auto &plane : planes)
+        {
+            __m128 pX  = _mm_loadu_ps(plane.x >= 0.f ? node.maxX : node.minX);
+            __m128 pY  = _mm_loadu_ps(plane.y >= 0.f ? node.maxY : node.minY);
+            __m128 pZ  = _mm_loadu_ps(plane.z >= 0.f ? node.maxZ : node.minZ);
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), pX), _mm_mul_ps(_mm_set1_ps(plane.y), pY)),
+                                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), pZ), _mm_set1_ps(plane.w)));
+            outside    = _mm_or_ps(outside, _mm_cmplt_ps(dot, _mm_setzero_ps()));
+        }
+        return ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xF;
+#else
+        uint32_t insideMask = 0xF;
+        for (auto &plane : planes)
         {
-            AABBNode& node     = _nodes[nodeIndex];
-            node.nextNodeIndex = nodeIndex + 1;
+            const float *pX = plane.x >= 0.f ? node.maxX : node.minX;
+            const float *pY = plane.y >= 0.f ? node.maxY : node.minY;
+            const float *pZ = plane.z >= 0.f ? node.maxZ : node.minZ;
+            for (uint32_t slot = 0; slot < 4; ++slot)
+            {
+                if (plane.x * pX[slot] + plane.y * pY[slot] + plane.z * pZ[slot] + plane.w < 0.f)
+                {
+                    insideMask &= ~(1u << slot);
+                }
+            }
         }
-        _nodes[_nodeCapacity - 1].nextNodeIndex = AABB_NULL_NODE;
-        _nextFreeNodeIndex                      = _allocatedNodeCount;
+        return insideMask;
+#endif
     }
+} // namespace
 
-    unsigned nodeIndex            = _nextFreeNodeIndex;
-    AABBNode& allocatedNode       = _nodes[nodeIndex];
-    allocatedNode.parentNodeIndex = AABB_NULL_NODE;
-    allocatedNode.leftNodeIndex   = AABB_NULL_NODE;
-    allocatedNode.rightNodeIndex  = AABB_NULL_NODE;
-    _nextFreeNodeIndex            = allocatedNode.nextNodeIndex;
-    _allocatedNodeCount++;
-
-    return nodeIndex;
-}
-
-void AABBTree::deallocateNode(unsigned nodeIndex)
-{
-    AABBNode& deallocatedNode     = _nodes[nodeIndex];
-    deallocatedNode.nextNodeIndex = _nextFreeNodeIndex;
-    _nextFreeNodeIndex            = nodeIndex;
-    _allocatedNodeCount--;
-}
-
-void AABBTree::insertObject(const std::shared_ptr<IAABB>& object)
+void AABBTree::Build(const std::vector<const IAABB *> &objects)
 {
-    unsigned nodeIndex = allocateNode();
-    AABBNode& node     = _nodes[nodeIndex];
-
-    node.aabb   = object->GetAABB();
-    node.object = object;
+    m_nodes.clear();
+    m_objects       = objects;
+    m_rootNodeIndex = AABB_NULL_NODE;
+    if (objects.empty())
+    {
+        return;
+    }
 
-    insertLeaf(nodeIndex);
-    _objectNodeIndexMap[object] = nodeIndex;
-}
+    // AABBs are relative to their position, the tree works in world space
+    std::vector<BuildObject> buildObjects(objects.size());
+    for (uint32_t objectIdx = 0; objectIdx < objects.size(); ++objectIdx)
+    {
+        AABB aabb                         = objects[objectIdx]->GetAABB();
+        buildObjects[objectIdx].min       = aabb.position + glm::min(aabb.min, aabb.max);
+        buildObjects[objectIdx].max       = aabb.position + glm::max(aabb.min, aabb.max);
+        buildObjects[objectIdx].centroid  = (buildObjects[objectIdx].min + buildObjects[objectIdx].max) * 0.5f;
+        buildObjects[objectIdx].objectIdx = objectIdx;
+    }
 
-void AABBTree::removeObject(const std::shared_ptr<IAABB>& object)
-{
-    unsigned nodeIndex = _objectNodeIndexMap[object];
-    removeLeaf(nodeIndex);
-    deallocateNode(nodeIndex);
-    _objectNodeIndexMap.erase(object);
-}
+    std::vector<BinaryNode> binaryNodes;
+    binaryNodes.reserve(objects.size() * 2);
+    uint32_t binaryRootIdx = _BuildBinary(buildObjects, 0, buildObjects.size(), 0, binaryNodes);
 
-void AABBTree::updateObject(const std::shared_ptr<IAABB>& object)
-{
-    unsigned nodeIndex = _objectNodeIndexMap[object];
-    updateLeaf(nodeIndex, object->GetAABB());
+    m_nodes.reserve(objects.size() / 2 + 1);
+    m_rootNodeIndex = _Collapse(binaryNodes, binaryRootIdx);
 }
 
-std::forward_list<std::shared_ptr<IAABB>> AABBTree::queryOverlaps(const Frustum& frustum) const
+void AABBTree::QueryOverlaps(const Frustum &frustum, std::vector<const IAABB *> &overlaps) const
 {
-    std::forward_list<std::shared_ptr<IAABB>> overlaps;
-    std::stack<unsigned> stack;
-
-    stack.push(_rootNodeIndex);
-    while (!stack.empty())
+    if (m_rootNodeIndex == AABB_NULL_NODE)
     {
-        unsigned nodeIndex = stack.top();
-        stack.pop();
-
-        if (nodeIndex == AABB_NULL_NODE)
-            continue;
+        return;
+    }
 
-        const AABBNode& node = _nodes[nodeIndex];
-        if (frustum.CheckIntersection(node.aabb))
+    const auto &planes = frustum.GetPlanes();
+    uint32_t stack[MAX_TRAVERSAL_DEPTH];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = m_rootNodeIndex;
+    while (stackSize > 0)
+    {
+        const AABBNode &node = m_nodes[stack[--stackSize]];
+        uint32_t insideMask  = IntersectFrustum(node, planes);
+        for (uint32_t slot = 0; slot < 4; ++slot)
         {
-            if (node.isLeaf())
+            uint32_t child = node.children[slot];
+            if (!(insideMask & (1u << slot)) || child == AABB_NULL_NODE)
             {
-                overlaps.push_front(node.object);
+                continue;
+            }
+            if (child & AABB_LEAF_BIT)
+            {
+                overlaps.push_back(m_objects[child & ~AABB_LEAF_BIT]);
             }
             else
             {
-                stack.push(node.leftNodeIndex);
-                stack.push(node.rightNodeIndex);
+                assert(stackSize < MAX_TRAVERSAL_DEPTH);
+                stack[stackSize++] = child;
             }
         }
     }
-
-    return overlaps;
 }
 
-void AABBTree::insertLeaf(unsigned leafNodeIndex)
+size_t AABBTree::GetObjectCount() const
 {
-    // make sure we're inserting a new leaf
-    assert(_nodes[leafNodeIndex].parentNodeIndex == AABB_NULL_NODE);
-    assert(_nodes[leafNodeIndex].leftNodeIndex == AABB_NULL_NODE);
-    assert(_nodes[leafNodeIndex].rightNodeIndex == AABB_NULL_NODE);
+    return m_objects.size();
+}
 
-    // if the tree is empty then we make the root the leaf
-    if (_rootNodeIndex == AABB_NULL_NODE)
+uint32_t AABBTree::_BuildBinary(std::vector<BuildObject> &buildObjects, size_t begin, size_t end, uint32_t depth, std::vector<BinaryNode> &binaryNodes)
+{
+    BinaryNode node;
+    node.min       = glm::vec3(FLT_MAX);
+    node.max       = glm::vec3(-FLT_MAX);
+    node.left      = AABB_NULL_NODE;
+    node.right     = AABB_NULL_NODE;
+    node.objectIdx = AABB_NULL_NODE;
+    glm::vec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+    for (size_t buildIdx = begin; buildIdx < end; ++buildIdx)
     {
-        _rootNodeIndex = leafNodeIndex;
-        return;
+        node.min    = glm::min(node.min, buildObjects[buildIdx].min);
+        node.max    = glm::max(node.max, buildObjects[buildIdx].max);
+        centroidMin = glm::min(centroidMin, buildObjects[buildIdx].centroid);
+        centroidMax = glm::max(centroidMax, buildObjects[buildIdx].centroid);
     }
 
-    // search for the best place to put the new leaf in the tree
-    // we use surface area and depth as search heuristics
-    unsigned treeNodeIndex = _rootNodeIndex;
-    AABBNode& leafNode     = _nodes[leafNodeIndex];
-    while (!_nodes[treeNodeIndex].isLeaf())
+    uint32_t nodeIdx = static_cast<uint32_t>(binaryNodes.size());
+    if (end - begin == 1)
     {
-        // because of the test in the while loop above we know we are never a leaf inside it
-        const AABBNode& treeNode  = _nodes[treeNodeIndex];
-        unsigned leftNodeIndex    = treeNode.leftNodeIndex;
-        unsigned rightNodeIndex   = treeNode.rightNodeIndex;
-        const AABBNode& leftNode  = _nodes[leftNodeIndex];
-        const AABBNode& rightNode = _nodes[rightNodeIndex];
-
-        AABB combinedAabb = treeNode.aabb.Merge(leafNode.aabb);
+        node.objectIdx = buildObjects[begin].objectIdx;
+        binaryNodes.push_back(node);
+        return nodeIdx;
+    }
+    binaryNodes.push_back(node);
 
-        float newParentNodeCost   = 2.0f * combinedAabb.surfaceArea;
-        float minimumPushDownCost = 2.0f * (combinedAabb.surfaceArea - treeNode.aabb.surfaceArea);
+    // Split along the axis the centroids spread furthest on
+    glm::vec3 centroidExtent = centroidMax - centroidMin;
+    int axis                 = centroidExtent.x > centroidExtent.y ? (centroidExtent.x > centroidExtent.z ? 0 : 2) : (centroidExtent.y > centroidExtent.z ? 1 : 2);
+    size_t mid               = begin + (end - begin) / 2;
+    bool useSAH              = depth < MAX_SAH_DEPTH && centroidExtent[axis] > 0.f;
 
-        // use the costs to figure out whether to create a new parent here or descend
-        float costLeft;
-        float costRight;
-        if (leftNode.isLeaf())
-        {
-            costLeft = leafNode.aabb.Merge(leftNode.aabb).surfaceArea + minimumPushDownCost;
-        }
-        else
+    if (useSAH)
+    {
+        struct Bin
         {
-            AABB newLeftAabb = leafNode.aabb.Merge(leftNode.aabb);
-            costLeft         = (newLeftAabb.surfaceArea - leftNode.aabb.surfaceArea) + minimumPushDownCost;
-        }
-        if (rightNode.isLeaf())
+            glm::vec3 min  = glm::vec3(FLT_MAX);
+            glm::vec3 max  = glm::vec3(-FLT_MAX);
+            uint32_t count = 0;
+        } bins[SAH_BIN_COUNT];
+        float binScale = SAH_BIN_COUNT / centroidExtent[axis];
+        auto binOf     = [&](const BuildObject &buildObject) {
+            return std::min(static_cast<uint32_t>((buildObject.centroid[axis] - centroidMin[axis]) * binScale), SAH_BIN_COUNT - 1);
+        };
+        for (size_t buildIdx = begin; buildIdx < end; ++buildIdx)
         {
-            costRight = leafNode.aabb.Merge(rightNode.aabb).surfaceArea + minimumPushDownCost;
+            Bin &bin = bins[binOf(buildObjects[buildIdx])];
+            bin.min  = glm::min(bin.min, buildObjects[buildIdx].min);
+            bin.max  = glm::max(bin.max, buildObjects[buildIdx].max);
+            ++bin.count;
         }
-        else
+
+        // Sweep from the right to get the cost of everything above each split, then from the left to find the cheapest
+        float rightCost[SAH_BIN_COUNT];
+        glm::vec3 sweepMin(FLT_MAX), sweepMax(-FLT_MAX);
+        uint32_t sweepCount = 0;
+        for (uint32_t binIdx = SAH_BIN_COUNT - 1; binIdx > 0; --binIdx)
         {
-            AABB newRightAabb = leafNode.aabb.Merge(rightNode.aabb);
-            costRight         = (newRightAabb.surfaceArea - rightNode.aabb.surfaceArea) + minimumPushDownCost;
+            sweepMin = glm::min(sweepMin, bins[binIdx].min);
+            sweepMax = glm::max(sweepMax, bins[binIdx].max);
+            sweepCount += bins[binIdx].count;
+            rightCost[binIdx] = sweepCount > 0 ? sweepCount * HalfSurfaceArea(sweepMin, sweepMax) : 0.f;
         }
-
-        // if the cost of creating a new parent node here is less than descending in either direction then
-        // we know we need to create a new parent node, errrr, here and attach the leaf to that
-        if (newParentNodeCost < costLeft && newParentNodeCost < costRight)
+        sweepMin           = glm::vec3(FLT_MAX);
+        sweepMax           = glm::vec3(-FLT_MAX);
+        sweepCount         = 0;
+        float bestCost     = FLT_MAX;
+        uint32_t bestSplit = 0;
+        for (uint32_t splitIdx = 1; splitIdx < SAH_BIN_COUNT; ++splitIdx)
         {
-            break;
+            sweepMin = glm::min(sweepMin, bins[splitIdx - 1].min);
+            sweepMax = glm::max(sweepMax, bins[splitIdx - 1].max);
+            sweepCount += bins[splitIdx - 1].count;
+            if (sweepCount == 0 || sweepCount == end - begin)
+            {
+                continue;
+            }
+            float cost = sweepCount * HalfSurfaceArea(sweepMin, sweepMax) + rightCost[splitIdx];
+            if (cost < bestCost)
+            {
+                bestCost  = cost;
+                bestSplit = splitIdx;
+            }
         }
 
-        // otherwise descend in the cheapest direction
-        if (costLeft < costRight)
+        if (bestSplit > 0)
         {
-            treeNodeIndex = leftNodeIndex;
+            auto splitItr = std::partition(buildObjects.begin() + begin, buildObjects.begin() + end, [&](const BuildObject &buildObject) { return binOf(buildObject) < bestSplit; });
+            mid           = splitItr - buildObjects.begin();
         }
         else
         {
-            treeNodeIndex = rightNodeIndex;
+            useSAH = false;
         }
     }
-
-    // the leafs sibling is going to be the node we found above and we are going to create a new
-    // parent node and attach the leaf and this item
-    unsigned leafSiblingIndex   = treeNodeIndex;
-    AABBNode& leafSibling       = _nodes[leafSiblingIndex];
-    unsigned oldParentIndex     = leafSibling.parentNodeIndex;
-    unsigned newParentIndex     = allocateNode();
-    AABBNode& newParent         = _nodes[newParentIndex];
-    newParent.parentNodeIndex   = oldParentIndex;
-    newParent.aabb              = leafNode.aabb.Merge(leafSibling.aabb); // the new parents aabb is the leaf aabb combined with it's siblings aabb
-    newParent.leftNodeIndex     = leafSiblingIndex;
-    newParent.rightNodeIndex    = leafNodeIndex;
-    leafNode.parentNodeIndex    = newParentIndex;
-    leafSibling.parentNodeIndex = newParentIndex;
-
-    if (oldParentIndex == AABB_NULL_NODE)
-    {
-        // the old parent was the root and so this is now the root
-        _rootNodeIndex = newParentIndex;
-    }
-    else
+    if (!useSAH)
     {
-        // the old parent was not the root and so we need to patch the left or right index to
-        // point to the new node
-        AABBNode& oldParent = _nodes[oldParentIndex];
-        if (oldParent.leftNodeIndex == leafSiblingIndex)
-        {
-            oldParent.leftNodeIndex = newParentIndex;
-        }
-        else
-        {
-            oldParent.rightNodeIndex = newParentIndex;
-        }
+        std::nth_element(buildObjects.begin() + begin, buildObjects.begin() + mid, buildObjects.begin() + end,
+                         [axis](const BuildObject &a, const BuildObject &b) { return a.centroid[axis] < b.centroid[axis]; });
     }
 
-    // finally we need to walk back up the tree fixing heights and areas
-    treeNodeIndex = leafNode.parentNodeIndex;
-    fixUpwardsTree(treeNodeIndex);
+    // binaryNodes grows in the recursion, so only index into it afterwards
+    uint32_t leftIdx           = _BuildBinary(buildObjects, begin, mid, depth + 1, binaryNodes);
+    uint32_t rightIdx          = _BuildBinary(buildObjects, mid, end, depth + 1, binaryNodes);
+    binaryNodes[nodeIdx].left  = leftIdx;
+    binaryNodes[nodeIdx].right = rightIdx;
+
+    return nodeIdx;
 }
 
-void AABBTree::removeLeaf(unsigned leafNodeIndex)
+uint32_t AABBTree::_Collapse(const std::vector<BinaryNode> &binaryNodes, uint32_t binaryNodeIdx)
 {
-    // if the leaf is the root then we can just clear the root pointer and return
-    if (leafNodeIndex == _rootNodeIndex)
+    // Pull up grandchildren until there are four children, opening the largest interior node each time
+    uint32_t children[4];
+    uint32_t nChildren           = 0;
+    const BinaryNode &binaryNode = binaryNodes[binaryNodeIdx];
+    if (binaryNode.left == AABB_NULL_NODE)
     {
-        _rootNodeIndex = AABB_NULL_NODE;
-        return;
+        // Only a single object in the whole tree
+        children[nChildren++] = binaryNodeIdx;
     }
-
-    AABBNode& leafNode            = _nodes[leafNodeIndex];
-    unsigned parentNodeIndex      = leafNode.parentNodeIndex;
-    const AABBNode& parentNode    = _nodes[parentNodeIndex];
-    unsigned grandParentNodeIndex = parentNode.parentNodeIndex;
-    unsigned siblingNodeIndex     = parentNode.leftNodeIndex == leafNodeIndex ? parentNode.rightNodeIndex : parentNode.leftNodeIndex;
-    assert(siblingNodeIndex != AABB_NULL_NODE); // we must have a sibling
-    AABBNode& siblingNode = _nodes[siblingNodeIndex];
-
-    if (grandParentNodeIndex != AABB_NULL_NODE)
+    else
+    {
+        children[nChildren++] = binaryNode.left;
+        children[nChildren++] = binaryNode.right;
+    }
+    while (nChildren < 4)
     {
-        // if we have a grand parent (i.e. the parent is not the root) then destroy the parent and connect the sibling to the grandparent in
-        // its place
-        AABBNode& grandParentNode = _nodes[grandParentNodeIndex];
-        if (grandParentNode.leftNodeIndex == parentNodeIndex)
+        int largestInterior = -1;
+        float largestArea   = -1.f;
+        for (uint32_t childIdx = 0; childIdx < nChildren; ++childIdx)
         {
-            grandParentNode.leftNodeIndex = siblingNodeIndex;
+            const BinaryNode &child = binaryNodes[children[childIdx]];
+            float area              = HalfSurfaceArea(child.min, child.max);
+            if (child.left != AABB_NULL_NODE && area > largestArea)
+            {
+                largestInterior = static_cast<int>(childIdx);
+                largestArea     = area;
+            }
         }
-        else
+        if (largestInterior < 0)
         {
-            grandParentNode.rightNodeIndex = siblingNodeIndex;
+            break;
         }
-        siblingNode.parentNodeIndex = grandParentNodeIndex;
-        deallocateNode(parentNodeIndex);
-
-        fixUpwardsTree(grandParentNodeIndex);
-    }
-    else
-    {
-        // if we have no grandparent then the parent is the root and so our sibling becomes the root and has it's parent removed
-        _rootNodeIndex              = siblingNodeIndex;
-        siblingNode.parentNodeIndex = AABB_NULL_NODE;
-        deallocateNode(parentNodeIndex);
+        const BinaryNode &opened  = binaryNodes[children[largestInterior]];
+        children[largestInterior] = opened.left;
+        children[nChildren++]     = opened.right;
     }
 
-    leafNode.parentNodeIndex = AABB_NULL_NODE;
-}
-
-void AABBTree::updateLeaf(unsigned leafNodeIndex, const AABB& newAaab)
-{
-    AABBNode& node = _nodes[leafNodeIndex];
-
-    // if the node contains the new aabb then we just leave things
-    // TODO: when we add velocity this check should kick in as often an update will lie within the velocity fattened initial aabb
-    // to support this we might need to differentiate between velocity fattened aabb and actual aabb
-    if (node.aabb.Contains(newAaab))
-        return;
-
-    removeLeaf(leafNodeIndex);
-    node.aabb = newAaab;
-    insertLeaf(leafNodeIndex);
-}
-
-void AABBTree::fixUpwardsTree(unsigned treeNodeIndex)
-{
-    while (treeNodeIndex != AABB_NULL_NODE)
+    // m_nodes grows in the recursion, so only index into it afterwards
+    uint32_t nodeIdx = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+    for (uint32_t slot = 0; slot < 4; ++slot)
     {
-        AABBNode& treeNode = _nodes[treeNodeIndex];
-
-        // every node should be a parent
-        assert(treeNode.leftNodeIndex != AABB_NULL_NODE && treeNode.rightNodeIndex != AABB_NULL_NODE);
-
-        // fix height and area
-        const AABBNode& leftNode  = _nodes[treeNode.leftNodeIndex];
-        const AABBNode& rightNode = _nodes[treeNode.rightNodeIndex];
-        treeNode.aabb             = leftNode.aabb.Merge(rightNode.aabb);
-
-        treeNodeIndex = treeNode.parentNodeIndex;
+        // Empty slots get inverted bounds, which every frustum plane rejects
+        glm::vec3 slotMin(FLT_MAX), slotMax(-FLT_MAX);
+        uint32_t slotChild = AABB_NULL_NODE;
+        if (slot < nChildren)
+        {
+            const BinaryNode &child = binaryNodes[children[slot]];
+            slotMin                 = child.min;
+            slotMax                 = child.max;
+            slotChild               = child.left == AABB_NULL_NODE ? (AABB_LEAF_BIT | child.objectIdx) : _Collapse(binaryNodes, children[slot]);
+        }
+        AABBNode &node      = m_nodes[nodeIdx];
+        node.minX[slot]     = slotMin.x;
+        node.minY[slot]     = slotMin.y;
+        node.minZ[slot]     = slotMin.z;
+        node.maxX[slot]     = slotMax.x;
+        node.maxY[slot]     = slotMax.y;
+        node.maxZ[slot]     = slotMax.z;
+        node.children[slot] = slotChild;
     }
+
+    return nodeIdx;
 }
@@ -1,61 +1,55 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
 #include <vector>
-#include <map>
-#include <forward_list>
+#include <glm/glm.hpp>
 
 #include "AABB.h"
 #include "Frustum.h"
 #include "IAABB.h"
 
 #define AABB_NULL_NODE 0xffffffff
+// Set on a child slot that holds an object index rather than a node index
+#define AABB_LEAF_BIT 0x80000000
 
+// Four children per node, their world space bounds stored as SoA so that one frustum test covers all of them at once
 struct AABBNode
 {
-    AABB aabb;
-    std::shared_ptr<IAABB> object;
-    // tree links
-    unsigned parentNodeIndex;
-    unsigned leftNodeIndex;
-    unsigned rightNodeIndex;
-    // node linked list link
-    unsigned nextNodeIndex;
-
-    bool isLeaf() const
-    {
-        return leftNodeIndex == AABB_NULL_NODE;
-    }
-
-    AABBNode() : object(nullptr), parentNodeIndex(AABB_NULL_NODE), leftNodeIndex(AABB_NULL_NODE), rightNodeIndex(AABB_NULL_NODE), nextNodeIndex(AABB_NULL_NODE)
-    {
-    }
+    float minX[4], minY[4], minZ[4];
+    float maxX[4], maxY[4], maxZ[4];
+    uint32_t children[4];
 };
 
+// Static 4-wide BVH over objects that are owned elsewhere, bulk built with a binned SAH
 class AABBTree
 {
+public:
+    AABBTree() = default;
+
+    // Builds over the objects' current bounds. The objects must outlive the tree, and it needs rebuilding for any of them to move.
+    void Build(const std::vector<const IAABB *> &objects);
+    // Appends the objects whose bounds are at least partly inside the frustum
+    void QueryOverlaps(const Frustum &frustum, std::vector<const IAABB *> &overlaps) const;
+    size_t GetObjectCount() const;
+
 private:
-    std::map<std::shared_ptr<IAABB>, unsigned> _objectNodeIndexMap;
-    std::vector<AABBNode> _nodes;
-    unsigned _rootNodeIndex;
-    unsigned _allocatedNodeCount;
-    unsigned _nextFreeNodeIndex;
-    unsigned _nodeCapacity;
-    unsigned _growthSize;
-
-    unsigned allocateNode();
-    void deallocateNode(unsigned nodeIndex);
-    void insertLeaf(unsigned leafNodeIndex);
-    void removeLeaf(unsigned leafNodeIndex);
-    void updateLeaf(unsigned leafNodeIndex, const AABB& newAaab);
-    void fixUpwardsTree(unsigned treeNodeIndex);
+    struct BuildObject
+    {
+        glm::vec3 min, max, centroid;
+        uint32_t objectIdx;
+    };
 
-public:
-    AABBTree(unsigned initialSize);
-    ~AABBTree();
+    struct BinaryNode
+    {
+        glm::vec3 min, max;
+        uint32_t left, right; // AABB_NULL_NODE for a leaf
+        uint32_t objectIdx;
+    };
+
+    uint32_t _BuildBinary(std::vector<BuildObject> &buildObjects, size_t begin, size_t end, uint32_t depth, std::vector<BinaryNode> &binaryNodes);
+    uint32_t _Collapse(const std::vector<BinaryNode> &binaryNodes, uint32_t binaryNodeIdx);
 
-    void insertObject(const std::shared_ptr<IAABB>& object);
-    void removeObject(const std::shared_ptr<IAABB>& object);
-    void updateObject(const std::shared_ptr<IAABB>& object);
-    std::forward_list<std::shared_ptr<IAABB>> queryOverlaps(const Frustum& frustum) const;
+    std::vector<AABBNode> m_nodes;
+    std::vector<const IAABB *> m_objects;
+    uint32_t m_rootNodeIndex = AABB_NULL_NODE;
 };
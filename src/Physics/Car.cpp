@@ -1,6 +1,7 @@
 #include "Car.h"
 
 #include "../Scene/Entity.h"
+#include "../Renderer/UploadManager.h"
 
 // Forward casts should extend further than L/R
 constexpr float kCastDistances[kNumRangefinders] = {
@@ -19,7 +20,7 @@ Car::Car(const CarData &carData, NFSVer nfsVersion, const std::string &carID) :
     name = carData.carName.empty() ? id : carData.carName;
 
     // Load in vehicle texture data to OpenGL
-    if (!Config::get().vulkanRender)
+    if (!Config::get().vulkanRender && !Config::get().headless)
     {
         this->_LoadTextures();
     }
@@ -49,9 +50,14 @@ Car::~Car()
     // And bullet collision shapes on heap
     m_collisionShapes.clear();
     // And the loaded GL textures
+    if (Config::get().vulkanRender || Config::get().headless)
+    {
+        return;
+    }
     if (renderInfo.isMultitexturedModel)
     {
         // TODO: Store number of textures so can pass correct parameter here
+        UploadManager::Get().CancelTextureUploads(renderInfo.textureArrayID);
         glDeleteTextures(1, &renderInfo.textureArrayID);
     }
     else
@@ -259,7 +265,11 @@ void Car::_LoadTextures()
     int width, height;
     carTexturePath << CAR_PATH << ToString(tag) << "/" << id;
 
-    if (tag == NFS_3 || tag == NFS_4)
+    if (!assetData.texture.empty())
+    {
+        renderInfo.textureID = ImageLoader::LoadImage(assetData.texture.data(), assetData.textureWidth, assetData.textureHeight, GL_CLAMP_TO_BORDER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+    else if (tag == NFS_3 || tag == NFS_4)
     {
         carTexturePath << "/car00.tga";
         renderInfo.textureID = ImageLoader::LoadImage(carTexturePath.str(), &width, &height, GL_CLAMP_TO_BORDER, GL_LINEAR_MIPMAP_LINEAR);
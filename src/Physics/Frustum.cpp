@@ -8,19 +8,16 @@ void Frustum::Update(const glm::mat4 &projectionViewMatrix)
 
 bool Frustum::CheckIntersection(const AABB &other) const
 {
-    // Loop through each frustum plane, checking box is outside of frustum for early rejection
+    glm::vec3 boxMin = other.position + other.min;
+    glm::vec3 boxMax = other.position + other.max;
+
+    // Loop through each frustum plane, checking box is outside of frustum for early rejection. Only the box corner furthest along the plane
+    // normal (the p-vertex) needs checking, if that's behind the plane all of the others are too.
     for (uint8_t planeIdx = 0; planeIdx < FrustumPlanes::Length; ++planeIdx)
     {
-        // Check each axis (x,y,z) to get the AABB vertex furthest away from the direction the plane is facing (plane normal)
-        float planeConstant = m_planes[planeIdx].w;
-        if (((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.min.x, other.min.y, other.min.z)) + planeConstant) < 0.f) &&
-            ((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.max.x, other.min.y, other.min.z)) + planeConstant) < 0.f) &&
-            ((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.min.x, other.max.y, other.min.z)) + planeConstant) < 0.f) &&
-            ((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.max.x, other.max.y, other.min.z)) + planeConstant) < 0.f) &&
-            ((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.min.x, other.min.y, other.max.z)) + planeConstant) < 0.f) &&
-            ((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.max.x, other.min.y, other.max.z)) + planeConstant) < 0.f) &&
-            ((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.min.x, other.max.y, other.max.z)) + planeConstant) < 0.f) &&
-            ((glm::dot(glm::vec3(m_planes[planeIdx]), other.position + glm::vec3(other.max.x, other.max.y, other.max.z)) + planeConstant) < 0.f))
+        const glm::vec4 &plane = m_planes[planeIdx];
+        glm::vec3 pVertex(plane.x >= 0.f ? boxMax.x : boxMin.x, plane.y >= 0.f ? boxMax.y : boxMin.y, plane.z >= 0.f ? boxMax.z : boxMin.z);
+        if (glm::dot(glm::vec3(plane), pVertex) + plane.w < 0.f)
         {
             return false;
         }
@@ -62,6 +59,11 @@ bool Frustum::CheckIntersection(const AABB &other) const
     return true;
 }
 
+const std::array<glm::vec4, FrustumPlanes::Length> &Frustum::GetPlanes() const
+{
+    return m_planes;
+}
+
 template <FrustumPlanes a, FrustumPlanes b, FrustumPlanes c>
 inline glm::vec3 Frustum::GetPlaneIntersection(const glm::vec3 *crosses) const
 {
@@ -23,6 +23,8 @@ public:
     Frustum() = default;
     void Update(const glm::mat4 &projectionViewMatrix);
     bool CheckIntersection(const AABB &other) const;
+    // Normalised, facing into the frustum
+    const std::array<glm::vec4, FrustumPlanes::Length> &GetPlanes() const;
     std::array<glm::vec3, 8> points;
 
 private:
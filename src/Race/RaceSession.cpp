@@ -2,6 +2,14 @@
 
 #include <imgui.h>
 
+#include "../Renderer/UploadManager.h"
+
+namespace
+{
+    // Upload budget of each frame for whatever the race didn't wait on, small enough to not cause a hitch
+    const size_t FRAME_UPLOAD_BYTES = 4 * 1024 * 1024;
+} // namespace
+
 RaceSession::RaceSession(const std::shared_ptr<GLFWwindow> &window,
                          const std::shared_ptr<Logger> &onfsLogger,
                          const std::vector<NfsAssetList> &installedNFS,
@@ -24,6 +32,11 @@ RaceSession::RaceSession(const std::shared_ptr<GLFWwindow> &window,
 
     // Set up the Racer Manager to spawn vehicles on track
     m_racerManager = RacerManager(m_playerAgent, m_track, m_physicsEngine);
+
+    // Only what can be seen from the start line (and the cars) is needed before the first frame, the rest streams in while racing
+    uint32_t startUploadPriority = m_track->PrioritiseUploads(m_track->trackBlocks[0].virtualRoadStartIndex);
+    UploadManager::Get().Flush(startUploadPriority);
+    LOG(INFO) << UploadManager::Get().GetPendingCount() << " uploads left to stream in";
 }
 
 void RaceSession::_UpdateCameras(float deltaTime)
@@ -86,6 +99,8 @@ AssetData RaceSession::Simulate()
         // Set the active camera dependent upon user input
         std::shared_ptr<BaseCamera> activeCamera = this->_GetActiveCamera();
 
+        UploadManager::Get().Pump(FRAME_UPLOAD_BYTES);
+
         if (m_userParams.simulateCars)
         {
             m_racerManager.Simulate();
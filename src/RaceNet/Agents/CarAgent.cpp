@@ -59,38 +59,12 @@ void CarAgent::ResetToVroad(int vroadIndex, float offset)
 
 void CarAgent::_UpdateNearestTrackblock()
 {
-    float lowestDistance = FLT_MAX;
-
-    // Get closest track block to car body position
-    for (auto &trackblock : m_track->trackBlocks)
-    {
-        float distance = glm::distance(vehicle->carBodyModel.position, trackblock.position);
-        if (distance < lowestDistance)
-        {
-            nearestTrackblockID = trackblock.id;
-            lowestDistance      = distance;
-        }
-    }
+    // Get closest track block to car body position, starting from the last one
+    nearestTrackblockID = m_track->spatialIndex.GetNearestTrackblockID(vehicle->carBodyModel.position, nearestTrackblockID);
 }
 
 void CarAgent::_UpdateNearestVroad()
 {
-    float lowestDistance     = FLT_MAX;
-    glm::quat rotationMatrix = glm::normalize(glm::quat(glm::vec3(-SIMD_PI / 2, 0, 0)));
-
-    // Use the nearest trackblock ID to avoid skipping the entire set of Vroad data
-    uint32_t nodeNumber = m_track->trackBlocks[nearestTrackblockID].virtualRoadStartIndex;
-    uint32_t nPositions = m_track->trackBlocks[nearestTrackblockID].nVirtualRoadPositions;
-
-    // Get closest vroad in trackblock set to car body position
-    for (uint32_t vroadIdx = nodeNumber; vroadIdx < nodeNumber + nPositions; ++vroadIdx)
-    {
-        float distance = glm::distance(vehicle->carBodyModel.position, m_track->virtualRoad[vroadIdx].position);
-
-        if (distance < lowestDistance)
-        {
-            m_nearestVroadID = vroadIdx;
-            lowestDistance   = distance;
-        }
-    }
+    // Get closest vroad to car body position, starting from the last one
+    m_nearestVroadID = m_track->spatialIndex.GetNearestVroadID(vehicle->carBodyModel.position, m_nearestVroadID);
 }
@@ -1,5 +1,7 @@
 #include "RaceNetRenderer.h"
 
+#include "UploadManager.h"
+
 RaceNetRenderer::RaceNetRenderer(const std::shared_ptr<GLFWwindow> &window, const std::shared_ptr<Logger> &onfs_logger) : m_window(window), logger(onfs_logger)
 {
     projectionMatrix = glm::ortho(minX, maxX, minY, maxY, -1.0f, 1.0f);
@@ -14,6 +16,8 @@ RaceNetRenderer::RaceNetRenderer(const std::shared_ptr<GLFWwindow> &window, cons
 void RaceNetRenderer::Render(uint32_t tick, std::vector<TrainingAgent> &carList, std::shared_ptr<Track> &trackToRender)
 {
     raceNetShader.HotReload(); // Racenet shader hot reload
+    // Training doesn't stream, the track and every new generation's cars are uploaded in full before they're drawn
+    UploadManager::Get().Flush();
     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
     glClearColor(0.f, 0.f, 0.f, 1.f);
     glfwPollEvents();
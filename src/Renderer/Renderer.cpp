@@ -1,5 +1,12 @@
 #include "Renderer.h"
 
+namespace
+{
+    // Fraction of an LOD distance a block has to be past it to drop a resolution, or inside it to go back up, so that blocks around the
+    // threshold don't pop back and forth
+    const float TRACK_LOD_HYSTERESIS = 0.1f;
+} // namespace
+
 Renderer::Renderer(const std::shared_ptr<GLFWwindow> &window,
                    const std::shared_ptr<Logger> &onfsLogger,
                    const std::vector<NfsAssetList> &installedNFS,
@@ -79,8 +86,9 @@ bool Renderer::Render(float totalTime,
     bool newAssetSelected = false;
 
     // Perform frustum culling to get visible entities, from perspective of active camera
-    VisibleSet visibleSet = _FrustumCull(m_track, activeCamera, userParams);
-    visibleSet.lights.insert(visibleSet.lights.begin(), activeLight);
+    _FrustumCull(m_track, activeCamera, userParams);
+    m_visibleSet.lights.insert(m_visibleSet.lights.begin(), activeLight);
+    m_track->geometryPool.PrepareDraws(m_visibleSet.entities, m_visibleSet.shadowEntities);
 
     if (userParams.drawHermiteFrustum)
     {
@@ -98,16 +106,16 @@ bool Renderer::Render(float totalTime,
     }
 
     // Render the environment
-    m_shadowMapRenderer.Render(userParams.nearPlane, userParams.farPlane, activeLight, m_track->textureArrayID, visibleSet.entities, racers);
+    m_shadowMapRenderer.Render(userParams.nearPlane, userParams.farPlane, activeLight, m_track->textureArrayID, m_track->geometryPool, racers);
     m_skyRenderer.Render(activeCamera, activeLight, totalTime);
-    m_trackRenderer.Render(racers, activeCamera, m_track->textureArrayID, visibleSet.entities, visibleSet.lights, userParams, m_shadowMapRenderer.m_depthTextureID, 0.5f);
-    m_trackRenderer.RenderLights(activeCamera, visibleSet.lights);
+    m_trackRenderer.Render(racers, activeCamera, m_track->textureArrayID, m_track->geometryPool, m_visibleSet.lights, userParams, m_shadowMapRenderer.m_depthTextureID, 0.5f);
+    m_trackRenderer.RenderLights(activeCamera, m_visibleSet.lights);
     m_debugRenderer.Render(activeCamera);
 
     // Render the Car and racers
     for (auto &racer : racers)
     {
-        m_carRenderer.Render(racer->vehicle, activeCamera, visibleSet.lights);
+        m_carRenderer.Render(racer->vehicle, activeCamera, m_visibleSet.lights);
     }
 
     if (this->_DrawMenuBar(loadedAssets))
@@ -126,94 +134,107 @@ bool Renderer::Render(float totalTime,
     return newAssetSelected;
 }
 
-VisibleSet Renderer::_FrustumCull(const std::shared_ptr<Track> &track, const std::shared_ptr<BaseCamera> &camera, ParamData &userParams)
+void Renderer::_FrustumCull(const std::shared_ptr<Track> &track, const std::shared_ptr<BaseCamera> &camera, ParamData &userParams)
 {
-    VisibleSet visibleSet;
+    m_visibleSet.entities.clear();
+    m_visibleSet.shadowEntities.clear();
+    m_visibleSet.lights.clear();
 
     // Only update the frustum of the camera when actually culling, to save some performance
     camera->UpdateFrustum();
 
-    // Perform frustum culling on the current camera, on local trackblocks
-    for (auto &trackBlockID : _GetLocalTrackBlockIDs(track, camera, userParams))
+    // Optionally restrict what's drawn to the trackblocks the NFS neighbour data says are visible from the closest one
+    if (userParams.useNbData)
+    {
+        m_closestTrackBlockID = track->spatialIndex.GetNearestTrackblockID(camera->position, m_closestTrackBlockID);
+    }
+    if (m_trackBlockLODs.size() != track->trackBlocks.size())
     {
-        for (auto &trackEntity : track->trackBlocks[trackBlockID].track)
+        m_trackBlockLODs.assign(track->trackBlocks.size(), HI_RES);
+    }
+    m_trackBlockRoadAdded.assign(track->trackBlocks.size(), 0);
+
+    // Perform frustum culling on the current camera, against the whole track's BvH
+    m_cullResults.clear();
+    track->cullTree.QueryOverlaps(camera->viewFrustum, m_cullResults);
+    for (auto &cullResult : m_cullResults)
+    {
+        // The tree is only built over entities
+        const Entity *visibleEntity = static_cast<const Entity *>(cullResult);
+        if (userParams.useNbData && !track->potentiallyVisibleSet.IsVisible(m_closestTrackBlockID, visibleEntity->parentTrackblockID))
         {
-            if (camera->viewFrustum.CheckIntersection(trackEntity.GetAABB()))
-            {
-                visibleSet.entities.emplace_back(std::make_shared<Entity>(trackEntity));
-            }
+            continue;
         }
-        for (auto &objectEntity : track->trackBlocks[trackBlockID].objects)
+        if (visibleEntity->type == EntityType::LIGHT)
         {
-            if (camera->viewFrustum.CheckIntersection(objectEntity.GetAABB()))
-            {
-                visibleSet.entities.emplace_back(std::make_shared<Entity>(objectEntity));
-            }
+            m_visibleSet.lights.emplace_back(boost::get<shared_ptr<BaseLight>>(visibleEntity->raw));
         }
-        for (auto &laneEntity : track->trackBlocks[trackBlockID].lanes)
+        else if ((visibleEntity->type == EntityType::ROAD || visibleEntity->type == EntityType::LANE) && visibleEntity->parentTrackblockID < track->trackBlocks.size())
         {
-            // It's not worth checking for Lane AABB intersections
-            visibleSet.entities.emplace_back(std::make_shared<Entity>(laneEntity));
+            // The full resolution road is what's in the tree, stand in the block's selected resolution for it
+            size_t trackBlockIdx                  = visibleEntity->parentTrackblockID;
+            const OpenNFS::TrackBlock &trackBlock = track->trackBlocks[trackBlockIdx];
+            TrackLOD lod                          = userParams.useTrackLODs ? _SelectTrackBlockLOD(trackBlockIdx, trackBlock, camera, userParams) : HI_RES;
+            _AddVisibleRoad(visibleEntity, trackBlockIdx, trackBlock, lod, MAIN_PASS);
+            _AddVisibleRoad(visibleEntity, trackBlockIdx, trackBlock, userParams.useTrackLODs ? trackBlock.GetLowestLOD() : HI_RES, SHADOW_PASS);
         }
-        for (auto &lightEntity : track->trackBlocks[trackBlockID].lights)
+        else
         {
-            if (camera->viewFrustum.CheckIntersection(lightEntity.GetAABB()))
-            {
-                visibleSet.lights.emplace_back(boost::get<shared_ptr<BaseLight>>(lightEntity.raw));
-            }
+            m_visibleSet.entities.emplace_back(visibleEntity);
+            m_visibleSet.shadowEntities.emplace_back(visibleEntity);
         }
     }
 
     // Global Objects are always visible
     for (auto &globalEntity : track->globalObjects)
     {
-        visibleSet.entities.emplace_back(std::make_shared<Entity>(globalEntity));
+        m_visibleSet.entities.emplace_back(&globalEntity);
+        m_visibleSet.shadowEntities.emplace_back(&globalEntity);
     }
-
-    // TODO: Fix the AABB tree
-    // auto aabbCollisions = track->cullTree.queryOverlaps(camera->viewFrustum);
-    // for(auto &collision : aabbCollisions)
-    //{
-    //    visibleEntities.emplace_back(std::static_pointer_cast<Entity>(collision));
-    //}
-
-    return visibleSet;
 }
 
-std::vector<uint32_t> Renderer::_GetLocalTrackBlockIDs(const std::shared_ptr<Track> &track, const std::shared_ptr<BaseCamera> &camera, ParamData &userParams)
+TrackLOD Renderer::_SelectTrackBlockLOD(size_t trackBlockIdx, const OpenNFS::TrackBlock &trackBlock, const std::shared_ptr<BaseCamera> &camera, const ParamData &userParams)
 {
-    std::vector<uint32_t> activeTrackBlockIds;
-    uint32_t closestBlockID = 0;
+    const float lodDistances[N_TRACK_LODS] = {0.f, userParams.trackMedResDistance, userParams.trackLoResDistance};
+    float distance                         = glm::distance(camera->position, trackBlock.position);
+
+    // Steps are settled within the first call each frame, so later calls for the same block agree with it
+    TrackLOD &lod = m_trackBlockLODs[trackBlockIdx];
+    while (lod + 1 < N_TRACK_LODS && distance > lodDistances[lod + 1] * (1.f + TRACK_LOD_HYSTERESIS))
+    {
+        lod = static_cast<TrackLOD>(lod + 1);
+    }
+    while (lod > HI_RES && distance < lodDistances[lod] * (1.f - TRACK_LOD_HYSTERESIS))
+    {
+        lod = static_cast<TrackLOD>(lod - 1);
+    }
 
-    float lowestDistance = FLT_MAX;
+    return lod;
+}
 
-    // Get closest track block to camera position
-    for (auto &trackblock : track->trackBlocks)
+void Renderer::_AddVisibleRoad(const Entity *roadEntity, size_t trackBlockIdx, const OpenNFS::TrackBlock &trackBlock, TrackLOD lod, TrackDrawPass pass)
+{
+    std::vector<const Entity *> &passEntities = pass == SHADOW_PASS ? m_visibleSet.shadowEntities : m_visibleSet.entities;
+    const std::vector<Entity> &lodTrack       = trackBlock.GetTrack(lod);
+    if (&lodTrack == &trackBlock.track)
     {
-        float distance = glm::distance(camera->position, trackblock.position);
-        if (distance < lowestDistance)
-        {
-            closestBlockID = trackblock.id;
-            lowestDistance = distance;
-        }
+        // At full resolution, road and lanes are culled individually as usual
+        passEntities.emplace_back(roadEntity);
+        return;
     }
 
-    if (userParams.useNbData)
+    // Lower resolutions replace all of the block's road, lanes included (they carry the full resolution road under them), whichever part of
+    // it was visible
+    uint8_t passBit = 1u << pass;
+    if (m_trackBlockRoadAdded[trackBlockIdx] & passBit)
     {
-        // Use the provided neighbour data to work out which blocks to render
-        activeTrackBlockIds = track->trackBlocks[closestBlockID].neighbourIds;
+        return;
     }
-    else
+    m_trackBlockRoadAdded[trackBlockIdx] |= passBit;
+    for (auto &lodEntity : lodTrack)
     {
-        // Use a draw distance value to return closestBlock +- drawDistance inclusive blocks
-        for (auto trackblockIdx = closestBlockID - userParams.blockDrawDistance; trackblockIdx < closestBlockID + userParams.blockDrawDistance; ++trackblockIdx)
-        {
-            uint32_t activeBlock = trackblockIdx < 0 ? ((uint32_t) track->trackBlocks.size() + trackblockIdx) : (trackblockIdx % (uint32_t) track->trackBlocks.size());
-            activeTrackBlockIds.emplace_back(activeBlock);
-        }
+        passEntities.emplace_back(&lodEntity);
     }
-
-    return activeTrackBlockIds;
 }
 
 void Renderer::_InitialiseIMGUI()
@@ -355,12 +376,15 @@ void Renderer::_DrawDebugUI(ParamData &userParams, const std::shared_ptr<BaseCam
     ImGui::SameLine(0, -1.0f);
     ImGui::NewLine();
     ImGui::SameLine(0, 0.0f);
-    if (!userParams.useNbData)
-    {
-        ImGui::SliderInt("Draw Dist", &userParams.blockDrawDistance, 0, m_track->nBlocks / 2);
-    }
     ImGui::Checkbox("NBData", &userParams.useNbData);
+    ImGui::SameLine(0, 0.0f);
+    ImGui::Checkbox("Track LODs", &userParams.useTrackLODs);
     ImGui::NewLine();
+    if (userParams.useTrackLODs)
+    {
+        ImGui::SliderFloat("Med Res Dist", &userParams.trackMedResDistance, 0, userParams.trackLoResDistance);
+        ImGui::SliderFloat("Lo Res Dist", &userParams.trackLoResDistance, userParams.trackMedResDistance, 1000);
+    }
     ImGui::ColorEdit3("Sun Atten", (float *) &userParams.sunAttenuation); // Edit 3 floats representing a color
     // ImGui::SliderFloat3("NFS2 Rot Dbg", (float *) &userParams.nfs2_rotate, -M_PI, M_PI);
 
@@ -27,9 +27,12 @@
 #include "DebugRenderer.h"
 #include "MenuRenderer.h"
 
+// What the active camera can see this frame. Entities point into the Track's own storage, which outlives the frame.
 struct VisibleSet
 {
-    std::vector<std::shared_ptr<Entity>> entities;
+    std::vector<const Entity *> entities;
+    // The same, but with the road always at its lowest resolution
+    std::vector<const Entity *> shadowEntities;
     std::vector<std::shared_ptr<BaseLight>> lights;
 };
 
@@ -69,13 +72,24 @@ private:
     void _InitialiseIMGUI();
     bool _DrawMenuBar(AssetData &loadedAssets);
     void _DrawDebugUI(ParamData &userParams, const std::shared_ptr<BaseCamera> &camera);
-    static std::vector<uint32_t> _GetLocalTrackBlockIDs(const shared_ptr<Track> &track, const std::shared_ptr<BaseCamera> &camera, ParamData &userParams);
-    static VisibleSet _FrustumCull(const std::shared_ptr<Track> &track, const std::shared_ptr<BaseCamera> &camera, ParamData &userParams);
+    void _FrustumCull(const std::shared_ptr<Track> &track, const std::shared_ptr<BaseCamera> &camera, ParamData &userParams);
+    // trackBlockIdx is the block's position in the track's trackBlocks, which the per block state is kept by
+    TrackLOD _SelectTrackBlockLOD(size_t trackBlockIdx, const OpenNFS::TrackBlock &trackBlock, const std::shared_ptr<BaseCamera> &camera, const ParamData &userParams);
+    void _AddVisibleRoad(const Entity *roadEntity, size_t trackBlockIdx, const OpenNFS::TrackBlock &trackBlock, TrackLOD lod, TrackDrawPass pass);
 
     std::shared_ptr<GLFWwindow> m_window;
     std::shared_ptr<Logger> m_logger;
     std::vector<NfsAssetList> m_nfsAssetList;
     std::shared_ptr<Track> m_track;
+    // Rebuilt every frame, kept to reuse their storage
+    VisibleSet m_visibleSet;
+    std::vector<const IAABB *> m_cullResults;
+    // Where the camera was last frame, to start the search for where it is now from
+    uint32_t m_closestTrackBlockID = 0;
+    // Resolution each trackblock's road was last drawn at, for hysteresis
+    std::vector<TrackLOD> m_trackBlockLODs;
+    // Per trackblock, bit per pass set once its lower resolution road has been added this frame
+    std::vector<uint8_t> m_trackBlockRoadAdded;
 
     TrackRenderer m_trackRenderer;
     CarRenderer m_carRenderer;
@@ -27,7 +27,7 @@ void ShadowMapRenderer::Render(float nearPlane,
                                float farPlane,
                                const std::shared_ptr<GlobalLight> &light,
                                GLuint trackTextureArrayID,
-                               const std::vector<std::shared_ptr<Entity>> &visibleEntities,
+                               const TrackGeometryPool &trackGeometry,
                                const std::vector<std::shared_ptr<CarAgent>> &racers)
 {
     /* ------- SHADOW MAPPING ------- */
@@ -40,11 +40,7 @@ void ShadowMapRenderer::Render(float nearPlane,
     glClear(GL_DEPTH_BUFFER_BIT);
 
     /* Render the track using this simple shader to get depth texture to test against during draw */
-    for (auto &entity : visibleEntities)
-    {
-        m_depthShader.loadTransformMatrix(boost::get<TrackModel>(entity->raw).ModelMatrix);
-        boost::get<TrackModel>(entity->raw).render();
-    }
+    trackGeometry.Draw(SHADOW_PASS);
 
     /* And the Cars */
     for (auto &racer : racers)
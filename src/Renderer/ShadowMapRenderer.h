@@ -16,7 +16,7 @@ public:
                 float farPlane,
                 const std::shared_ptr<GlobalLight> &light,
                 GLuint trackTextureArrayID,
-                const std::vector<std::shared_ptr<Entity>> &visibleEntities,
+                const TrackGeometryPool &trackGeometry,
                 const std::vector<std::shared_ptr<CarAgent>> &racers);
 
     GLuint m_depthTextureID = 0;
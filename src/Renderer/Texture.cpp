@@ -1,5 +1,303 @@
 #include "Texture.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+#include "../Util/BlockCompression.h"
+#include "../Util/MipChain.h"
+#include "../Util/ThreadPool.h"
+#include "UploadManager.h"
+
+namespace
+{
+    const GLsizei TEXTURE_ARRAY_MIP_LEVELS = 3;
+    // Transparent texels left right and below each packed texture, and the alignment of every texture within its layer, so that none of the
+    // mip levels blend neighbouring textures together
+    const uint32_t TEXTURE_ARRAY_GUTTER = 1u << (TEXTURE_ARRAY_MIP_LEVELS - 1);
+
+    // Bump whenever the compressed output for the same layers would change (encoder, mip filtering), so stale cached arrays get rebuilt
+    const uint32_t TEXTURE_CACHE_VERSION = 2;
+    const char TEXTURE_CACHE_MAGIC[4]    = {'O', 'T', 'E', 'X'};
+    // Alpha coverage is kept constant down the mip chain at this reference, where BC1 cuts texels out and the shadow pass discards them
+    const uint8_t MIP_ALPHA_REFERENCE = 128;
+
+    uint32_t AlignToGutter(uint32_t size)
+    {
+        return (size + TEXTURE_ARRAY_GUTTER - 1) & ~(TEXTURE_ARRAY_GUTTER - 1);
+    }
+
+    // Block compressed texture array, each mip level holding the blocks of every layer one after the other
+    struct CompressedTextureArray
+    {
+        BlockCompression::Format format;
+        uint32_t width, height, nLayers;
+        std::vector<std::vector<uint8_t>> levels;
+    };
+
+    struct CompressedTextureArrayHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t format, width, height, nLayers, nLevels;
+    };
+
+    uint32_t GetLevelDimension(uint32_t dimension, int level)
+    {
+        return std::max(dimension >> level, 1u);
+    }
+
+    // FNV-1a over the assembled RGBA8 layers, which is everything the compressed array (mips included) is derived from
+    uint64_t HashLayers(const std::vector<uint32_t> &layers)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t texel : layers)
+        {
+            hash = (hash ^ texel) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string GetTextureCachePath(uint64_t sourceHash)
+    {
+        std::stringstream cachePath;
+        cachePath << TEXTURE_CACHE_PATH << std::hex << std::setfill('0') << std::setw(16) << sourceHash << ".otex";
+        return cachePath.str();
+    }
+
+    bool LoadCompressedTextureArray(uint64_t sourceHash, CompressedTextureArray &array)
+    {
+        std::ifstream cacheFile(GetTextureCachePath(sourceHash), std::ios::in | std::ios::binary);
+        CompressedTextureArrayHeader header{};
+        if (!cacheFile.is_open() || !cacheFile.read(reinterpret_cast<char *>(&header), sizeof(header)) || memcmp(header.magic, TEXTURE_CACHE_MAGIC, 4) != 0 ||
+            header.version != TEXTURE_CACHE_VERSION || header.sourceHash != sourceHash || header.format >= BlockCompression::N_BLOCK_FORMATS ||
+            header.width != array.width || header.height != array.height || header.nLayers != array.nLayers || header.nLevels != TEXTURE_ARRAY_MIP_LEVELS)
+        {
+            return false;
+        }
+        array.format = static_cast<BlockCompression::Format>(header.format);
+        array.levels.resize(header.nLevels);
+        for (uint32_t level = 0; level < header.nLevels; ++level)
+        {
+            array.levels[level].resize(BlockCompression::GetCompressedSize(array.format, GetLevelDimension(array.width, level), GetLevelDimension(array.height, level)) *
+                                       array.nLayers);
+            if (!cacheFile.read(reinterpret_cast<char *>(array.levels[level].data()), array.levels[level].size()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void SaveCompressedTextureArray(uint64_t sourceHash, const CompressedTextureArray &array)
+    {
+        // Write alongside and move into place once complete, so a reader never finds a partly written cache
+        std::string cachePath = GetTextureCachePath(sourceHash);
+        std::string tempPath  = cachePath + ".tmp";
+        boost::filesystem::create_directories(TEXTURE_CACHE_PATH);
+        {
+            std::ofstream cacheFile(tempPath, std::ios::out | std::ios::binary);
+            if (!cacheFile.is_open())
+            {
+                LOG(WARNING) << "Unable to write compressed texture array to cache";
+                return;
+            }
+            CompressedTextureArrayHeader header{};
+            memcpy(header.magic, TEXTURE_CACHE_MAGIC, 4);
+            header.version    = TEXTURE_CACHE_VERSION;
+            header.sourceHash = sourceHash;
+            header.format     = array.format;
+            header.width      = array.width;
+            header.height     = array.height;
+            header.nLayers    = array.nLayers;
+            header.nLevels    = static_cast<uint32_t>(array.levels.size());
+            cacheFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            for (auto &level : array.levels)
+            {
+                cacheFile.write(reinterpret_cast<const char *>(level.data()), level.size());
+            }
+            if (!cacheFile.good())
+            {
+                LOG(WARNING) << "Failed to write compressed texture array to " << tempPath;
+                return;
+            }
+        }
+
+        boost::system::error_code renameError;
+        boost::filesystem::rename(tempPath, cachePath, renameError);
+        if (renameError)
+        {
+            LOG(WARNING) << "Failed to move compressed texture array into place at " << cachePath << ": " << renameError.message();
+        }
+    }
+
+    // Fills in mip levels 1 and down of every layer from each texture's own mip chain, built on the asset ThreadPool. Textures start on a gutter
+    // boundary, so their origin at each level is exact, and the gutters stay transparent all the way down.
+    void BuildMipLevels(const std::vector<Texture *> &textures, const std::vector<glm::uvec2> &origins, uint32_t width, uint32_t height,
+                        std::vector<std::vector<uint32_t>> &levelData)
+    {
+        size_t nLayers = levelData[0].size() / (width * height);
+        for (int level = 1; level < TEXTURE_ARRAY_MIP_LEVELS; ++level)
+        {
+            levelData[level].assign(GetLevelDimension(width, level) * GetLevelDimension(height, level) * nLayers, 0);
+        }
+        ThreadPool::Get().ParallelFor(textures.size(), [&](size_t textureIdx) {
+            const Texture &texture                   = *textures[textureIdx];
+            std::vector<std::vector<uint8_t>> levels = MipChain::Build(texture.data, texture.width, texture.height, TEXTURE_ARRAY_MIP_LEVELS, MIP_ALPHA_REFERENCE);
+            for (int level = 1; level <= static_cast<int>(levels.size()); ++level)
+            {
+                uint32_t levelWidth   = GetLevelDimension(width, level), levelHeight = GetLevelDimension(height, level);
+                uint32_t textureWidth = MipChain::GetLevelDimension(texture.width, level), textureHeight = MipChain::GetLevelDimension(texture.height, level);
+                glm::uvec2 origin(origins[textureIdx].x >> level, origins[textureIdx].y >> level);
+                uint32_t *layer = levelData[level].data() + static_cast<size_t>(texture.layer) * levelWidth * levelHeight;
+                for (uint32_t row = 0; row < textureHeight; ++row)
+                {
+                    memcpy(&layer[(origin.y + row) * levelWidth + origin.x], levels[level - 1].data() + row * textureWidth * sizeof(uint32_t), textureWidth * sizeof(uint32_t));
+                }
+            }
+        });
+    }
+
+    // Compresses every mip level of every layer across the asset ThreadPool. BC1 when all alpha at full size is either fully on or off, as alpha
+    // tested track textures are, otherwise BC3. The mips of alpha tested textures are cut out at the same reference their coverage was kept at.
+    void CompressLayers(const std::vector<std::vector<uint32_t>> &levelData, CompressedTextureArray &array)
+    {
+        array.format = BlockCompression::BC1;
+        for (uint32_t texel : levelData[0])
+        {
+            uint32_t alpha = texel >> 24;
+            if (alpha != 0 && alpha != 0xFF)
+            {
+                array.format = BlockCompression::BC3;
+                break;
+            }
+        }
+
+        array.levels.resize(TEXTURE_ARRAY_MIP_LEVELS);
+        for (int level = 0; level < TEXTURE_ARRAY_MIP_LEVELS; ++level)
+        {
+            array.levels[level].resize(BlockCompression::GetCompressedSize(array.format, GetLevelDimension(array.width, level), GetLevelDimension(array.height, level)) *
+                                       array.nLayers);
+        }
+        ThreadPool::Get().ParallelFor(array.nLayers, [&](size_t layerIdx) {
+            for (int level = 0; level < TEXTURE_ARRAY_MIP_LEVELS; ++level)
+            {
+                uint32_t levelWidth = GetLevelDimension(array.width, level), levelHeight = GetLevelDimension(array.height, level);
+                size_t layerSize    = array.levels[level].size() / array.nLayers;
+                BlockCompression::CompressImage(array.format,
+                                                reinterpret_cast<const uint8_t *>(levelData[level].data() + layerIdx * levelWidth * levelHeight),
+                                                levelWidth,
+                                                levelHeight,
+                                                array.levels[level].data() + layerIdx * layerSize);
+            }
+        });
+    }
+
+    // Submits every level of every layer to the UploadManager, each layer at its own priority. levels hold every layer of a level one after the
+    // other, and are kept alive by levelsOwner until they're all up.
+    template <typename Texel>
+    void SubmitLayerUploads(GLuint textureName,
+                            UploadTarget target,
+                            GLenum format,
+                            uint32_t width,
+                            uint32_t height,
+                            const std::shared_ptr<const void> &levelsOwner,
+                            const std::vector<std::vector<Texel>> &levels,
+                            const std::vector<UploadPriority> &layerPriorities)
+    {
+        for (int level = 0; level < TEXTURE_ARRAY_MIP_LEVELS; ++level)
+        {
+            size_t layerSize = levels[level].size() * sizeof(Texel) / layerPriorities.size();
+            for (uint32_t layer = 0; layer < layerPriorities.size(); ++layer)
+            {
+                UploadJob layerUpload;
+                layerUpload.target     = target;
+                layerUpload.name       = textureName;
+                layerUpload.level      = level;
+                layerUpload.firstLayer = static_cast<GLint>(layer);
+                layerUpload.width      = static_cast<GLsizei>(GetLevelDimension(width, level));
+                layerUpload.height     = static_cast<GLsizei>(GetLevelDimension(height, level));
+                layerUpload.format     = format;
+                layerUpload.data       = reinterpret_cast<const uint8_t *>(levels[level].data()) + layer * layerSize;
+                layerUpload.size       = layerSize;
+                layerUpload.dataOwner  = levelsOwner;
+                layerUpload.priority   = layerPriorities[layer];
+                UploadManager::Get().Submit(std::move(layerUpload));
+            }
+        }
+    }
+
+    // Swaps in the colour blocks of textures that were DXT packed to begin with, rather than their decoded and re-encoded texels. Only blocks that
+    // decode identically in the array's format are taken.
+    void PassThroughDxtBlocks(const std::vector<Texture *> &textures, const std::vector<glm::uvec2> &origins, CompressedTextureArray &array)
+    {
+        static_assert(TEXTURE_ARRAY_GUTTER % 4 == 0, "Packed textures must start on a block boundary for their blocks to be copied across");
+        size_t blockSize    = BlockCompression::GetBlockSize(array.format);
+        size_t colourOffset = blockSize - 8;
+        uint32_t nBlocksX   = array.width / 4;
+        size_t layerSize    = array.levels[0].size() / array.nLayers;
+        for (size_t textureIdx = 0; textureIdx < textures.size(); ++textureIdx)
+        {
+            const Texture &texture = *textures[textureIdx];
+            if (!texture.dxtColourBlocks)
+            {
+                continue;
+            }
+            for (uint32_t blockY = 0; blockY < texture.height / 4; ++blockY)
+            {
+                for (uint32_t blockX = 0; blockX < texture.width / 4; ++blockX)
+                {
+                    const uint8_t *colourBlock = texture.dxtColourBlocks->data() + (blockY * (texture.width / 4) + blockX) * 8;
+                    bool opaque                = true;
+                    for (uint32_t texelIdx = 0; texelIdx < 16; ++texelIdx)
+                    {
+                        opaque &= texture.data[((blockY * 4 + texelIdx / 4) * texture.width + blockX * 4 + texelIdx % 4) * 4 + 3] == 0xFF;
+                    }
+                    if (!BlockCompression::IsFourColourBlock(colourBlock) || (array.format == BlockCompression::BC1 && !opaque))
+                    {
+                        continue;
+                    }
+                    uint32_t layerBlockIdx = (origins[textureIdx].y / 4 + blockY) * nBlocksX + origins[textureIdx].x / 4 + blockX;
+                    memcpy(array.levels[0].data() + texture.layer * layerSize + layerBlockIdx * blockSize + colourOffset, colourBlock, 8);
+                }
+            }
+        }
+    }
+
+    // Decodes the last block seen for each texture ID (repeats used to simply overwrite earlier entries in the texture map) on the asset
+    // ThreadPool. Only the CPU side happens here, the GL upload is left to MakeTextureArray on the GL thread.
+    template <typename TextureBlock>
+    std::map<uint32_t, Texture> DecodeTextureSet(const std::vector<TextureBlock> &textureBlocks,
+                                                 const std::function<uint32_t(const TextureBlock &)> &getTextureId,
+                                                 const std::function<Texture(const TextureBlock &)> &decodeTexture)
+    {
+        std::map<uint32_t, size_t> lastBlockIndices;
+        for (size_t blockIdx = 0; blockIdx < textureBlocks.size(); ++blockIdx)
+        {
+            lastBlockIndices[getTextureId(textureBlocks[blockIdx])] = blockIdx;
+        }
+
+        std::vector<std::pair<uint32_t, size_t>> uniqueBlocks(lastBlockIndices.begin(), lastBlockIndices.end());
+        std::vector<Texture> decodedTextures(uniqueBlocks.size());
+        ThreadPool::Get().ParallelFor(uniqueBlocks.size(),
+                                      [&](size_t textureIdx) { decodedTextures[textureIdx] = decodeTexture(textureBlocks[uniqueBlocks[textureIdx].second]); });
+
+        std::map<uint32_t, Texture> textures;
+        for (size_t textureIdx = 0; textureIdx < uniqueBlocks.size(); ++textureIdx)
+        {
+            textures.emplace_hint(textures.end(), uniqueBlocks[textureIdx].first, std::move(decodedTextures[textureIdx]));
+        }
+
+        return textures;
+    }
+} // namespace
+
 Texture::Texture(NFSVer tag, uint32_t id, GLubyte *data, uint32_t width, uint32_t height, RawTextureInfo rawTextureInfo)
 {
     this->tag            = tag;
@@ -24,38 +322,6 @@ Texture Texture::LoadTexture(NFSVer tag, RawTextureInfo rawTrackTexture, const s
 
     switch (tag)
     {
-    case NFS_3:
-    {
-        LibOpenNFS::NFS3::TexBlock trackTexture = boost::get<LibOpenNFS::NFS3::TexBlock>(rawTrackTexture);
-        width                                   = trackTexture.width;
-        height                                  = trackTexture.height;
-
-        std::stringstream filename_alpha;
-
-        if (trackTexture.isLane)
-        {
-            filename << "../resources/sfx/" << std::setfill('0') << std::setw(4) << trackTexture.qfsIndex + 9 << ".BMP";
-            filename_alpha << "../resources/sfx/" << std::setfill('0') << std::setw(4) << trackTexture.qfsIndex + 9 << "-a.BMP";
-        }
-        else
-        {
-            filename << TRACK_PATH << ToString(NFS_3) << "/" << trackName << "/textures/" << std::setfill('0') << std::setw(4) << trackTexture.qfsIndex << ".BMP";
-            filename_alpha << TRACK_PATH << ToString(NFS_3) << "/" << trackName << "/textures/" << std::setfill('0') << std::setw(4) << trackTexture.qfsIndex << "-a.BMP";
-        }
-
-        if (!ImageLoader::LoadBmpWithAlpha(filename.str().c_str(), filename_alpha.str().c_str(), &data, &width, &height))
-        {
-            LOG(WARNING) << "Texture " << filename.str() << " or " << filename_alpha.str() << " did not load succesfully!";
-            // If the texture is missing, load a "MISSING" texture of identical size.
-            ASSERT(ImageLoader::LoadBmpWithAlpha("../resources/misc/missing.bmp", "../resources/misc/missing-a.bmp", &data, &width, &height),
-                   "Even the 'missing' texture is missing!");
-            return Texture(tag, (unsigned int) trackTexture.qfsIndex, data, static_cast<unsigned int>(width), static_cast<unsigned int>(height), rawTrackTexture);
-        }
-
-        return Texture(
-          tag, static_cast<uint32_t>(trackTexture.qfsIndex), data, static_cast<uint32_t>(trackTexture.width), static_cast<uint32_t>(trackTexture.height), rawTrackTexture);
-    }
-    break;
     case NFS_2:
     case NFS_2_SE:
     case NFS_2_PS1:
@@ -90,10 +356,65 @@ Texture Texture::LoadTexture(NFSVer tag, RawTextureInfo rawTrackTexture, const s
     return Texture(UNKNOWN, 0, nullptr, 0, 0, rawTrackTexture);
 }
 
+Texture Texture::LoadTexture(const LibOpenNFS::NFS3::TexBlock &trackTexture, const QfsArchive &trackTextures)
+{
+    std::stringstream filename;
+    GLubyte *data;
+    GLsizei width;
+    GLsizei height;
+
+    if (trackTexture.isLane)
+    {
+        // Lane textures come from the shared SFX pack rather than the track QFS
+        std::stringstream filename_alpha;
+        filename << "../resources/sfx/" << std::setfill('0') << std::setw(4) << trackTexture.qfsIndex + 9 << ".BMP";
+        filename_alpha << "../resources/sfx/" << std::setfill('0') << std::setw(4) << trackTexture.qfsIndex + 9 << "-a.BMP";
+        if (ImageLoader::LoadBmpWithAlpha(filename.str().c_str(), filename_alpha.str().c_str(), &data, &width, &height))
+        {
+            return Texture(NFS_3, trackTexture.qfsIndex, data, static_cast<uint32_t>(width), static_cast<uint32_t>(height), trackTexture);
+        }
+    }
+    else
+    {
+        filename << "QFS entry " << trackTexture.qfsIndex;
+        if (trackTextures.DecodeEntry(trackTexture.qfsIndex, &data, &width, &height))
+        {
+            // Sized as decoded, which needn't match the TexBlock, so that data's stride is right. The DXT blocks are the same entry's, laid out alike.
+            Texture texture(NFS_3, trackTexture.qfsIndex, data, static_cast<uint32_t>(width), static_cast<uint32_t>(height), trackTexture);
+            std::vector<uint8_t> dxtColourBlocks;
+            if (trackTextures.GetEntryDxtColourBlocks(trackTexture.qfsIndex, dxtColourBlocks))
+            {
+                texture.dxtColourBlocks = std::make_shared<const std::vector<uint8_t>>(std::move(dxtColourBlocks));
+            }
+            return texture;
+        }
+    }
+
+    LOG(WARNING) << "Texture " << filename.str() << " did not load succesfully!";
+    // If the texture is missing, load a "MISSING" texture of identical size.
+    ASSERT(ImageLoader::LoadBmpWithAlpha("../resources/misc/missing.bmp", "../resources/misc/missing-a.bmp", &data, &width, &height), "Even the 'missing' texture is missing!");
+    return Texture(NFS_3, trackTexture.qfsIndex, data, static_cast<uint32_t>(width), static_cast<uint32_t>(height), trackTexture);
+}
+
+std::map<uint32_t, Texture> Texture::LoadTextures(NFSVer tag, const std::vector<LibOpenNFS::NFS2::TEXTURE_BLOCK> &trackTextureBlocks, const std::string &trackName)
+{
+    return DecodeTextureSet<LibOpenNFS::NFS2::TEXTURE_BLOCK>(
+      trackTextureBlocks,
+      [](const LibOpenNFS::NFS2::TEXTURE_BLOCK &trackTexture) { return static_cast<uint32_t>(trackTexture.texNumber); },
+      [tag, &trackName](const LibOpenNFS::NFS2::TEXTURE_BLOCK &trackTexture) { return LoadTexture(tag, trackTexture, trackName); });
+}
+
+std::map<uint32_t, Texture> Texture::LoadTextures(const std::vector<LibOpenNFS::NFS3::TexBlock> &trackTextureBlocks, const QfsArchive &trackTextures)
+{
+    return DecodeTextureSet<LibOpenNFS::NFS3::TexBlock>(
+      trackTextureBlocks,
+      [](const LibOpenNFS::NFS3::TexBlock &trackTexture) { return static_cast<uint32_t>(trackTexture.qfsIndex); },
+      [&trackTextures](const LibOpenNFS::NFS3::TexBlock &trackTexture) { return LoadTexture(trackTexture, trackTextures); });
+}
+
 bool Texture::ExtractTrackTextures(const std::string &trackPath, const ::std::string trackName, NFSVer nfsVer)
 {
     std::stringstream nfsTexArchivePath;
-    std::string fullTrackPath = trackPath + "/" + trackName;
     std::string onfsTrackAssetDir =  TRACK_PATH + ToString(nfsVer) + "/" + trackName;
 
     if (boost::filesystem::exists(onfsTrackAssetDir))
@@ -116,9 +437,6 @@ bool Texture::ExtractTrackTextures(const std::string &trackPath, const ::std::st
     case NFS_2_PS1:
         nfsTexArchivePath << trackPath << "0.psh";
         break;
-    case NFS_3:
-        nfsTexArchivePath << fullTrackPath << "0.qfs";
-        break;
     case NFS_3_PS1:
     {
         std::string pshPath = trackPath;
@@ -143,17 +461,6 @@ bool Texture::ExtractTrackTextures(const std::string &trackPath, const ::std::st
     case NFS_2_PS1:
     case NFS_3_PS1:
         return ImageLoader::ExtractPSH(nfsTexArchivePath.str(), onfsTrackAssetTextureDir);
-    case NFS_3:
-    {
-        std::stringstream nfsSkyTexArchivePath;
-        nfsSkyTexArchivePath << fullTrackPath.substr(0, fullTrackPath.find_last_of('/')) << "/sky.fsh";
-        if (boost::filesystem::exists(nfsSkyTexArchivePath.str()))
-        {
-            std::string onfsTrackAssetSkyTexDir = onfsTrackAssetDir + "/sky_textures/";
-            ASSERT(ImageLoader::ExtractQFS(nfsSkyTexArchivePath.str(), onfsTrackAssetSkyTexDir), "Unable to extract sky textures from " << nfsSkyTexArchivePath.str());
-        }
-    }
-    break;
     default:
         break;
     }
@@ -218,8 +525,7 @@ std::vector<glm::vec2> Texture::GenerateUVs(EntityType meshType, uint32_t textur
                 {
                     uv.y = 1.0f - uv.y;
                 }
-                uv.x *= maxU;
-                uv.y *= maxV;
+                uv = LayerUV(uv);
             }
         }
         break;
@@ -249,8 +555,7 @@ std::vector<glm::vec2> Texture::GenerateUVs(EntityType meshType, uint32_t textur
                 {
                     uv.y = 1.0f - uv.y;
                 }
-                uv.x *= this->maxU;
-                uv.y *= this->maxV;
+                uv = LayerUV(uv);
             }
         }
         break;
@@ -306,43 +611,15 @@ std::vector<glm::vec2> Texture::GenerateUVs(EntityType meshType, uint32_t textur
                 {
                     uv.y = 1.0f - uv.y;
                 }
-                uv.x *= maxU;
-                uv.y *= maxV;
+                uv = LayerUV(uv);
             }
         }
         break;
         }
         break;*/
     case NFS_3:
-    {
-        LibOpenNFS::NFS3::TexBlock texBlock = boost::get<LibOpenNFS::NFS3::TexBlock>(rawTrackTexture);
-        switch (meshType)
-        {
-        case XOBJ:
-            uvs.emplace_back((1.0f - texBlock.corners[0]) * maxU, (1.0f - texBlock.corners[1]) * maxV);
-            uvs.emplace_back((1.0f - texBlock.corners[2]) * maxU, (1.0f - texBlock.corners[3]) * maxV);
-            uvs.emplace_back((1.0f - texBlock.corners[4]) * maxU, (1.0f - texBlock.corners[5]) * maxV);
-            uvs.emplace_back((1.0f - texBlock.corners[0]) * maxU, (1.0f - texBlock.corners[1]) * maxV);
-            uvs.emplace_back((1.0f - texBlock.corners[4]) * maxU, (1.0f - texBlock.corners[5]) * maxV);
-            uvs.emplace_back((1.0f - texBlock.corners[6]) * maxU, (1.0f - texBlock.corners[7]) * maxV);
-            break;
-        case OBJ_POLY:
-        case LANE:
-        case ROAD:
-            uvs.emplace_back(texBlock.corners[0] * maxU, (1.0f - texBlock.corners[1]) * maxV);
-            uvs.emplace_back(texBlock.corners[2] * maxU, (1.0f - texBlock.corners[3]) * maxV);
-            uvs.emplace_back(texBlock.corners[4] * maxU, (1.0f - texBlock.corners[5]) * maxV);
-            uvs.emplace_back(texBlock.corners[0] * maxU, (1.0f - texBlock.corners[1]) * maxV);
-            uvs.emplace_back(texBlock.corners[4] * maxU, (1.0f - texBlock.corners[5]) * maxV);
-            uvs.emplace_back(texBlock.corners[6] * maxU, (1.0f - texBlock.corners[7]) * maxV);
-            break;
-        case GLOBAL:
-            break;
-        case CAR:
-            break;
-        }
-    }
-    break;
+        GenerateUVs(meshType, boost::get<LibOpenNFS::NFS3::TexBlock>(rawTrackTexture), uvs);
+        break;
     case NFS_4:
     {
         // TODO: Needs to be an NFS4 texblock after NFS4 new gen parser bringup
@@ -389,8 +666,7 @@ std::vector<glm::vec2> Texture::GenerateUVs(EntityType meshType, uint32_t textur
                 {
                     uv.y = 1.0f - uv.y;
                 }
-                uv.x *= maxU;
-                uv.y *= maxV;
+                uv = LayerUV(uv);
             }
         }
         break;
@@ -421,8 +697,7 @@ std::vector<glm::vec2> Texture::GenerateUVs(EntityType meshType, uint32_t textur
                 {
                     uv.y = 1.0f - uv.y;
                 }
-                uv.x *= maxU;
-                uv.y *= maxV;
+                uv = LayerUV(uv);
             }
         }
         break;
@@ -440,16 +715,43 @@ std::vector<glm::vec2> Texture::GenerateUVs(EntityType meshType, uint32_t textur
     return uvs;
 }
 
-GLuint Texture::MakeTextureArray(std::map<uint32_t, Texture> &textures, bool repeatable)
+glm::vec2 Texture::LayerUV(glm::vec2 uv) const
+{
+    return glm::vec2(minU + uv.x * (maxU - minU), minV + uv.y * (maxV - minV));
+}
+
+void Texture::GenerateUVs(EntityType meshType, const LibOpenNFS::NFS3::TexBlock &texBlock, std::vector<glm::vec2> &uvs) const
 {
-    ASSERT(textures.size() < MAX_TEXTURE_ARRAY_SIZE, "Configured maximum texture array size of " << MAX_TEXTURE_ARRAY_SIZE << " has been exceeded");
+    switch (meshType)
+    {
+    case XOBJ:
+        uvs.emplace_back(LayerUV(glm::vec2(1.0f - texBlock.corners[0], 1.0f - texBlock.corners[1])));
+        uvs.emplace_back(LayerUV(glm::vec2(1.0f - texBlock.corners[2], 1.0f - texBlock.corners[3])));
+        uvs.emplace_back(LayerUV(glm::vec2(1.0f - texBlock.corners[4], 1.0f - texBlock.corners[5])));
+        uvs.emplace_back(LayerUV(glm::vec2(1.0f - texBlock.corners[0], 1.0f - texBlock.corners[1])));
+        uvs.emplace_back(LayerUV(glm::vec2(1.0f - texBlock.corners[4], 1.0f - texBlock.corners[5])));
+        uvs.emplace_back(LayerUV(glm::vec2(1.0f - texBlock.corners[6], 1.0f - texBlock.corners[7])));
+        break;
+    case OBJ_POLY:
+    case LANE:
+    case ROAD:
+        uvs.emplace_back(LayerUV(glm::vec2(texBlock.corners[0], 1.0f - texBlock.corners[1])));
+        uvs.emplace_back(LayerUV(glm::vec2(texBlock.corners[2], 1.0f - texBlock.corners[3])));
+        uvs.emplace_back(LayerUV(glm::vec2(texBlock.corners[4], 1.0f - texBlock.corners[5])));
+        uvs.emplace_back(LayerUV(glm::vec2(texBlock.corners[0], 1.0f - texBlock.corners[1])));
+        uvs.emplace_back(LayerUV(glm::vec2(texBlock.corners[4], 1.0f - texBlock.corners[5])));
+        uvs.emplace_back(LayerUV(glm::vec2(texBlock.corners[6], 1.0f - texBlock.corners[7])));
+        break;
+    default:
+        break;
+    }
+}
 
+GLuint Texture::MakeTextureArray(std::map<uint32_t, Texture> &textures)
+{
     size_t max_width = 0, max_height = 0;
     GLuint texture_name;
 
-    glGenTextures(1, &texture_name);
-    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_name);
-
     // Find the maximum width and height, so we can avoid overestimating with blanket values (256x256) and thereby scale UV's uneccesarily
     for (auto &texture : textures)
     {
@@ -459,67 +761,145 @@ GLuint Texture::MakeTextureArray(std::map<uint32_t, Texture> &textures, bool rep
             max_height = texture.second.height;
     }
 
-    std::vector<uint32_t> clear_data(max_width * max_height, 0);
+    // Layers are sized to the largest texture, and as many smaller textures as fit are packed into each one alongside each other, rather than a
+    // handful of large sky or billboard textures forcing every small track texture into a layer of its own that size. Textures that wouldn't
+    // leave room for a gutter take up the full width or height of the layer, where clamping to the edge does the same job.
+    uint32_t layer_width  = AlignToGutter(static_cast<uint32_t>(max_width));
+    uint32_t layer_height = AlignToGutter(static_cast<uint32_t>(max_height));
+    std::vector<Texture *> packed_textures;
+    std::vector<glm::uvec2> packed_origins(textures.size());
+    std::vector<stbrp_rect> unpacked_rects;
+    for (auto &texture : textures)
+    {
+        stbrp_rect rect{};
+        rect.id = static_cast<int>(packed_textures.size());
+        rect.w  = static_cast<stbrp_coord>(std::min(AlignToGutter(texture.second.width + TEXTURE_ARRAY_GUTTER), layer_width));
+        rect.h  = static_cast<stbrp_coord>(std::min(AlignToGutter(texture.second.height + TEXTURE_ARRAY_GUTTER), layer_height));
+        packed_textures.push_back(&texture.second);
+        unpacked_rects.push_back(rect);
+    }
+    std::vector<stbrp_node> pack_nodes(layer_width);
+    std::vector<stbrp_rect> leftover_rects;
+    uint32_t nLayers = 0;
+    while (!unpacked_rects.empty())
+    {
+        stbrp_context pack_context;
+        stbrp_init_target(&pack_context, static_cast<int>(layer_width), static_cast<int>(layer_height), pack_nodes.data(), static_cast<int>(pack_nodes.size()));
+        stbrp_pack_rects(&pack_context, unpacked_rects.data(), static_cast<int>(unpacked_rects.size()));
 
-    LOG(INFO) << "Creating texture array with " << (int) textures.size() << " textures, max texture width " << max_width << ", max texture height " << max_height;
-    glTexStorage3D(GL_TEXTURE_2D_ARRAY,
-                   3,
-                   GL_RGBA8,
-                   static_cast<GLsizei>(max_width),
-                   static_cast<GLsizei>(max_height),
-                   MAX_TEXTURE_ARRAY_SIZE); // I should really call this on textures.size(), but the layer numbers are not linear up to
-                                            // textures.size(). HS Bloats tex index up over 2048.
+        leftover_rects.clear();
+        for (auto &rect : unpacked_rects)
+        {
+            if (!rect.was_packed)
+            {
+                leftover_rects.push_back(rect);
+                continue;
+            }
+            // Inset by half a texel, so that no filtering reaches outside of the texture
+            Texture &texture        = *packed_textures[rect.id];
+            packed_origins[rect.id] = glm::uvec2(rect.x, rect.y);
+            texture.layer           = nLayers;
+            texture.minU            = (rect.x + 0.5f) / layer_width;
+            texture.minV            = (rect.y + 0.5f) / layer_height;
+            texture.maxU            = (rect.x + texture.width - 0.5f) / layer_width;
+            texture.maxV            = (rect.y + texture.height - 0.5f) / layer_height;
+        }
+        // Every texture fits in an empty layer, so each pass packs at least one
+        ASSERT(leftover_rects.size() < unpacked_rects.size(), "Texture packing made no progress");
+        unpacked_rects.swap(leftover_rects);
+        ++nLayers;
+    }
+    ASSERT(nLayers < MAX_TEXTURE_ARRAY_SIZE, "Configured maximum texture array size of " << MAX_TEXTURE_ARRAY_SIZE << " has been exceeded");
 
-    for (auto &texture : textures)
+    if (textures.empty())
     {
-        ASSERT(texture.second.width <= max_width, "Texture " << texture.second.id << " exceeds maximum specified texture size (" << max_width << ") for Array");
-        ASSERT(texture.second.height <= max_height, "Texture " << texture.second.id << " exceeds maximum specified texture size (" << max_height << ") for Array");
-        // Set the whole texture to transparent (so min/mag filters don't find bad data off the edge of the actual image data)
-        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
-                        0,
-                        0,
-                        0,
-                        hsStockTextureIndexRemap(texture.first),
-                        static_cast<GLsizei>(max_width),
-                        static_cast<GLsizei>(max_height),
-                        1,
-                        GL_RGBA,
-                        GL_UNSIGNED_BYTE,
-                        &clear_data[0]);
-        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
-                        0,
-                        0,
-                        0,
-                        hsStockTextureIndexRemap(texture.first),
-                        texture.second.width,
-                        texture.second.height,
-                        1,
-                        GL_RGBA,
-                        GL_UNSIGNED_BYTE,
-                        (const GLvoid *) texture.second.data);
-
-        texture.second.minU  = 0.00;
-        texture.second.minV  = 0.00;
-        texture.second.layer = hsStockTextureIndexRemap(texture.first);
-        texture.second.maxU  = (texture.second.width / static_cast<float>(max_width)) - 0.005f; // Attempt to remove potential for sampling texture from transparent area
-        texture.second.maxV  = (texture.second.height / static_cast<float>(max_height)) - 0.005f;
-        texture.second.id    = texture_name;
-    }
-
-    if (repeatable)
-    {
-        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        return 0;
+    }
+
+    // Layers are assembled on the CPU, transparent around the textures (so min/mag filters don't find bad data off the edge of the actual image
+    // data), and uploaded a layer at a time along with their full mip chains. Each level holds every layer one after the other.
+    std::vector<std::vector<uint32_t>> level_data(TEXTURE_ARRAY_MIP_LEVELS);
+    level_data[0].assign(static_cast<size_t>(layer_width) * layer_height * nLayers, 0);
+    for (size_t textureIdx = 0; textureIdx < packed_textures.size(); ++textureIdx)
+    {
+        Texture &texture  = *packed_textures[textureIdx];
+        glm::uvec2 origin = packed_origins[textureIdx];
+        uint32_t *layer   = level_data[0].data() + static_cast<size_t>(texture.layer) * layer_width * layer_height;
+        for (uint32_t row = 0; row < texture.height; ++row)
+        {
+            memcpy(&layer[(origin.y + row) * layer_width + origin.x], texture.data + row * texture.width * sizeof(uint32_t), texture.width * sizeof(uint32_t));
+        }
+    }
+
+    // Headless conversion has no GL context to upload to, but still needs the layers and UV regions the meshes are built against, and bakes the
+    // compressed texture cache for whatever renders the asset later
+    bool headless   = Config::get().headless;
+    bool compressed = !Config::get().uncompressedTextures && (headless || GLEW_EXT_texture_compression_s3tc);
+    std::vector<UploadPriority> layer_priorities(nLayers);
+    if (headless)
+    {
+        for (auto &texture : textures)
+        {
+            texture.second.id = 0;
+        }
+    }
+    else
+    {
+        // Each layer goes up as its own upload, as soon as the UploadManager is next pumped unless whatever the textures are for gives the
+        // layers other priorities
+        for (auto &layer_priority : layer_priorities)
+        {
+            layer_priority = UploadManager::MakePriority(0);
+        }
+        glGenTextures(1, &texture_name);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture_name);
+        for (auto &texture : textures)
+        {
+            texture.second.id             = texture_name;
+            texture.second.uploadPriority = layer_priorities[texture.second.layer];
+        }
+    }
+
+    LOG(INFO) << "Packed " << textures.size() << " textures into a texture array of " << nLayers << " " << layer_width << "x" << layer_height << " layers";
+    if (compressed)
+    {
+        // Mips and compression are the slow part, so compressed arrays are cached against the layers they were built from
+        auto compressed_array = std::make_shared<CompressedTextureArray>(CompressedTextureArray{BlockCompression::BC1, layer_width, layer_height, nLayers, {}});
+        uint64_t source_hash  = HashLayers(level_data[0]);
+        if (!LoadCompressedTextureArray(source_hash, *compressed_array))
+        {
+            BuildMipLevels(packed_textures, packed_origins, layer_width, layer_height, level_data);
+            CompressLayers(level_data, *compressed_array);
+            PassThroughDxtBlocks(packed_textures, packed_origins, *compressed_array);
+            SaveCompressedTextureArray(source_hash, *compressed_array);
+        }
+        if (headless)
+        {
+            return 0;
+        }
+        GLenum compressed_format = compressed_array->format == BlockCompression::BC1 ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, TEXTURE_ARRAY_MIP_LEVELS, compressed_format, static_cast<GLsizei>(layer_width), static_cast<GLsizei>(layer_height), static_cast<GLsizei>(nLayers));
+        SubmitLayerUploads(texture_name, COMPRESSED_TEXTURE_UPLOAD, compressed_format, layer_width, layer_height, compressed_array, compressed_array->levels, layer_priorities);
     }
     else
     {
-        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // Nothing is cached uncompressed
+        if (headless)
+        {
+            return 0;
+        }
+        BuildMipLevels(packed_textures, packed_origins, layer_width, layer_height, level_data);
+        auto uploaded_levels = std::make_shared<std::vector<std::vector<uint32_t>>>(std::move(level_data));
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, TEXTURE_ARRAY_MIP_LEVELS, GL_RGBA8, static_cast<GLsizei>(layer_width), static_cast<GLsizei>(layer_height), static_cast<GLsizei>(nLayers));
+        SubmitLayerUploads(texture_name, TEXTURE_UPLOAD, GL_RGBA, layer_width, layer_height, uploaded_levels, *uploaded_levels, layer_priorities);
     }
 
+    // Layers are atlases, wrapping would sample the neighbouring textures
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
 
     // Unbind texture
     glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
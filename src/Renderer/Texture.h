@@ -1,6 +1,7 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <memory>
 #include <string>
 #include <set>
 #include <sstream>
@@ -13,6 +14,8 @@
 #include "../Loaders/NFS3/FRD/TexBlock.h"
 #include "../Util/Utils.h"
 #include "../Util/ImageLoader.h"
+#include "../Util/QfsArchive.h"
+#include "UploadManager.h"
 
 // TODO: Refactor this pattern out entirely, should pass everything the texture needs as ONFS intermediate
 typedef boost::variant<LibOpenNFS::NFS3::TexBlock, LibOpenNFS::NFS2::TEXTURE_BLOCK> RawTextureInfo;
@@ -23,16 +26,30 @@ public:
     Texture() = default;
     explicit Texture(NFSVer tag, uint32_t id, GLubyte *data, uint32_t width, uint32_t height, RawTextureInfo rawTextureInfo);
     std::vector<glm::vec2> GenerateUVs(EntityType meshType, uint32_t textureFlags, RawTextureInfo rawTrackTexture);
+    // Appends the 6 UVs of an NFS3 textured quad's two triangles straight onto uvs, for the loaders' per polygon hot loop
+    void GenerateUVs(EntityType meshType, const LibOpenNFS::NFS3::TexBlock &texBlock, std::vector<glm::vec2> &uvs) const;
+    // Maps a UV across the texture itself onto the region of its array layer it was packed into
+    glm::vec2 LayerUV(glm::vec2 uv) const;
 
     // Utils
     static Texture LoadTexture(NFSVer tag, RawTextureInfo rawTrackTexture, const std::string &trackName);
+    static Texture LoadTexture(const LibOpenNFS::NFS3::TexBlock &trackTexture, const QfsArchive &trackTextures);
+    // Decode a whole track's texture set in parallel, keyed by texture ID and ready for MakeTextureArray
+    static std::map<uint32_t, Texture> LoadTextures(NFSVer tag, const std::vector<LibOpenNFS::NFS2::TEXTURE_BLOCK> &trackTextureBlocks, const std::string &trackName);
+    static std::map<uint32_t, Texture> LoadTextures(const std::vector<LibOpenNFS::NFS3::TexBlock> &trackTextureBlocks, const QfsArchive &trackTextures);
     static bool ExtractTrackTextures(const std::string &trackPath, const ::std::string trackName, NFSVer nfsVer);
     static int32_t hsStockTextureIndexRemap(int32_t textureIndex);
-    static GLuint MakeTextureArray(std::map<uint32_t, Texture> &textures, bool repeatable);
+    // Packs the textures into as few layers of a single array as will hold them, setting each texture's layer and min/max UVs
+    static GLuint MakeTextureArray(std::map<uint32_t, Texture> &textures);
 
     NFSVer tag;
     uint32_t id, width, height, layer;
+    // Region of the layer the texture occupies
     float minU, minV, maxU, maxV;
     GLubyte *data;
+    // Colour blocks of textures that were DXT packed at source, laid out like data, for compressed texture arrays to take as they are
+    std::shared_ptr<const std::vector<uint8_t>> dxtColourBlocks;
+    // Shared by every texture in the layer, so whatever draws them can choose when the layer is uploaded
+    UploadPriority uploadPriority;
     RawTextureInfo rawTextureInfo;
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 void TrackRenderer::Render(const std::vector<std::shared_ptr<CarAgent>> &racers,
                            const std::shared_ptr<BaseCamera> &camera,
                            GLuint trackTextureArrayID,
-                           const std::vector<std::shared_ptr<Entity>> &visibleEntities,
+                           const TrackGeometryPool &trackGeometry,
                            const std::vector<shared_ptr<BaseLight>> &lights,
                            const ParamData &userParams,
                            GLuint depthTextureID,
@@ -29,12 +29,8 @@ void TrackRenderer::Render(const std::vector<std::shared_ptr<CarAgent>> &racers,
         }
     }
 
-    // Render the per-trackblock data
-    for (auto &entity : visibleEntities)
-    {
-        m_trackShader.loadTransformMatrix(boost::get<TrackModel>(entity->raw).ModelMatrix);
-        boost::get<TrackModel>(entity->raw).render();
-    }
+    // Render the per-trackblock data, the visible set of which the pool already holds draws for
+    trackGeometry.Draw(MAIN_PASS);
 
     m_trackShader.unbind();
     m_trackShader.HotReload();
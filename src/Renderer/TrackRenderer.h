@@ -3,6 +3,7 @@
 #include "../Camera/BaseCamera.h"
 #include "../Scene/Lights/BaseLight.h"
 #include "../Scene/Lights/GlobalLight.h"
+#include "../Scene/TrackGeometryPool.h"
 #include "../Shaders/TrackShader.h"
 #include "../Shaders/BillboardShader.h"
 #include "../RaceNet/Agents/CarAgent.h"
@@ -16,7 +17,7 @@ public:
     void Render(const std::vector<std::shared_ptr<CarAgent>> &racers,
                 const std::shared_ptr<BaseCamera> &camera,
                 GLuint trackTextureArrayID,
-                const std::vector<std::shared_ptr<Entity>> &visibleEntities,
+                const TrackGeometryPool &trackGeometry,
                 const std::vector<shared_ptr<BaseLight>> &lights,
                 const ParamData &userParams,
                 GLuint depthTextureID,
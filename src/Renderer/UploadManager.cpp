@@ -0,0 +1,286 @@
+#include "UploadManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "../Util/Logger.h"
+
+namespace
+{
+    // Room for a few frames of streaming in flight, and for any one texture array layer or trackblock's geometry
+    const size_t STAGING_RING_SIZE = 32 * 1024 * 1024;
+    // Every staged copy starts on this, which suits any source offset GL will be given
+    const size_t STAGING_ALIGNMENT = 256;
+    const size_t NO_STAGING        = SIZE_MAX;
+    // How long to block on the oldest fence at a time when waiting for staging space, and how many times before giving up on it
+    const GLuint64 FENCE_WAIT_NS = 1000000000;
+    const int MAX_FENCE_WAITS    = 5;
+} // namespace
+
+UploadManager &UploadManager::Get()
+{
+    static UploadManager instance;
+    return instance;
+}
+
+UploadPriority UploadManager::MakePriority(uint32_t priority)
+{
+    return std::make_shared<std::atomic<uint32_t>>(priority);
+}
+
+void UploadManager::Submit(UploadJob &&job)
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pendingUploads.push_back({std::move(job), m_nextSequence++, 0});
+}
+
+void UploadManager::Pump(size_t maxBytes)
+{
+    _IssuePending(maxBytes, UINT32_MAX, false);
+}
+
+void UploadManager::Flush(uint32_t maxPriority)
+{
+    _IssuePending(SIZE_MAX, maxPriority, true);
+}
+
+void UploadManager::CancelBufferUploads(GLuint buffer)
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pendingUploads.erase(std::remove_if(m_pendingUploads.begin(),
+                                          m_pendingUploads.end(),
+                                          [buffer](const PendingUpload &pendingUpload) { return pendingUpload.job.target == BUFFER_UPLOAD && pendingUpload.job.name == buffer; }),
+                           m_pendingUploads.end());
+}
+
+void UploadManager::CancelTextureUploads(GLuint texture)
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pendingUploads.erase(std::remove_if(m_pendingUploads.begin(),
+                                          m_pendingUploads.end(),
+                                          [texture](const PendingUpload &pendingUpload) { return pendingUpload.job.target != BUFFER_UPLOAD && pendingUpload.job.name == texture; }),
+                           m_pendingUploads.end());
+}
+
+size_t UploadManager::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    return m_pendingUploads.size();
+}
+
+void UploadManager::_Initialise()
+{
+    m_initialised = true;
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage)
+    {
+        GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &m_stagingBuffer);
+        glBindBuffer(GL_COPY_READ_BUFFER, m_stagingBuffer);
+        glBufferStorage(GL_COPY_READ_BUFFER, STAGING_RING_SIZE, nullptr, mapFlags);
+        m_stagingData = static_cast<uint8_t *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, STAGING_RING_SIZE, mapFlags));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        if (m_stagingData == nullptr)
+        {
+            LOG(WARNING) << "Unable to persistently map upload staging buffer";
+            glDeleteBuffers(1, &m_stagingBuffer);
+            m_stagingBuffer = 0;
+        }
+        else
+        {
+            m_stagingSize = STAGING_RING_SIZE;
+        }
+    }
+    LOG(INFO) << "Uploads will be staged through " << (m_stagingSize > 0 ? "a persistently mapped ring buffer" : "client memory");
+}
+
+void UploadManager::_IssuePending(size_t maxBytes, uint32_t maxPriority, bool waitForStaging)
+{
+    if (!m_initialised)
+    {
+        _Initialise();
+    }
+    _RetireStaging(false);
+
+    // Takes what's due off the front of the queue under the lock, then stages and issues it without, so that loader threads submitting more
+    // aren't held up behind a wait on the GPU
+    std::vector<PendingUpload> issuingUploads;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        for (auto &pendingUpload : m_pendingUploads)
+        {
+            pendingUpload.sortPriority = pendingUpload.job.priority ? pendingUpload.job.priority->load() : 0;
+        }
+        std::sort(m_pendingUploads.begin(), m_pendingUploads.end(), [](const PendingUpload &a, const PendingUpload &b) {
+            return a.sortPriority != b.sortPriority ? a.sortPriority < b.sortPriority : a.sequence < b.sequence;
+        });
+
+        size_t nDue = 0, nBytesDue = 0;
+        while (nDue < m_pendingUploads.size() && nBytesDue < maxBytes && m_pendingUploads[nDue].sortPriority <= maxPriority)
+        {
+            nBytesDue += m_pendingUploads[nDue++].job.size;
+        }
+        issuingUploads.assign(std::make_move_iterator(m_pendingUploads.begin()), std::make_move_iterator(m_pendingUploads.begin() + nDue));
+        m_pendingUploads.erase(m_pendingUploads.begin(), m_pendingUploads.begin() + nDue);
+    }
+
+    // Never skips ahead of an upload that doesn't fit, so that anything issued can rely on everything with a lower priority already being up
+    size_t nIssued = 0;
+    while (nIssued < issuingUploads.size() && _Issue(issuingUploads[nIssued].job, waitForStaging))
+    {
+        if (issuingUploads[nIssued].job.onUploaded)
+        {
+            issuingUploads[nIssued].job.onUploaded();
+        }
+        ++nIssued;
+    }
+    if (nIssued == issuingUploads.size())
+    {
+        return;
+    }
+
+    // Whatever didn't fit goes back, keeping its place in the queue by its sequence number
+    if (waitForStaging)
+    {
+        LOG(WARNING) << "Upload staging never freed up, leaving " << issuingUploads.size() - nIssued << " flushed uploads pending";
+    }
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pendingUploads.insert(m_pendingUploads.end(), std::make_move_iterator(issuingUploads.begin() + nIssued), std::make_move_iterator(issuingUploads.end()));
+}
+
+bool UploadManager::_Issue(const UploadJob &job, bool waitForStaging)
+{
+    if (m_stagingSize == 0 || job.size > m_stagingSize)
+    {
+        _IssueCommand(job, 0, job.data);
+        return true;
+    }
+
+    size_t stagingOffset, nBytes;
+    while ((stagingOffset = _AllocateStaging(job.size, nBytes)) == NO_STAGING)
+    {
+        size_t nFences = m_stagingFences.size();
+        _RetireStaging(waitForStaging);
+        if (m_stagingFences.size() == nFences)
+        {
+            return false;
+        }
+    }
+    memcpy(m_stagingData + stagingOffset, job.data, job.size);
+    _IssueCommand(job, m_stagingBuffer, reinterpret_cast<const void *>(stagingOffset));
+    m_stagingFences.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), nBytes});
+    return true;
+}
+
+void UploadManager::_IssueCommand(const UploadJob &job, GLuint sourceBuffer, const void *source)
+{
+    switch (job.target)
+    {
+    case BUFFER_UPLOAD:
+        glBindBuffer(GL_COPY_WRITE_BUFFER, job.name);
+        if (sourceBuffer != 0)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, sourceBuffer);
+            glCopyBufferSubData(
+              GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, reinterpret_cast<GLintptr>(source), static_cast<GLintptr>(job.bufferOffset), static_cast<GLsizeiptr>(job.size));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        else
+        {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(job.bufferOffset), static_cast<GLsizeiptr>(job.size), source);
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        break;
+    case TEXTURE_UPLOAD:
+    case COMPRESSED_TEXTURE_UPLOAD:
+        // With a buffer bound for unpacking, source is an offset into it
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, sourceBuffer);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, job.name);
+        if (job.target == TEXTURE_UPLOAD)
+        {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, job.level, 0, 0, job.firstLayer, job.width, job.height, job.nLayers, job.format, GL_UNSIGNED_BYTE, source);
+        }
+        else
+        {
+            glCompressedTexSubImage3D(
+              GL_TEXTURE_2D_ARRAY, job.level, 0, 0, job.firstLayer, job.width, job.height, job.nLayers, job.format, static_cast<GLsizei>(job.size), source);
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        break;
+    default:
+        ASSERT(false, "Unknown upload target " << (int) job.target);
+    }
+}
+
+size_t UploadManager::_AllocateStaging(size_t size, size_t &nBytes)
+{
+    size = (size + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+    if (m_stagingUsed == 0)
+    {
+        m_stagingHead = m_stagingTail = 0;
+    }
+
+    size_t stagingOffset;
+    size_t wrapBytes = 0;
+    if (m_stagingUsed == 0 || m_stagingHead > m_stagingTail)
+    {
+        // Free from the head to the end of the ring, then from the start up to the tail
+        if (m_stagingHead + size <= m_stagingSize)
+        {
+            stagingOffset = m_stagingHead;
+        }
+        else if (size <= m_stagingTail)
+        {
+            wrapBytes     = m_stagingSize - m_stagingHead;
+            stagingOffset = 0;
+        }
+        else
+        {
+            return NO_STAGING;
+        }
+    }
+    else if (m_stagingHead + size <= m_stagingTail)
+    {
+        // Already wrapped, free only between the head and the tail
+        stagingOffset = m_stagingHead;
+    }
+    else
+    {
+        return NO_STAGING;
+    }
+
+    nBytes        = wrapBytes + size;
+    m_stagingHead = stagingOffset + size;
+    m_stagingUsed += nBytes;
+    return stagingOffset;
+}
+
+void UploadManager::_RetireStaging(bool waitForOldest)
+{
+    int nWaits = 0;
+    while (!m_stagingFences.empty())
+    {
+        StagingFence &stagingFence = m_stagingFences.front();
+        GLenum waitResult          = glClientWaitSync(stagingFence.sync, waitForOldest ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, waitForOldest ? FENCE_WAIT_NS : 0);
+        if (waitResult == GL_TIMEOUT_EXPIRED)
+        {
+            if (waitForOldest && ++nWaits < MAX_FENCE_WAITS)
+            {
+                LOG(WARNING) << "Still waiting on upload staging fence after " << nWaits << "s";
+                continue;
+            }
+            break;
+        }
+        if (waitResult == GL_WAIT_FAILED)
+        {
+            LOG(WARNING) << "Waiting on upload staging fence failed, reusing its staging regardless";
+        }
+        glDeleteSync(stagingFence.sync);
+        m_stagingTail = (m_stagingTail + stagingFence.nBytes) % m_stagingSize;
+        m_stagingUsed -= stagingFence.nBytes;
+        m_stagingFences.pop_front();
+        // Only the oldest is worth blocking on, the rest are taken if they happen to be done already
+        waitForOldest = false;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <GL/glew.h>
+
+// Shared by uploads that are needed together, so whatever they're for can decide when they go up, even after they've been submitted. Lower
+// goes first.
+using UploadPriority = std::shared_ptr<std::atomic<uint32_t>>;
+
+// What an UploadJob writes into
+enum UploadTarget : uint8_t
+{
+    BUFFER_UPLOAD = 0,         // A range of a buffer object
+    TEXTURE_UPLOAD,            // RGBA8 layers of one mip level of a GL_TEXTURE_2D_ARRAY
+    COMPRESSED_TEXTURE_UPLOAD, // Block compressed layers of one mip level of a GL_TEXTURE_2D_ARRAY
+    N_UPLOAD_TARGETS
+};
+
+struct UploadJob
+{
+    UploadTarget target = BUFFER_UPLOAD;
+    // Buffer or texture to write into, which must already have its storage allocated
+    GLuint name = 0;
+    // Buffer uploads: where in the buffer the data goes
+    size_t bufferOffset = 0;
+    // Texture uploads: the sub image of the array the data covers, and its format (GL_RGBA, or the compressed internal format)
+    GLint level      = 0;
+    GLint firstLayer = 0;
+    GLsizei width    = 0;
+    GLsizei height   = 0;
+    GLsizei nLayers  = 1;
+    GLenum format    = GL_RGBA;
+    const void *data = nullptr;
+    size_t size      = 0;
+    // Keeps data alive until it has been uploaded
+    std::shared_ptr<const void> dataOwner;
+    // Needed straight away if null
+    UploadPriority priority;
+    // Called on the GL thread once the upload has been issued, after which anything drawn sees the data
+    std::function<void()> onUploaded;
+};
+
+// Streams uploads into GL resources from any thread, so that loading needn't wait on them and a frame only spends as long uploading as it can
+// afford. Jobs go up strictly in priority order on the GL thread, staged through a persistently mapped ring buffer (GL 4.4 or
+// ARB_buffer_storage) whose space is reclaimed as fences show the GPU is done copying out of it. Drivers without persistent mapping, and jobs too
+// big for the ring, upload straight from the job's data instead.
+class UploadManager
+{
+public:
+    UploadManager() = default;
+    UploadManager(const UploadManager &) = delete;
+    UploadManager &operator=(const UploadManager &) = delete;
+
+    // Shared manager the loaders and renderers use
+    static UploadManager &Get();
+    static UploadPriority MakePriority(uint32_t priority);
+
+    // Safe to call from any thread
+    void Submit(UploadJob &&job);
+    // GL thread only. Issues pending uploads in priority order until maxBytes have gone up, or until one doesn't fit in the free staging space.
+    void Pump(size_t maxBytes);
+    // GL thread only. Issues every pending upload at or below maxPriority, waiting on the GPU for staging space if it has to. Uploads are left
+    // pending if the GPU still hasn't freed any after a few seconds.
+    void Flush(uint32_t maxPriority = UINT32_MAX);
+    // GL thread only, like the delete of the buffer or texture they're called before. Drops anything still pending for it.
+    void CancelBufferUploads(GLuint buffer);
+    void CancelTextureUploads(GLuint texture);
+    size_t GetPendingCount();
+
+private:
+    struct PendingUpload
+    {
+        UploadJob job;
+        uint64_t sequence;
+        // Snapshot of the job's priority for sorting, as it can change under the sort from other threads
+        uint32_t sortPriority;
+    };
+    struct StagingFence
+    {
+        GLsync sync;
+        size_t nBytes;
+    };
+
+    void _Initialise();
+    // Issues the front pending uploads with a priority at or below maxPriority, stopping after maxBytes, or as soon as one doesn't fit. Only
+    // holds m_pendingMutex while taking them off the queue.
+    void _IssuePending(size_t maxBytes, uint32_t maxPriority, bool waitForStaging);
+    // Stages and issues job, returning false if it doesn't fit in the staging ring right now
+    bool _Issue(const UploadJob &job, bool waitForStaging);
+    void _IssueCommand(const UploadJob &job, GLuint sourceBuffer, const void *source);
+    // Offset of size free bytes of staging, or NO_STAGING. nBytes is what the allocation takes up, including any left unused at the end of the
+    // ring to wrap around.
+    size_t _AllocateStaging(size_t size, size_t &nBytes);
+    // Frees the staging of every fence the GPU has passed, first blocking on the oldest for a bounded time if waitForOldest
+    void _RetireStaging(bool waitForOldest);
+
+    std::mutex m_pendingMutex;
+    std::vector<PendingUpload> m_pendingUploads;
+    uint64_t m_nextSequence = 0;
+
+    bool m_initialised     = false;
+    GLuint m_stagingBuffer = 0;
+    uint8_t *m_stagingData = nullptr;
+    size_t m_stagingSize   = 0;
+    // Bytes [m_stagingTail, m_stagingHead) of the ring, wrapping around, are still being read by the GPU, each fence covering the next nBytes
+    size_t m_stagingHead = 0;
+    size_t m_stagingTail = 0;
+    size_t m_stagingUsed = 0;
+    std::deque<StagingFence> m_stagingFences;
+};
@@ -14,7 +14,7 @@ Entity::Entity(uint32_t parentTrackblockID,
 {
     tag                      = nfsVersion;
     type                     = entityType;
-    this->raw                = glMesh;
+    this->raw                = std::move(glMesh);
     this->flags              = flags;
     this->parentTrackblockID = parentTrackblockID;
     this->entityID           = entityID;
@@ -93,18 +93,20 @@ void Entity::_GenCollisionMesh()
     case XOBJ:
     case OBJ_POLY:
     {
-        std::vector<glm::vec3> vertices = boost::get<TrackModel>(raw).m_vertices;
-        center                          = boost::get<TrackModel>(raw).initialPosition;
-        orientation                     = boost::get<TrackModel>(raw).orientation;
+        // Track models are welded, walk their triangle list
+        const std::vector<glm::vec3> &vertices     = boost::get<TrackModel>(raw).m_vertices;
+        const std::vector<uint32_t> &vertexIndices = boost::get<TrackModel>(raw).m_vertexIndices;
+        center                                     = boost::get<TrackModel>(raw).initialPosition;
+        orientation                                = boost::get<TrackModel>(raw).orientation;
         if (dynamic)
         {
             // btBvhTriangleMeshShape doesn't collide when dynamic, use convex triangle mesh
             auto *mesh = new btTriangleMesh();
-            for (size_t vertIdx = 0; vertIdx < vertices.size() - 2; vertIdx += 3)
+            for (size_t indexIdx = 0; indexIdx + 2 < vertexIndices.size(); indexIdx += 3)
             {
-                glm::vec3 triangle  = vertices[vertIdx];
-                glm::vec3 triangle1 = vertices[vertIdx + 1];
-                glm::vec3 triangle2 = vertices[vertIdx + 2];
+                glm::vec3 triangle  = vertices[vertexIndices[indexIdx]];
+                glm::vec3 triangle1 = vertices[vertexIndices[indexIdx + 1]];
+                glm::vec3 triangle2 = vertices[vertexIndices[indexIdx + 2]];
                 mesh->addTriangle(Utils::glmToBullet(triangle), Utils::glmToBullet(triangle1), Utils::glmToBullet(triangle2), false);
             }
             m_collisionShape = new btConvexTriangleMeshShape(mesh);
@@ -112,11 +114,11 @@ void Entity::_GenCollisionMesh()
         else
         {
             // TODO: Use passable flags (flags&0x80) of VROAD to work out whether collidable
-            for (size_t vertIdx = 0; vertIdx < vertices.size() - 2; vertIdx += 3)
+            for (size_t indexIdx = 0; indexIdx + 2 < vertexIndices.size(); indexIdx += 3)
             {
-                glm::vec3 triangle  = vertices[vertIdx];
-                glm::vec3 triangle1 = vertices[vertIdx + 1];
-                glm::vec3 triangle2 = vertices[vertIdx + 2];
+                glm::vec3 triangle  = vertices[vertexIndices[indexIdx]];
+                glm::vec3 triangle1 = vertices[vertexIndices[indexIdx + 1]];
+                glm::vec3 triangle2 = vertices[vertexIndices[indexIdx + 2]];
                 m_collisionMesh.addTriangle(Utils::glmToBullet(triangle), Utils::glmToBullet(triangle1), Utils::glmToBullet(triangle2), false);
             }
             m_collisionShape = new btBvhTriangleMeshShape(&m_collisionMesh, true, true);
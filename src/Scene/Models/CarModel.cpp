@@ -1,5 +1,6 @@
 #include "CarModel.h"
 #include "../../Util/Utils.h"
+#include "../../Renderer/UploadManager.h"
 
 CarModel::CarModel(std::string name,
                    std::vector<glm::vec3>
@@ -161,13 +162,10 @@ void CarModel::update()
 
 void CarModel::destroy()
 {
-    if (!Config::get().vulkanRender)
+    if (!Config::get().vulkanRender && !Config::get().headless)
     {
+        UploadManager::Get().CancelBufferUploads(vertexBuffer);
         glDeleteBuffers(1, &vertexBuffer);
-        glDeleteBuffers(1, &uvBuffer);
-        glDeleteBuffers(1, &normalBuffer);
-        glDeleteBuffers(1, &textureIndexBuffer);
-        glDeleteBuffers(1, &polyFlagBuffer);
     }
 }
 
@@ -183,67 +181,35 @@ void CarModel::render()
 
 bool CarModel::genBuffers()
 {
-    if (Config::get().vulkanRender)
+    if (Config::get().vulkanRender || Config::get().headless)
         return true;
 
     glGenVertexArrays(1, &VertexArrayID);
     glBindVertexArray(VertexArrayID);
 
-    // Verts
-    glGenBuffers(1, &vertexBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(glm::vec3), &m_vertices[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(0,         // attribute
-                          3,         // size
-                          GL_FLOAT,  // type
-                          GL_FALSE,  // normalized?
-                          0,         // stride
-                          (void *) 0 // array buffer offset
-    );
-    // 1st attribute buffer : Vertices
-    glEnableVertexAttribArray(0);
-    // UVs
-    glGenBuffers(1, &uvBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, uvBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_uvs.size() * sizeof(glm::vec2), &m_uvs[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(1,         // attribute
-                          2,         // size
-                          GL_FLOAT,  // type
-                          GL_FALSE,  // normalized?
-                          0,         // stride
-                          (void *) 0 // array buffer offset
-    );
-    // 2nd attribute buffer : UVs
-    glEnableVertexAttribArray(1);
-    // Normals
-    glGenBuffers(1, &normalBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, normalBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_normals.size() * sizeof(glm::vec3), &m_normals[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(2,         // attribute
-                          3,         // size
-                          GL_FLOAT,  // type
-                          GL_TRUE,   // normalized?
-                          0,         // stride
-                          (void *) 0 // array buffer offset
-    );
-    // 3rd attribute buffer : Normals
-    glEnableVertexAttribArray(2);
-    // Texture Indices
-    glGenBuffers(1, &textureIndexBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, textureIndexBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_texture_indices.size() * sizeof(unsigned int), &m_texture_indices[0], GL_STATIC_DRAW);
-    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, 0, (void *) 0);
-    // 4th attribute buffer : Texture Indices
-    glEnableVertexAttribArray(3);
-    // Polygon Flags
-    glGenBuffers(1, &polyFlagBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, polyFlagBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_polygon_flags.size() * sizeof(uint32_t), &m_polygon_flags[0], GL_STATIC_DRAW);
-    glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, 0, (void *) 0);
-    // 5th attribute buffer : Polygon Flags
-    glEnableVertexAttribArray(4);
+    auto packedVertices = std::make_shared<std::vector<PackedCarVertex>>(m_vertices.size());
+    for (size_t vertexIdx = 0; vertexIdx < packedVertices->size(); ++vertexIdx)
+    {
+        PackedCarVertex &packedVertex = (*packedVertices)[vertexIdx];
+        packedVertex.position         = m_vertices[vertexIdx];
+        packedVertex.normal           = VertexFormat::PackNormal(VertexFormat::StreamValue(m_normals, vertexIdx, glm::vec3(0, 1, 0)));
+        packedVertex.uv               = VertexFormat::PackHalf(VertexFormat::StreamValue(m_uvs, vertexIdx, glm::vec2(0, 0)));
+        packedVertex.textureIndex     = static_cast<uint16_t>(VertexFormat::StreamValue(m_texture_indices, vertexIdx, 0u));
+        packedVertex.padding          = 0;
+        packedVertex.polygonFlag      = VertexFormat::StreamValue(m_polygon_flags, vertexIdx, 0u);
+    }
+    vertexBuffer = VertexFormat::GenVertexBuffer<PackedCarVertex>(packedVertices->size(), nullptr);
 
     glBindVertexArray(0);
 
+    // Without a priority, so it's among what the race waits on before it starts
+    UploadJob vertexUpload;
+    vertexUpload.target    = BUFFER_UPLOAD;
+    vertexUpload.name      = vertexBuffer;
+    vertexUpload.data      = packedVertices->data();
+    vertexUpload.size      = packedVertices->size() * sizeof(PackedCarVertex);
+    vertexUpload.dataOwner = packedVertices;
+    UploadManager::Get().Submit(std::move(vertexUpload));
+
     return true;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Model.h"
+#include "VertexFormat.h"
 
 class CarColour
 {
@@ -112,15 +113,11 @@ public:
     std::vector<uint32_t> m_polygon_flags;
     bool hasPolyFlags = false; // Avoid checking polygon_flags.size() every Shader bind
 private:
+    // Interleaved PackedCarVertex
     GLuint vertexBuffer;
-    GLuint uvBuffer;
-    GLuint normalBuffer;
 
     // Multitextured Car
-    GLuint textureIndexBuffer;
     std::vector<unsigned int> m_texture_indices;
-    // NFS4 Car
-    GLuint polyFlagBuffer;
 
     typedef Model super;
 };
@@ -133,4 +130,8 @@ public:
     std::vector<Dummy> dummies;
     std::vector<CarColour> colours;
     std::vector<CarModel> meshes;
+    // RGBA8 car texture, decoded at load time where the loader has it in memory (NFS3 car.viv). Empty otherwise, the Car then loads it from disk.
+    std::vector<uint8_t> texture;
+    int textureWidth  = 0;
+    int textureHeight = 0;
 };
\ No newline at end of file
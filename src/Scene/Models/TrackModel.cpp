@@ -1,6 +1,31 @@
 #include "TrackModel.h"
 #include "../../Util/Utils.h"
 
+#include <cstring>
+
+namespace
+{
+    const uint32_t NO_VERTEX = 0xFFFFFFFF;
+
+    // FNV-1a, over the raw bytes of an attribute so that only bit identical vertices weld
+    template <typename T>
+    inline uint64_t HashAttribute(uint64_t hash, const T &attribute)
+    {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&attribute);
+        for (size_t byteIdx = 0; byteIdx < sizeof(T); ++byteIdx)
+        {
+            hash = (hash ^ bytes[byteIdx]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    inline bool SameAttribute(const std::vector<T> &stream, size_t a, size_t b)
+    {
+        return memcmp(&stream[a], &stream[b], sizeof(T)) == 0;
+    }
+} // namespace
+
 TrackModel::TrackModel(std::vector<glm::vec3> &vertices,
                        std::vector<glm::vec3> &normals,
                        std::vector<glm::vec2> &uvs,
@@ -16,8 +41,8 @@ TrackModel::TrackModel(std::vector<glm::vec3> &vertices,
     {
         m_shadingData.push_back(shadingData[m_vertex_index]);
     }
+    _WeldVertices();
     enable();
-    ASSERT(genBuffers(), "Unable to generate GL Buffers for Track Model");
     update();
 }
 
@@ -38,8 +63,28 @@ TrackModel::TrackModel(std::vector<glm::vec3> &vertices,
     {
         m_shadingData.push_back(shadingData[vertexIndex]);
     }
+    _WeldVertices();
+    enable();
+    update();
+}
+
+TrackModel::TrackModel(std::vector<glm::vec3> &&vertices,
+                       std::vector<glm::vec3> &&normals,
+                       std::vector<glm::vec2> &&uvs,
+                       std::vector<uint32_t> &&textureIndices,
+                       std::vector<glm::vec4> &&shadingData,
+                       std::vector<uint32_t> &&vertexIndices,
+                       glm::vec3 centerPosition) : m_textureIndices(std::move(textureIndices)), m_shadingData(std::move(shadingData)),
+    Model("TrackMesh", std::move(vertices), std::move(uvs), std::move(normals), std::move(vertexIndices), false, centerPosition)
+{
+    // Fill the unused buffer with data
+    m_debugData.resize(m_textureIndices.size());
+
+    if (m_vertexIndices.empty())
+    {
+        _WeldVertices();
+    }
     enable();
-    ASSERT(genBuffers(), "Unable to generate GL Buffers for Track Model");
     update();
 }
 
@@ -52,88 +97,137 @@ void TrackModel::update()
 
 void TrackModel::destroy()
 {
-    glDeleteBuffers(1, &m_vertexBuffer);
-    glDeleteBuffers(1, &m_uvBuffer);
-    glDeleteBuffers(1, &m_textureIndexBuffer);
-    glDeleteBuffers(1, &m_shadingDataBuffer);
-    glDeleteBuffers(1, &m_normalBuffer);
-    glDeleteBuffers(1, &m_debugBuffer);
+    // The geometry is owned by the track's TrackGeometryPool
 }
 
 void TrackModel::render()
 {
-    if (enabled)
+    if (enabled && m_drawRange.nIndices > 0)
     {
         glBindVertexArray(VertexArrayID);
-        glDrawArrays(GL_TRIANGLES, 0, (GLsizei) m_vertices.size());
+        Draw();
         glBindVertexArray(0);
     }
 }
 
 bool TrackModel::genBuffers()
 {
-    glGenVertexArrays(1, &VertexArrayID);
-    glBindVertexArray(VertexArrayID);
-    // 1st attribute buffer : Vertices
-    glGenBuffers(1, &m_vertexBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(glm::vec3), &m_vertices[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(0,         // attribute
-                          3,         // size
-                          GL_FLOAT,  // type
-                          GL_FALSE,  // normalized?
-                          0,         // stride
-                          (void *) 0 // array buffer offset
-    );
-    glEnableVertexAttribArray(0);
-    // 2nd attribute buffer : UVs
-    glGenBuffers(1, &m_uvBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, m_uvBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_uvs.size() * sizeof(glm::vec2), &m_uvs[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(1,               // attribute
-                          2,               // size
-                          GL_FLOAT,        // type
-                          GL_FALSE,        // normalized?
-                          0,               // stride
-                          (void *) nullptr // array buffer offset
-    );
-    glEnableVertexAttribArray(1);
-    // 3rd attribute buffer : TrackModel Normals
-    glGenBuffers(1, &m_normalBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, m_normalBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_normals.size() * sizeof(glm::vec3), &m_normals[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(2,               // attribute
-                          3,               // size
-                          GL_FLOAT,        // type
-                          GL_FALSE,        // normalized?
-                          0,               // stride
-                          (void *) nullptr // array buffer offset
-    );
-    glEnableVertexAttribArray(2);
-    // 4th attribute buffer : Texture Indices
-    glGenBuffers(1, &m_textureIndexBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, m_textureIndexBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_textureIndices.size() * sizeof(uint32_t), &m_textureIndices[0], GL_STATIC_DRAW);
-    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, 0, (void *) nullptr);
-    glEnableVertexAttribArray(3);
-    // 5th attribute buffer : NFS Shading Data
-    glGenBuffers(1, &m_shadingDataBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, m_shadingDataBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_shadingData.size() * sizeof(glm::vec4), &m_shadingData[0], GL_STATIC_DRAW);
-    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, 0, (void *) nullptr);
-    glEnableVertexAttribArray(4);
-    // 6th attribute buffer : Debug Data
-    // Normals
-    glGenBuffers(1, &m_debugBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, m_debugBuffer);
-    glBufferData(GL_ARRAY_BUFFER, m_debugData.size() * sizeof(uint32_t), &m_debugData[0], GL_STATIC_DRAW);
-    glVertexAttribIPointer(5, 1, GL_UNSIGNED_INT, 0, (void *) nullptr);
-    glEnableVertexAttribArray(5);
-    // Lets not affect any state
-    glBindVertexArray(0);
+    // Track models aren't uploaded one by one, Track::GenerateGeometryPool packs them all into a single TrackGeometryPool
     return true;
 }
 
+void TrackModel::PackVertices(std::vector<PackedTrackVertex> &packedVertices) const
+{
+    for (size_t vertexIdx = 0; vertexIdx < m_vertices.size(); ++vertexIdx)
+    {
+        PackedTrackVertex packedVertex;
+        packedVertex.position     = m_vertices[vertexIdx];
+        packedVertex.normal       = VertexFormat::PackNormal(VertexFormat::StreamValue(m_normals, vertexIdx, glm::vec3(0, 1, 0)));
+        packedVertex.uv           = VertexFormat::PackUnorm16(VertexFormat::StreamValue(m_uvs, vertexIdx, glm::vec2(0, 0)));
+        packedVertex.shading      = VertexFormat::PackUnorm8(VertexFormat::StreamValue(m_shadingData, vertexIdx, glm::vec4(1, 1, 1, 1)));
+        packedVertex.textureIndex = static_cast<uint16_t>(VertexFormat::StreamValue(m_textureIndices, vertexIdx, 0u));
+        packedVertex.debugData    = static_cast<uint16_t>(VertexFormat::StreamValue(m_debugData, vertexIdx, 0u));
+        packedVertices.push_back(packedVertex);
+    }
+}
+
+void TrackModel::SetDrawRange(GLuint poolVertexArrayID, GLenum poolIndexType, const TrackDrawRange &drawRange)
+{
+    VertexArrayID = poolVertexArrayID;
+    m_indexType   = poolIndexType;
+    m_drawRange   = drawRange;
+}
+
+const TrackDrawRange &TrackModel::GetDrawRange() const
+{
+    return m_drawRange;
+}
+
+void TrackModel::Draw() const
+{
+    size_t indexSize = m_indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei) m_drawRange.nIndices, m_indexType, (void *) (m_drawRange.firstIndex * indexSize), m_drawRange.baseVertex);
+}
+
 TrackModel::TrackModel() : Model("TrackModel", std::vector<glm::vec3>(), std::vector<glm::vec2>(), std::vector<glm::vec3>(), std::vector<unsigned int>(), false, glm::vec3(0, 0, 0))
 {
 }
+
+void TrackModel::_WeldVertices()
+{
+    size_t nVertices = m_vertices.size();
+    bool weldable    = m_normals.size() == nVertices && m_uvs.size() == nVertices && m_textureIndices.size() == nVertices && m_shadingData.size() == nVertices &&
+                    m_debugData.size() == nVertices;
+    std::vector<uint32_t> vertexIndices(nVertices);
+
+    if (!weldable)
+    {
+        // Some loaders don't provide every stream per vertex yet, leave those meshes as they are
+        for (uint32_t vertexIdx = 0; vertexIdx < nVertices; ++vertexIdx)
+        {
+            vertexIndices[vertexIdx] = vertexIdx;
+        }
+        m_vertexIndices = std::move(vertexIndices);
+        return;
+    }
+
+    // Open addressing table of unique vertex indices, kept at most half full
+    size_t tableSize = 1;
+    while (tableSize < nVertices * 2)
+    {
+        tableSize <<= 1;
+    }
+    std::vector<uint32_t> uniqueVertexTable(tableSize, NO_VERTEX);
+
+    // Unique vertices are compacted to the front of the streams as they're found. They only ever move down, so a vertex yet to be visited
+    // is never overwritten.
+    uint32_t nUniqueVertices = 0;
+    for (size_t vertexIdx = 0; vertexIdx < nVertices; ++vertexIdx)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        hash          = HashAttribute(hash, m_vertices[vertexIdx]);
+        hash          = HashAttribute(hash, m_normals[vertexIdx]);
+        hash          = HashAttribute(hash, m_uvs[vertexIdx]);
+        hash          = HashAttribute(hash, m_textureIndices[vertexIdx]);
+        hash          = HashAttribute(hash, m_shadingData[vertexIdx]);
+        hash          = HashAttribute(hash, m_debugData[vertexIdx]);
+
+        for (size_t slot = hash & (tableSize - 1);; slot = (slot + 1) & (tableSize - 1))
+        {
+            uint32_t uniqueIdx = uniqueVertexTable[slot];
+            if (uniqueIdx == NO_VERTEX)
+            {
+                uniqueVertexTable[slot]           = nUniqueVertices;
+                m_vertices[nUniqueVertices]       = m_vertices[vertexIdx];
+                m_normals[nUniqueVertices]        = m_normals[vertexIdx];
+                m_uvs[nUniqueVertices]            = m_uvs[vertexIdx];
+                m_textureIndices[nUniqueVertices] = m_textureIndices[vertexIdx];
+                m_shadingData[nUniqueVertices]    = m_shadingData[vertexIdx];
+                m_debugData[nUniqueVertices]      = m_debugData[vertexIdx];
+                vertexIndices[vertexIdx]          = nUniqueVertices++;
+                break;
+            }
+            if (SameAttribute(m_vertices, uniqueIdx, vertexIdx) && SameAttribute(m_normals, uniqueIdx, vertexIdx) && SameAttribute(m_uvs, uniqueIdx, vertexIdx) &&
+                SameAttribute(m_textureIndices, uniqueIdx, vertexIdx) && SameAttribute(m_shadingData, uniqueIdx, vertexIdx) &&
+                SameAttribute(m_debugData, uniqueIdx, vertexIdx))
+            {
+                vertexIndices[vertexIdx] = uniqueIdx;
+                break;
+            }
+        }
+    }
+
+    m_vertices.resize(nUniqueVertices);
+    m_normals.resize(nUniqueVertices);
+    m_uvs.resize(nUniqueVertices);
+    m_textureIndices.resize(nUniqueVertices);
+    m_shadingData.resize(nUniqueVertices);
+    m_debugData.resize(nUniqueVertices);
+    m_vertices.shrink_to_fit();
+    m_normals.shrink_to_fit();
+    m_uvs.shrink_to_fit();
+    m_textureIndices.shrink_to_fit();
+    m_shadingData.shrink_to_fit();
+    m_debugData.shrink_to_fit();
+    m_vertexIndices = std::move(vertexIndices);
+}
@@ -1,6 +1,17 @@
 #pragma once
 
 #include "Model.h"
+#include "VertexFormat.h"
+
+// Where a TrackModel's geometry lives in the vertex and index buffers of its track's TrackGeometryPool
+struct TrackDrawRange
+{
+    int32_t baseVertex  = 0;
+    uint32_t firstIndex = 0;
+    uint32_t nIndices   = 0;
+    // Upload group of the pool the range belongs to
+    uint32_t group = 0;
+};
 
 class TrackModel : public Model
 {
@@ -9,20 +20,30 @@ public:
                std::vector<uint32_t> &vertexIndices, std::vector<glm::vec4> &shadingData, std::vector<uint32_t> &debugData, glm::vec3 centerPosition);
     TrackModel(std::vector<glm::vec3> &vertices, std::vector<glm::vec3> &normals, std::vector<glm::vec2> &uvs, std::vector<uint32_t> &textureIndices,
                std::vector<uint32_t> &vertexIndices, std::vector<glm::vec4> &shadingData, glm::vec3 centerPosition);
+    // Takes ownership of streams that are either a de-indexed triangle list (empty vertexIndices), which is then welded, or already welded and
+    // indexed by vertexIndices (e.g. read back from an ONFS track cache)
+    TrackModel(std::vector<glm::vec3> &&vertices, std::vector<glm::vec3> &&normals, std::vector<glm::vec2> &&uvs, std::vector<uint32_t> &&textureIndices,
+               std::vector<glm::vec4> &&shadingData, std::vector<uint32_t> &&vertexIndices, glm::vec3 centerPosition);
     TrackModel();
     void update() override;
     void destroy() override;
     void render() override;
     bool genBuffers() override;
+    // Appends the welded vertices in the layout they're drawn with
+    void PackVertices(std::vector<PackedTrackVertex> &packedVertices) const;
+    // Called by the TrackGeometryPool once it holds this model's geometry
+    void SetDrawRange(GLuint poolVertexArrayID, GLenum poolIndexType, const TrackDrawRange &drawRange);
+    const TrackDrawRange &GetDrawRange() const;
+    // Draws this model's range of the pool, which must already be bound
+    void Draw() const;
     std::vector<uint32_t> m_textureIndices;
     std::vector<glm::vec4> m_shadingData;
     std::vector<uint32_t> m_debugData;
 
 private:
-    GLuint m_vertexBuffer;
-    GLuint m_uvBuffer;
-    GLuint m_textureIndexBuffer;
-    GLuint m_shadingDataBuffer;
-    GLuint m_normalBuffer;
-    GLuint m_debugBuffer;
+    // Merges the identical vertices of the de-indexed triangle list, after which m_vertexIndices index the unique vertices for glDrawElements
+    void _WeldVertices();
+
+    TrackDrawRange m_drawRange;
+    GLenum m_indexType = GL_UNSIGNED_INT;
 };
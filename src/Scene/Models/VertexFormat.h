@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+// Interleaved, quantised vertex layouts that models upload their CPU side streams as. Each packed vertex has a VertexDescriptor specialisation
+// listing its attributes, so the layout a mesh type draws with is fixed at compile time. Attribute locations match the shaders, which see
+// normalised integers as floats and so are unchanged.
+struct VertexAttribute
+{
+    GLuint location;
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    bool integer; // Read as a uint by the shader, rather than converted to float
+    size_t offset;
+};
+
+// 32 bytes, against 56 as separate float streams. Track UVs are always within the [0, 1] of their texture array layer.
+struct PackedTrackVertex
+{
+    glm::vec3 position;
+    glm::i16vec4 normal; // snorm16, w pads to 4 byte alignment
+    glm::u16vec2 uv;     // unorm16
+    glm::u8vec4 shading; // RGBA8 unorm, the precision the NFS vertex shading is stored at
+    uint16_t textureIndex;
+    uint16_t debugData;
+};
+static_assert(sizeof(PackedTrackVertex) == 32, "PackedTrackVertex must stay tightly packed");
+
+// 32 bytes, against 40 as separate streams. FCE UVs can tile beyond [0, 1], so cars keep them as half floats.
+struct PackedCarVertex
+{
+    glm::vec3 position;
+    glm::i16vec4 normal; // snorm16, w pads to 4 byte alignment
+    glm::u16vec2 uv;     // half float
+    uint16_t textureIndex;
+    uint16_t padding;
+    uint32_t polygonFlag;
+};
+static_assert(sizeof(PackedCarVertex) == 32, "PackedCarVertex must stay tightly packed");
+
+// First of the 4 consecutive locations taken by the per draw model matrix (a mat4 attribute) in the track and depth shaders. Either streamed per
+// instance by the TrackGeometryPool's indirect draws, or left as a constant attribute value that LoadConstantTransform sets.
+const GLuint TRANSFORM_ATTRIBUTE_LOCATION = 6;
+
+template <typename Vertex>
+struct VertexDescriptor;
+
+template <>
+struct VertexDescriptor<PackedTrackVertex>
+{
+    static std::array<VertexAttribute, 6> Attributes()
+    {
+        return {{
+          {0, 3, GL_FLOAT, GL_FALSE, false, offsetof(PackedTrackVertex, position)},
+          {1, 2, GL_UNSIGNED_SHORT, GL_TRUE, false, offsetof(PackedTrackVertex, uv)},
+          {2, 3, GL_SHORT, GL_TRUE, false, offsetof(PackedTrackVertex, normal)},
+          {3, 1, GL_UNSIGNED_SHORT, GL_FALSE, true, offsetof(PackedTrackVertex, textureIndex)},
+          {4, 4, GL_UNSIGNED_BYTE, GL_TRUE, false, offsetof(PackedTrackVertex, shading)},
+          {5, 1, GL_UNSIGNED_SHORT, GL_FALSE, true, offsetof(PackedTrackVertex, debugData)},
+        }};
+    }
+};
+
+template <>
+struct VertexDescriptor<PackedCarVertex>
+{
+    static std::array<VertexAttribute, 5> Attributes()
+    {
+        return {{
+          {0, 3, GL_FLOAT, GL_FALSE, false, offsetof(PackedCarVertex, position)},
+          {1, 2, GL_HALF_FLOAT, GL_FALSE, false, offsetof(PackedCarVertex, uv)},
+          {2, 3, GL_SHORT, GL_TRUE, false, offsetof(PackedCarVertex, normal)},
+          {3, 1, GL_UNSIGNED_SHORT, GL_FALSE, true, offsetof(PackedCarVertex, textureIndex)},
+          {4, 1, GL_UNSIGNED_INT, GL_FALSE, true, offsetof(PackedCarVertex, polygonFlag)},
+        }};
+    }
+};
+
+namespace VertexFormat
+{
+    // Not every loader fills every stream per vertex, those it doesn't are packed as the given fallback
+    template <typename T>
+    inline T StreamValue(const std::vector<T> &stream, size_t vertexIdx, const T &fallback)
+    {
+        return vertexIdx < stream.size() ? stream[vertexIdx] : fallback;
+    }
+
+    inline glm::i16vec4 PackNormal(const glm::vec3 &normal)
+    {
+        return glm::i16vec4(glm::round(glm::clamp(glm::vec4(normal, 0.0f), -1.0f, 1.0f) * 32767.0f));
+    }
+
+    inline glm::u16vec2 PackUnorm16(const glm::vec2 &value)
+    {
+        return glm::u16vec2(glm::round(glm::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    inline glm::u16vec2 PackHalf(const glm::vec2 &value)
+    {
+        return glm::u16vec2(glm::packHalf1x16(value.x), glm::packHalf1x16(value.y));
+    }
+
+    inline glm::u8vec4 PackUnorm8(const glm::vec4 &value)
+    {
+        return glm::u8vec4(glm::round(glm::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    // Sets the model matrix that draws without per instance transforms bound use
+    inline void LoadConstantTransform(const glm::mat4 &transform)
+    {
+        for (GLuint column = 0; column < 4; ++column)
+        {
+            glVertexAttrib4fv(TRANSFORM_ATTRIBUTE_LOCATION + column, &transform[column][0]);
+        }
+    }
+
+    // Creates a GL_ARRAY_BUFFER for nVertices packed vertices and points the bound vertex array's attributes at it, as Vertex's descriptor lays
+    // them out. Without vertices, the buffer's contents are left for an UploadManager job to fill in.
+    template <typename Vertex>
+    GLuint GenVertexBuffer(size_t nVertices, const Vertex *vertices)
+    {
+        GLuint vertexBuffer;
+        glGenBuffers(1, &vertexBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, nVertices * sizeof(Vertex), vertices, GL_STATIC_DRAW);
+        for (const auto &attribute : VertexDescriptor<Vertex>::Attributes())
+        {
+            if (attribute.integer)
+            {
+                glVertexAttribIPointer(attribute.location, attribute.size, attribute.type, sizeof(Vertex), (void *) attribute.offset);
+            }
+            else
+            {
+                glVertexAttribPointer(attribute.location, attribute.size, attribute.type, attribute.normalized, sizeof(Vertex), (void *) attribute.offset);
+            }
+            glEnableVertexAttribArray(attribute.location);
+        }
+
+        return vertexBuffer;
+    }
+
+    // Uploads the packed vertices to a new GL_ARRAY_BUFFER straight away
+    template <typename Vertex>
+    GLuint GenVertexBuffer(const std::vector<Vertex> &vertices)
+    {
+        return GenVertexBuffer(vertices.size(), vertices.data());
+    }
+} // namespace VertexFormat
@@ -0,0 +1,41 @@
+#include "PotentiallyVisibleSet.h"
+
+void PotentiallyVisibleSet::Build(const std::vector<OpenNFS::TrackBlock> &trackBlocks)
+{
+    m_nBlocks       = static_cast<uint32_t>(trackBlocks.size());
+    m_wordsPerBlock = (m_nBlocks + 63) / 64;
+    m_visibilityBits.assign(m_nBlocks * m_wordsPerBlock, 0);
+
+    for (uint32_t blockIdx = 0; blockIdx < m_nBlocks; ++blockIdx)
+    {
+        uint64_t *visibleBlocks = &m_visibilityBits[blockIdx * m_wordsPerBlock];
+        if (trackBlocks[blockIdx].neighbourIds.empty())
+        {
+            for (uint32_t blockID = 0; blockID < m_nBlocks; ++blockID)
+            {
+                visibleBlocks[blockID / 64] |= 1ull << (blockID % 64);
+            }
+            continue;
+        }
+
+        // A block can always see itself, whether or not its own list says so
+        visibleBlocks[blockIdx / 64] |= 1ull << (blockIdx % 64);
+        for (auto &neighbourID : trackBlocks[blockIdx].neighbourIds)
+        {
+            if (neighbourID < m_nBlocks)
+            {
+                visibleBlocks[neighbourID / 64] |= 1ull << (neighbourID % 64);
+            }
+        }
+    }
+}
+
+bool PotentiallyVisibleSet::IsVisible(uint32_t fromBlockID, uint32_t blockID) const
+{
+    // Anything not part of a trackblock is never culled by it
+    if (fromBlockID >= m_nBlocks || blockID >= m_nBlocks)
+    {
+        return true;
+    }
+    return (m_visibilityBits[fromBlockID * m_wordsPerBlock + blockID / 64] >> (blockID % 64)) & 1ull;
+}
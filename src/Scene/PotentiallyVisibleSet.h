@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TrackBlock.h"
+
+// Which trackblocks can be seen from each trackblock, built once at load from the neighbour lists the original games used for the same job. Every
+// block gets a row of bits over all blocks, so whether one block can see another is a single lookup rather than a search of its neighbour list.
+class PotentiallyVisibleSet
+{
+public:
+    PotentiallyVisibleSet() = default;
+
+    // Blocks without neighbour data see every block, as the track formats that lack it have nothing better to go on
+    void Build(const std::vector<OpenNFS::TrackBlock> &trackBlocks);
+    bool IsVisible(uint32_t fromBlockID, uint32_t blockID) const;
+
+private:
+    uint32_t m_nBlocks     = 0;
+    size_t m_wordsPerBlock = 0;
+    // One row of m_wordsPerBlock words per block, bit (blockID % 64) of word (blockID / 64) set for each block it can see
+    std::vector<uint64_t> m_visibilityBits;
+};
@@ -1,5 +1,7 @@
 #include "Track.h"
 
+#include <algorithm>
+
 void Track::GenerateSpline()
 {
     // Build a spline through the center of the track
@@ -11,22 +13,147 @@ void Track::GenerateSpline()
     centerSpline = HermiteCurve(cameraPoints, 0.1f, 0.0f);
 }
 
+void Track::GenerateGeometryPool()
+{
+    // Each trackblock's models are uploaded together, as are the global objects, which can be seen from anywhere so always go first
+    std::vector<std::vector<TrackModel *>> modelGroups(trackBlocks.size() + 1);
+    auto addTrackModels = [](std::vector<Entity> &entities, std::vector<TrackModel *> &trackModels) {
+        for (auto &entity : entities)
+        {
+            if (auto *trackModel = boost::get<TrackModel>(&entity.raw))
+            {
+                trackModels.push_back(trackModel);
+            }
+        }
+    };
+    for (size_t blockIdx = 0; blockIdx < trackBlocks.size(); ++blockIdx)
+    {
+        addTrackModels(trackBlocks[blockIdx].track, modelGroups[blockIdx]);
+        addTrackModels(trackBlocks[blockIdx].objects, modelGroups[blockIdx]);
+        addTrackModels(trackBlocks[blockIdx].lanes, modelGroups[blockIdx]);
+        addTrackModels(trackBlocks[blockIdx].medResTrack, modelGroups[blockIdx]);
+        addTrackModels(trackBlocks[blockIdx].loResTrack, modelGroups[blockIdx]);
+    }
+    addTrackModels(globalObjects, modelGroups.back());
+
+    blockUploadPriorities.clear();
+    for (size_t blockIdx = 0; blockIdx < trackBlocks.size(); ++blockIdx)
+    {
+        blockUploadPriorities.push_back(UploadManager::MakePriority(0));
+    }
+    std::vector<UploadPriority> groupPriorities = blockUploadPriorities;
+    groupPriorities.push_back(UploadManager::MakePriority(0));
+
+    geometryPool.Build(modelGroups, groupPriorities);
+}
+
 void Track::GenerateAabbTree()
 {
-    // Build an optimised BvH of AABB's so that culling for render becomes cheap
+    // Build an optimised BvH of AABB's so that culling for render becomes cheap. Global objects are always drawn, so stay out of it.
+    std::vector<const IAABB *> cullObjects;
     for (auto &trackBlock : trackBlocks)
     {
         for (auto &baseTrackEntity : trackBlock.track)
         {
-            cullTree.insertObject(std::make_shared<Entity>(baseTrackEntity));
+            cullObjects.emplace_back(&baseTrackEntity);
         }
         for (auto &trackObjectEntity : trackBlock.objects)
         {
-            cullTree.insertObject(std::make_shared<Entity>(trackObjectEntity));
+            cullObjects.emplace_back(&trackObjectEntity);
         }
         for (auto &trackLaneEntity : trackBlock.lanes)
         {
-            cullTree.insertObject(std::make_shared<Entity>(trackLaneEntity));
+            cullObjects.emplace_back(&trackLaneEntity);
+        }
+        for (auto &trackLightEntity : trackBlock.lights)
+        {
+            cullObjects.emplace_back(&trackLightEntity);
         }
     }
+    cullTree.Build(cullObjects);
+}
+
+void Track::GeneratePotentiallyVisibleSet()
+{
+    potentiallyVisibleSet.Build(trackBlocks);
+}
+
+void Track::GenerateSpatialIndex()
+{
+    spatialIndex.Build(trackBlocks, virtualRoad);
+}
+
+uint32_t Track::PrioritiseUploads(uint32_t spawnVroadIdx)
+{
+    if (trackBlocks.empty())
+    {
+        return 0;
+    }
+
+    glm::vec3 spawnPosition = virtualRoad.empty() ? trackBlocks[0].position : virtualRoad[std::min<size_t>(spawnVroadIdx, virtualRoad.size() - 1)].position;
+    uint32_t spawnBlockID   = spatialIndex.GetNearestTrackblockID(spawnPosition, 0);
+
+    // Blocks visible from the spawn block first, then the rest, each nearest first
+    std::vector<uint32_t> rankedBlockIDs(trackBlocks.size());
+    for (uint32_t blockID = 0; blockID < rankedBlockIDs.size(); ++blockID)
+    {
+        rankedBlockIDs[blockID] = blockID;
+    }
+    auto isVisible = [&](uint32_t blockID) { return potentiallyVisibleSet.IsVisible(spawnBlockID, blockID); };
+    auto distance2 = [&](uint32_t blockID) {
+        glm::vec3 offset = trackBlocks[blockID].position - spawnPosition;
+        return glm::dot(offset, offset);
+    };
+    std::sort(rankedBlockIDs.begin(), rankedBlockIDs.end(), [&](uint32_t a, uint32_t b) {
+        return isVisible(a) != isVisible(b) ? isVisible(a) : distance2(a) < distance2(b);
+    });
+    uint32_t nVisibleBlocks = static_cast<uint32_t>(std::count_if(rankedBlockIDs.begin(), rankedBlockIDs.end(), isVisible));
+
+    // A block's texture layers go up just ahead of its geometry, unless an earlier block already needed them. Global objects can be seen from
+    // anywhere, so theirs go up first, and layers nothing uses go last.
+    std::map<uint32_t, UploadPriority> layerPriorities;
+    for (auto &texture : textureMap)
+    {
+        if (texture.second.uploadPriority)
+        {
+            layerPriorities[texture.second.layer] = texture.second.uploadPriority;
+        }
+    }
+    std::vector<uint32_t> layerRanks(layerPriorities.empty() ? 0 : layerPriorities.rbegin()->first + 1, UINT32_MAX);
+    auto rankLayers = [&](const std::vector<Entity> &entities, uint32_t priority) {
+        for (auto &entity : entities)
+        {
+            if (const auto *trackModel = boost::get<TrackModel>(&entity.raw))
+            {
+                for (uint32_t layer : trackModel->m_textureIndices)
+                {
+                    if (layer < layerRanks.size())
+                    {
+                        layerRanks[layer] = std::min(layerRanks[layer], priority);
+                    }
+                }
+            }
+        }
+    };
+    rankLayers(globalObjects, 0);
+    for (uint32_t rank = 0; rank < rankedBlockIDs.size(); ++rank)
+    {
+        OpenNFS::TrackBlock &trackBlock = trackBlocks[rankedBlockIDs[rank]];
+        rankLayers(trackBlock.track, 2 * rank);
+        rankLayers(trackBlock.objects, 2 * rank);
+        rankLayers(trackBlock.lanes, 2 * rank);
+        rankLayers(trackBlock.medResTrack, 2 * rank);
+        rankLayers(trackBlock.loResTrack, 2 * rank);
+        if (rankedBlockIDs[rank] < blockUploadPriorities.size())
+        {
+            blockUploadPriorities[rankedBlockIDs[rank]]->store(2 * rank + 1);
+        }
+    }
+    for (auto &layerPriority : layerPriorities)
+    {
+        layerPriority.second->store(std::min(layerRanks[layerPriority.first], static_cast<uint32_t>(2 * rankedBlockIDs.size())));
+    }
+
+    LOG(INFO) << "Uploads prioritised from trackblock " << spawnBlockID << ", " << nVisibleBlocks << " of " << trackBlocks.size() << " blocks are needed to start";
+    return nVisibleBlocks > 0 ? 2 * (nVisibleBlocks - 1) + 1 : 0;
 }
\ No newline at end of file
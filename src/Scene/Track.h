@@ -5,7 +5,10 @@
 #include <memory>
 
 #include "Entity.h"
+#include "PotentiallyVisibleSet.h"
 #include "TrackBlock.h"
+#include "TrackGeometryPool.h"
+#include "TrackSpatialIndex.h"
 #include "VirtualRoad.h"
 
 #include "../Loaders/Shared/CanFile.h"
@@ -13,14 +16,22 @@
 #include "../Renderer/Texture.h"
 #include "../Renderer/HermiteCurve.h"
 
-constexpr uint16_t kCullTreeInitialSize = 4000;
-
 class Track
 {
 public:
-    Track() : cullTree(kCullTreeInitialSize), nBlocks(0), nfsVersion(UNKNOWN){};
+    Track() : nBlocks(0), nfsVersion(UNKNOWN){};
     void GenerateSpline();
+    // Packs a copy of every track model's geometry into geometryPool and points each model at its draw range there. Models keep their own
+    // vertex data for physics, caching and export. Must run before anything copies the track's entities, so the copies have their ranges.
+    void GenerateGeometryPool();
+    // Builds cullTree over the trackblock entities, which must not be moved or added to afterwards
     void GenerateAabbTree();
+    void GeneratePotentiallyVisibleSet();
+    void GenerateSpatialIndex();
+    // Orders the streaming uploads of trackblock geometry and texture layers by how soon they could be seen from the given virtual road node:
+    // blocks visible from there first, nearest first, then the rest of the track by distance. Returns the priority at or below which everything
+    // visible from the start has been prioritised, for the caller to flush before it's drawn.
+    uint32_t PrioritiseUploads(uint32_t spawnVroadIdx);
 
     // Metadata
     NFSVer nfsVersion;
@@ -34,9 +45,14 @@ public:
     std::vector<OpenNFS::TrackBlock> trackBlocks;
     std::vector<Entity> globalObjects;
     std::vector<Entity> vroadBarriers;
+    PotentiallyVisibleSet potentiallyVisibleSet;
+    TrackSpatialIndex spatialIndex;
 
     // GL 3D Render Data
     std::map<uint32_t, Texture> textureMap;
     GLuint textureArrayID = 0;
+    TrackGeometryPool geometryPool;
+    // Upload priority of each trackblock's geometry in geometryPool
+    std::vector<UploadPriority> blockUploadPriorities;
     AABBTree cullTree;
 };
\ No newline at end of file
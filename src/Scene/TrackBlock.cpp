@@ -10,3 +10,21 @@ TrackBlock::TrackBlock(uint32_t id, glm::vec3 position, uint32_t virtualRoadStar
     this->nVirtualRoadPositions = nVirtualRoadPositions;
     this->neighbourIds          = neighbourIds;
 }
+
+const std::vector<Entity> &TrackBlock::GetTrack(TrackLOD lod) const
+{
+    if (lod >= LO_RES && !loResTrack.empty())
+    {
+        return loResTrack;
+    }
+    if (lod >= MED_RES && !medResTrack.empty())
+    {
+        return medResTrack;
+    }
+    return track;
+}
+
+TrackLOD TrackBlock::GetLowestLOD() const
+{
+    return !loResTrack.empty() ? LO_RES : (!medResTrack.empty() ? MED_RES : HI_RES);
+}
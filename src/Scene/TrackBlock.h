@@ -5,12 +5,25 @@
 
 #include "Entity.h"
 
+// Resolutions the FRD stores each trackblock's road polygons at, highest first
+enum TrackLOD : uint8_t
+{
+    HI_RES = 0,
+    MED_RES,
+    LO_RES,
+    N_TRACK_LODS
+};
+
 namespace OpenNFS
 {
     class TrackBlock
     {
     public:
         TrackBlock(uint32_t id, glm::vec3 position, uint32_t virtualRoadStartIndex, uint32_t nVirtualRoadPositions, const std::vector<uint32_t> &neighbourIds);
+        // The road at the given resolution, or the nearest higher one the track has
+        const std::vector<Entity> &GetTrack(TrackLOD lod) const;
+        // Lowest resolution this block's road is available at
+        TrackLOD GetLowestLOD() const;
 
         uint32_t id;
         glm::vec3 position;
@@ -19,6 +32,10 @@ namespace OpenNFS
         std::vector<uint32_t> neighbourIds;
 
         std::vector<Entity> track;
+        // Lower resolution versions of track, drawn in its place further from the camera. Only the render uses them, and they're empty for
+        // formats that don't have them.
+        std::vector<Entity> medResTrack;
+        std::vector<Entity> loResTrack;
         std::vector<Entity> objects;
         std::vector<Entity> lanes;
         std::vector<Entity> lights;
@@ -0,0 +1,237 @@
+#include "TrackGeometryPool.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "../Config.h"
+#include "../Util/Utils.h"
+
+namespace
+{
+    // Indices stay relative to their model, glDrawElementsBaseVertex offsets them into the pool. Each group's upload covers its own slice of them.
+    template <typename Index>
+    void SubmitIndexUploads(GLuint indexBuffer,
+                            const std::vector<std::vector<TrackModel *>> &modelGroups,
+                            const std::vector<UploadPriority> &groupPriorities,
+                            const std::vector<size_t> &groupFirstIndices,
+                            size_t nIndices,
+                            const std::function<void(uint32_t)> &onGroupUploaded)
+    {
+        auto indices = std::make_shared<std::vector<Index>>();
+        indices->reserve(nIndices);
+        for (auto &modelGroup : modelGroups)
+        {
+            for (auto *trackModel : modelGroup)
+            {
+                for (uint32_t vertexIndex : trackModel->m_vertexIndices)
+                {
+                    indices->push_back(static_cast<Index>(vertexIndex));
+                }
+            }
+        }
+
+        for (uint32_t groupIdx = 0; groupIdx < modelGroups.size(); ++groupIdx)
+        {
+            size_t nGroupIndices = groupFirstIndices[groupIdx + 1] - groupFirstIndices[groupIdx];
+            if (nGroupIndices == 0)
+            {
+                onGroupUploaded(groupIdx);
+                continue;
+            }
+            // Submitted after the group's vertices at the same priority, so they're up by the time this is
+            UploadJob indexUpload;
+            indexUpload.target       = BUFFER_UPLOAD;
+            indexUpload.name         = indexBuffer;
+            indexUpload.bufferOffset = groupFirstIndices[groupIdx] * sizeof(Index);
+            indexUpload.data         = indices->data() + groupFirstIndices[groupIdx];
+            indexUpload.size         = nGroupIndices * sizeof(Index);
+            indexUpload.dataOwner    = indices;
+            indexUpload.priority     = groupPriorities[groupIdx];
+            indexUpload.onUploaded   = std::bind(onGroupUploaded, groupIdx);
+            UploadManager::Get().Submit(std::move(indexUpload));
+        }
+    }
+} // namespace
+
+TrackGeometryPool::~TrackGeometryPool()
+{
+    if (m_vertexArrayID == 0)
+        return;
+
+    UploadManager::Get().CancelBufferUploads(m_vertexBuffer);
+    UploadManager::Get().CancelBufferUploads(m_indexBuffer);
+    glDeleteBuffers(1, &m_vertexBuffer);
+    glDeleteBuffers(1, &m_indexBuffer);
+    if (m_multiDrawIndirect)
+    {
+        glDeleteBuffers(1, &m_transformBuffer);
+        glDeleteBuffers(1, &m_indirectBuffer);
+    }
+    glDeleteVertexArrays(1, &m_vertexArrayID);
+}
+
+void TrackGeometryPool::Build(const std::vector<std::vector<TrackModel *>> &modelGroups, const std::vector<UploadPriority> &groupPriorities)
+{
+    ASSERT(m_vertexArrayID == 0, "Track geometry pool has already been built");
+    ASSERT(modelGroups.size() == groupPriorities.size(), "Every track model group needs an upload priority");
+
+    // Lay the models out back to back, group after group, short indices suffice if no single model needs more
+    std::vector<TrackModel *> trackModels;
+    std::vector<TrackDrawRange> drawRanges;
+    std::vector<size_t> groupFirstVertices(1, 0), groupFirstIndices(1, 0);
+    size_t maxModelVertices = 0;
+    for (uint32_t groupIdx = 0; groupIdx < modelGroups.size(); ++groupIdx)
+    {
+        for (auto *trackModel : modelGroups[groupIdx])
+        {
+            TrackDrawRange drawRange;
+            drawRange.baseVertex = static_cast<int32_t>(nVertices);
+            drawRange.firstIndex = static_cast<uint32_t>(nIndices);
+            drawRange.nIndices   = static_cast<uint32_t>(trackModel->m_vertexIndices.size());
+            drawRange.group      = groupIdx;
+            trackModels.push_back(trackModel);
+            drawRanges.push_back(drawRange);
+
+            nVertices += trackModel->m_vertices.size();
+            nIndices += trackModel->m_vertexIndices.size();
+            maxModelVertices = std::max(maxModelVertices, trackModel->m_vertices.size());
+        }
+        groupFirstVertices.push_back(nVertices);
+        groupFirstIndices.push_back(nIndices);
+    }
+    m_indexType = maxModelVertices <= UINT16_MAX + 1 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    LOG(INFO) << "Pooling " << trackModels.size() << " track models in " << modelGroups.size() << " upload groups, " << nVertices << " vertices and " << nIndices
+              << " indices";
+
+    // No GL context when converting assets headless, so there's nothing to wait on
+    m_groupResident.assign(modelGroups.size(), Config::get().headless);
+    if (!Config::get().headless)
+    {
+        auto packedVertices = std::make_shared<std::vector<PackedTrackVertex>>();
+        packedVertices->reserve(nVertices);
+        for (auto *trackModel : trackModels)
+        {
+            trackModel->PackVertices(*packedVertices);
+        }
+
+        // Storage is allocated up front, the UploadManager fills it in as each group's priority comes up
+        glGenVertexArrays(1, &m_vertexArrayID);
+        glBindVertexArray(m_vertexArrayID);
+        m_vertexBuffer = VertexFormat::GenVertexBuffer<PackedTrackVertex>(nVertices, nullptr);
+        glGenBuffers(1, &m_indexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, nIndices * (m_indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t)), nullptr, GL_STATIC_DRAW);
+
+        for (uint32_t groupIdx = 0; groupIdx < modelGroups.size(); ++groupIdx)
+        {
+            size_t nGroupVertices = groupFirstVertices[groupIdx + 1] - groupFirstVertices[groupIdx];
+            if (nGroupVertices == 0)
+            {
+                continue;
+            }
+            UploadJob vertexUpload;
+            vertexUpload.target       = BUFFER_UPLOAD;
+            vertexUpload.name         = m_vertexBuffer;
+            vertexUpload.bufferOffset = groupFirstVertices[groupIdx] * sizeof(PackedTrackVertex);
+            vertexUpload.data         = packedVertices->data() + groupFirstVertices[groupIdx];
+            vertexUpload.size         = nGroupVertices * sizeof(PackedTrackVertex);
+            vertexUpload.dataOwner    = packedVertices;
+            vertexUpload.priority     = groupPriorities[groupIdx];
+            UploadManager::Get().Submit(std::move(vertexUpload));
+        }
+        auto onGroupUploaded = [this](uint32_t groupIdx) { m_groupResident[groupIdx] = true; };
+        if (m_indexType == GL_UNSIGNED_SHORT)
+        {
+            SubmitIndexUploads<uint16_t>(m_indexBuffer, modelGroups, groupPriorities, groupFirstIndices, nIndices, onGroupUploaded);
+        }
+        else
+        {
+            SubmitIndexUploads<uint32_t>(m_indexBuffer, modelGroups, groupPriorities, groupFirstIndices, nIndices, onGroupUploaded);
+        }
+
+        // Indirect draws take their model matrix per instance, with each draw's baseInstance selecting its own
+        m_multiDrawIndirect = GLEW_VERSION_4_3 || (GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance);
+        if (m_multiDrawIndirect)
+        {
+            glGenBuffers(1, &m_transformBuffer);
+            glBindBuffer(GL_ARRAY_BUFFER, m_transformBuffer);
+            for (GLuint column = 0; column < 4; ++column)
+            {
+                glVertexAttribPointer(TRANSFORM_ATTRIBUTE_LOCATION + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void *) (column * sizeof(glm::vec4)));
+                glVertexAttribDivisor(TRANSFORM_ATTRIBUTE_LOCATION + column, 1);
+                glEnableVertexAttribArray(TRANSFORM_ATTRIBUTE_LOCATION + column);
+            }
+            glGenBuffers(1, &m_indirectBuffer);
+        }
+        LOG(INFO) << "Track geometry will be drawn with " << (m_multiDrawIndirect ? "glMultiDrawElementsIndirect" : "glDrawElementsBaseVertex per model");
+        // Lets not affect any state
+        glBindVertexArray(0);
+    }
+
+    for (size_t modelIdx = 0; modelIdx < trackModels.size(); ++modelIdx)
+    {
+        trackModels[modelIdx]->SetDrawRange(m_vertexArrayID, m_indexType, drawRanges[modelIdx]);
+    }
+}
+
+void TrackGeometryPool::PrepareDraws(const std::vector<const Entity *> &mainEntities, const std::vector<const Entity *> &shadowEntities)
+{
+    m_drawCommands.clear();
+    m_drawTransforms.clear();
+    const std::vector<const Entity *> *passEntities[N_TRACK_DRAW_PASSES] = {&mainEntities, &shadowEntities};
+    for (uint8_t pass = 0; pass < N_TRACK_DRAW_PASSES; ++pass)
+    {
+        m_passFirstDraw[pass] = m_drawCommands.size();
+        for (auto &entity : *passEntities[pass])
+        {
+            const TrackModel *trackModel = boost::get<TrackModel>(&entity->raw);
+            if (trackModel == nullptr || !trackModel->enabled || trackModel->GetDrawRange().nIndices == 0 || !m_groupResident[trackModel->GetDrawRange().group])
+            {
+                continue;
+            }
+            const TrackDrawRange &drawRange = trackModel->GetDrawRange();
+            m_drawCommands.push_back({drawRange.nIndices, 1, drawRange.firstIndex, drawRange.baseVertex, static_cast<GLuint>(m_drawCommands.size())});
+            m_drawTransforms.push_back(trackModel->ModelMatrix);
+        }
+    }
+    m_passFirstDraw[N_TRACK_DRAW_PASSES] = m_drawCommands.size();
+
+    if (m_multiDrawIndirect && !m_drawCommands.empty())
+    {
+        // Orphan last frame's storage rather than wait on draws that may still be reading it
+        glBindBuffer(GL_ARRAY_BUFFER, m_transformBuffer);
+        glBufferData(GL_ARRAY_BUFFER, m_drawTransforms.size() * sizeof(glm::mat4), m_drawTransforms.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, m_drawCommands.size() * sizeof(DrawElementsIndirectCommand), m_drawCommands.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+}
+
+void TrackGeometryPool::Draw(TrackDrawPass pass) const
+{
+    size_t firstDraw = m_passFirstDraw[pass];
+    size_t nDraws    = m_passFirstDraw[pass + 1] - firstDraw;
+    if (m_vertexArrayID == 0 || nDraws == 0)
+        return;
+
+    glBindVertexArray(m_vertexArrayID);
+    if (m_multiDrawIndirect)
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, m_indexType, (void *) (firstDraw * sizeof(DrawElementsIndirectCommand)), (GLsizei) nDraws, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+    else
+    {
+        size_t indexSize = m_indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+        for (size_t drawIdx = firstDraw; drawIdx < firstDraw + nDraws; ++drawIdx)
+        {
+            const DrawElementsIndirectCommand &drawCommand = m_drawCommands[drawIdx];
+            VertexFormat::LoadConstantTransform(m_drawTransforms[drawIdx]);
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei) drawCommand.count, m_indexType, (void *) (drawCommand.firstIndex * indexSize), drawCommand.baseVertex);
+        }
+    }
+    glBindVertexArray(0);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <GL/glew.h>
+
+#include "Entity.h"
+#include "Models/TrackModel.h"
+#include "../Renderer/UploadManager.h"
+
+// Layout glMultiDrawElementsIndirect reads its draws in
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// Each pass draws its own list of entities, prepared together each frame
+enum TrackDrawPass : uint8_t
+{
+    MAIN_PASS = 0,
+    SHADOW_PASS,
+    N_TRACK_DRAW_PASSES
+};
+
+// All of a track's static geometry, suballocated from one interleaved vertex buffer and one index buffer behind a single vertex array. Each
+// TrackModel keeps only its TrackDrawRange, so any set of them can be drawn at once: with a single glMultiDrawElementsIndirect where the driver
+// supports it (GL 4.3 or ARB_multi_draw_indirect), else with a glDrawElementsBaseVertex per model from the same bound state. Models are uploaded
+// in groups through the UploadManager, and are left out of the draws until their group's geometry is up.
+class TrackGeometryPool
+{
+public:
+    TrackGeometryPool() = default;
+    ~TrackGeometryPool();
+    TrackGeometryPool(const TrackGeometryPool &) = delete;
+    TrackGeometryPool &operator=(const TrackGeometryPool &) = delete;
+
+    // Packs the models' welded geometry into the pool and points each of them at its range. Each group's models are uploaded together, at that
+    // group's priority. Without a GL context, only the ranges are assigned.
+    void Build(const std::vector<std::vector<TrackModel *>> &modelGroups, const std::vector<UploadPriority> &groupPriorities);
+    // Builds the draws and model matrices for this frame's entities in each pass, which every following Draw of that pass then renders
+    void PrepareDraws(const std::vector<const Entity *> &mainEntities, const std::vector<const Entity *> &shadowEntities);
+    void Draw(TrackDrawPass pass) const;
+
+    size_t nVertices = 0;
+    size_t nIndices  = 0;
+
+private:
+    GLuint m_vertexArrayID   = 0;
+    GLuint m_vertexBuffer    = 0;
+    GLuint m_indexBuffer     = 0;
+    GLuint m_transformBuffer = 0;
+    GLuint m_indirectBuffer  = 0;
+    GLenum m_indexType       = GL_UNSIGNED_INT;
+    bool m_multiDrawIndirect = false;
+
+    // Kept between frames so that steady state preparation doesn't allocate
+    std::vector<DrawElementsIndirectCommand> m_drawCommands;
+    std::vector<glm::mat4> m_drawTransforms;
+    // Passes' draws are back to back in m_drawCommands, pass i's starting at m_passFirstDraw[i]
+    size_t m_passFirstDraw[N_TRACK_DRAW_PASSES + 1] = {};
+    // Set once the group's vertices and indices have both been uploaded
+    std::vector<uint8_t> m_groupResident;
+};
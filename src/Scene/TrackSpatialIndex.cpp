@@ -0,0 +1,172 @@
+#include "TrackSpatialIndex.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+    const float TARGET_POINTS_PER_CELL = 2.f;
+    // Caps the grid at 256x256 cells however the points are spread
+    const float MAX_CELLS_PER_AXIS = 256.f;
+    const uint32_t NO_POINT        = UINT32_MAX;
+
+    float DistanceSquared(const glm::vec3 &a, const glm::vec3 &b)
+    {
+        glm::vec3 delta = a - b;
+        return glm::dot(delta, delta);
+    }
+} // namespace
+
+void NearestPointGrid::Build(const std::vector<glm::vec3> &points)
+{
+    m_points = points;
+    m_cellStarts.clear();
+    m_cellPoints.clear();
+    m_nCellsX = 0;
+    m_nCellsZ = 0;
+    if (points.empty())
+    {
+        return;
+    }
+
+    glm::vec2 gridMax(-FLT_MAX);
+    m_gridMin = glm::vec2(FLT_MAX);
+    for (auto &point : points)
+    {
+        m_gridMin = glm::min(m_gridMin, glm::vec2(point.x, point.z));
+        gridMax   = glm::max(gridMax, glm::vec2(point.x, point.z));
+    }
+    glm::vec2 extent = gridMax - m_gridMin;
+    m_cellSize       = std::sqrt(std::max(extent.x, 1.f) * std::max(extent.y, 1.f) * TARGET_POINTS_PER_CELL / points.size());
+    m_cellSize       = std::max({m_cellSize, extent.x / MAX_CELLS_PER_AXIS, extent.y / MAX_CELLS_PER_AXIS, FLT_MIN});
+    m_nCellsX        = std::min(static_cast<int32_t>(extent.x / m_cellSize), static_cast<int32_t>(MAX_CELLS_PER_AXIS) - 1) + 1;
+    m_nCellsZ        = std::min(static_cast<int32_t>(extent.y / m_cellSize), static_cast<int32_t>(MAX_CELLS_PER_AXIS) - 1) + 1;
+
+    // Counting sort of the points into their cells
+    auto cellOf = [&](const glm::vec3 &point) {
+        int32_t cellX = std::min(static_cast<int32_t>((point.x - m_gridMin.x) / m_cellSize), m_nCellsX - 1);
+        int32_t cellZ = std::min(static_cast<int32_t>((point.z - m_gridMin.y) / m_cellSize), m_nCellsZ - 1);
+        return cellZ * m_nCellsX + cellX;
+    };
+    m_cellStarts.assign(m_nCellsX * m_nCellsZ + 1, 0);
+    for (auto &point : points)
+    {
+        ++m_cellStarts[cellOf(point) + 1];
+    }
+    for (size_t cellIdx = 1; cellIdx < m_cellStarts.size(); ++cellIdx)
+    {
+        m_cellStarts[cellIdx] += m_cellStarts[cellIdx - 1];
+    }
+    std::vector<uint32_t> cellFill(m_cellStarts.begin(), m_cellStarts.end() - 1);
+    m_cellPoints.resize(points.size());
+    for (uint32_t pointIdx = 0; pointIdx < points.size(); ++pointIdx)
+    {
+        m_cellPoints[cellFill[cellOf(points[pointIdx])]++] = pointIdx;
+    }
+}
+
+uint32_t NearestPointGrid::GetNearest(const glm::vec3 &position, uint32_t hint) const
+{
+    if (m_points.empty())
+    {
+        return hint;
+    }
+
+    uint32_t nearestIdx    = NO_POINT;
+    float nearestDistance2 = FLT_MAX;
+    if (hint < m_points.size())
+    {
+        nearestIdx       = hint;
+        nearestDistance2 = DistanceSquared(position, m_points[hint]);
+    }
+    auto searchCell = [&](int32_t cellX, int32_t cellZ) {
+        uint32_t cellIdx = cellZ * m_nCellsX + cellX;
+        for (uint32_t cellPointIdx = m_cellStarts[cellIdx]; cellPointIdx < m_cellStarts[cellIdx + 1]; ++cellPointIdx)
+        {
+            uint32_t pointIdx = m_cellPoints[cellPointIdx];
+            float distance2   = DistanceSquared(position, m_points[pointIdx]);
+            if (distance2 < nearestDistance2 || (distance2 == nearestDistance2 && pointIdx < nearestIdx))
+            {
+                nearestIdx       = pointIdx;
+                nearestDistance2 = distance2;
+            }
+        }
+    };
+
+    // Positions off the grid search outward from the nearest cell on its edge
+    float gridX     = (position.x - m_gridMin.x) / m_cellSize;
+    float gridZ     = (position.z - m_gridMin.y) / m_cellSize;
+    int32_t centreX = static_cast<int32_t>(std::max(0.f, std::min(gridX, m_nCellsX - 1.f)));
+    int32_t centreZ = static_cast<int32_t>(std::max(0.f, std::min(gridZ, m_nCellsZ - 1.f)));
+    int32_t maxRing = std::max(m_nCellsX, m_nCellsZ);
+    for (int32_t ring = 0; ring <= maxRing; ++ring)
+    {
+        // The rings searched so far cover a square of cells around the centre one, so everything left is at least as far away on the ground
+        // plane as the nearest edge of that square. Off the grid, at least as far as the rings in between.
+        float edgeDistance = std::min({gridX - (centreX - ring + 1), (centreX + ring) - gridX, gridZ - (centreZ - ring + 1), (centreZ + ring) - gridZ});
+        float ringDistance = std::max(edgeDistance, ring - 1.f) * m_cellSize;
+        if (ring > 0 && ringDistance * ringDistance > nearestDistance2)
+        {
+            break;
+        }
+        for (int32_t cellZ = std::max(centreZ - ring, 0); cellZ <= std::min(centreZ + ring, m_nCellsZ - 1); ++cellZ)
+        {
+            if (std::abs(cellZ - centreZ) == ring)
+            {
+                for (int32_t cellX = std::max(centreX - ring, 0); cellX <= std::min(centreX + ring, m_nCellsX - 1); ++cellX)
+                {
+                    searchCell(cellX, cellZ);
+                }
+            }
+            else
+            {
+                if (centreX - ring >= 0)
+                {
+                    searchCell(centreX - ring, cellZ);
+                }
+                if (centreX + ring < m_nCellsX)
+                {
+                    searchCell(centreX + ring, cellZ);
+                }
+            }
+        }
+    }
+
+    return nearestIdx;
+}
+
+void TrackSpatialIndex::Build(const std::vector<OpenNFS::TrackBlock> &trackBlocks, const std::vector<VirtualRoad> &virtualRoad)
+{
+    std::vector<glm::vec3> trackblockPositions;
+    m_trackblockIDs.clear();
+    for (auto &trackBlock : trackBlocks)
+    {
+        trackblockPositions.emplace_back(trackBlock.position);
+        m_trackblockIDs.emplace_back(trackBlock.id);
+    }
+    m_trackblockGrid.Build(trackblockPositions);
+
+    std::vector<glm::vec3> vroadPositions;
+    for (auto &vroadNode : virtualRoad)
+    {
+        vroadPositions.emplace_back(vroadNode.position);
+    }
+    m_vroadGrid.Build(vroadPositions);
+}
+
+uint32_t TrackSpatialIndex::GetNearestTrackblockID(const glm::vec3 &position, uint32_t hintTrackblockID) const
+{
+    if (m_trackblockIDs.empty())
+    {
+        return hintTrackblockID;
+    }
+    // Trackblock IDs are their index on every track we load, but only trust the hint if that holds
+    uint32_t hintIdx = hintTrackblockID < m_trackblockIDs.size() && m_trackblockIDs[hintTrackblockID] == hintTrackblockID ? hintTrackblockID : NO_POINT;
+    return m_trackblockIDs[m_trackblockGrid.GetNearest(position, hintIdx)];
+}
+
+uint32_t TrackSpatialIndex::GetNearestVroadID(const glm::vec3 &position, uint32_t hintVroadID) const
+{
+    return m_vroadGrid.GetNearest(position, hintVroadID);
+}
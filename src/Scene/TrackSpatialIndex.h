@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "TrackBlock.h"
+#include "VirtualRoad.h"
+
+// Uniform grid over a fixed set of points on the ground (XZ) plane, for exact nearest point queries. Cells are sized to hold a couple of points
+// each, and searched in rings outward from the query's cell until no closer point can remain.
+class NearestPointGrid
+{
+public:
+    NearestPointGrid() = default;
+
+    void Build(const std::vector<glm::vec3> &points);
+    // Index of the point closest to position, in 3D, with ties going to the lowest index. A valid hint, such as the previous answer for something
+    // that moves, bounds the search from the start, so small moves only look at the cells right around position. Returns hint if there are no points.
+    uint32_t GetNearest(const glm::vec3 &position, uint32_t hint) const;
+
+private:
+    std::vector<glm::vec3> m_points;
+    // Points bucketed by cell, cell (x, z)'s being m_cellPoints[m_cellStarts[z * m_nCellsX + x]] up to the next cell's start
+    std::vector<uint32_t> m_cellStarts;
+    std::vector<uint32_t> m_cellPoints;
+    glm::vec2 m_gridMin;
+    float m_cellSize  = 1.f;
+    int32_t m_nCellsX = 0;
+    int32_t m_nCellsZ = 0;
+};
+
+// Answers which trackblock and which virtual road node something is nearest to, in place of scanning all of them
+class TrackSpatialIndex
+{
+public:
+    TrackSpatialIndex() = default;
+
+    void Build(const std::vector<OpenNFS::TrackBlock> &trackBlocks, const std::vector<VirtualRoad> &virtualRoad);
+    // Hints are the last IDs returned for the same object, if any
+    uint32_t GetNearestTrackblockID(const glm::vec3 &position, uint32_t hintTrackblockID) const;
+    uint32_t GetNearestVroadID(const glm::vec3 &position, uint32_t hintVroadID) const;
+
+private:
+    NearestPointGrid m_trackblockGrid;
+    NearestPointGrid m_vroadGrid;
+    std::vector<uint32_t> m_trackblockIDs;
+};
@@ -18,9 +18,8 @@ void DepthShader::bindAttributes()
 
 void DepthShader::getAllUniformLocations()
 {
-    lightSpaceMatrixLocation     = getUniformLocation("lightSpaceMatrix");
-    transformationMatrixLocation = getUniformLocation("transformationMatrix");
-    textureArrayLocation         = getUniformLocation("textureArray");
+    lightSpaceMatrixLocation = getUniformLocation("lightSpaceMatrix");
+    textureArrayLocation     = getUniformLocation("textureArray");
 }
 
 void DepthShader::customCleanup()
@@ -41,5 +40,6 @@ void DepthShader::loadLightSpaceMatrix(const glm::mat4 &lightSpaceMatrix)
 
 void DepthShader::loadTransformMatrix(const glm::mat4 &transformationMatrix)
 {
-    loadMat4(transformationMatrixLocation, &transformationMatrix[0][0]);
+    // An attribute rather than a uniform, so that the track can stream one per draw
+    VertexFormat::LoadConstantTransform(transformationMatrix);
 }
\ No newline at end of file
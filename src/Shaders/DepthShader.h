@@ -3,6 +3,7 @@
 #include "BaseShader.h"
 #include "../Util/Utils.h"
 #include "../Scene/Lights/LightModel.h"
+#include "../Scene/Models/VertexFormat.h"
 
 class DepthShader : public BaseShader
 {
@@ -18,7 +19,6 @@ protected:
     void customCleanup() override;
 
     GLint lightSpaceMatrixLocation;
-    GLint transformationMatrixLocation;
     GLint textureArrayLocation;
 
     typedef BaseShader super;
@@ -22,16 +22,15 @@ void TrackShader::bindAttributes()
 void TrackShader::getAllUniformLocations()
 {
     // Get handles for uniforms
-    transformationMatrixLocation = getUniformLocation("transformationMatrix");
-    projectionMatrixLocation     = getUniformLocation("projectionMatrix");
-    viewMatrixLocation           = getUniformLocation("viewMatrix");
-    lightSpaceMatrixLocation     = getUniformLocation("lightSpaceMatrix");
-    trackTextureArrayLocation    = getUniformLocation("textureArray");
-    shineDamperLocation          = getUniformLocation("shineDamper");
-    reflectivityLocation         = getUniformLocation("reflectivity");
-    useClassicLocation           = getUniformLocation("useClassic");
-    shadowMapTextureLocation     = getUniformLocation("shadowMap");
-    ambientFactorLocation        = getUniformLocation("ambientFactor");
+    projectionMatrixLocation  = getUniformLocation("projectionMatrix");
+    viewMatrixLocation        = getUniformLocation("viewMatrix");
+    lightSpaceMatrixLocation  = getUniformLocation("lightSpaceMatrix");
+    trackTextureArrayLocation = getUniformLocation("textureArray");
+    shineDamperLocation       = getUniformLocation("shineDamper");
+    reflectivityLocation      = getUniformLocation("reflectivity");
+    useClassicLocation        = getUniformLocation("useClassic");
+    shadowMapTextureLocation  = getUniformLocation("shadowMap");
+    ambientFactorLocation     = getUniformLocation("ambientFactor");
 
     for (int i = 0; i < MAX_TRACK_CONTRIB_LIGHTS; ++i)
     {
@@ -102,7 +101,8 @@ void TrackShader::loadProjectionViewMatrices(const glm::mat4 &projection, const
 
 void TrackShader::loadTransformMatrix(const glm::mat4 &transformation)
 {
-    loadMat4(transformationMatrixLocation, &transformation[0][0]);
+    // An attribute rather than a uniform, so that TrackGeometryPool can stream one per draw
+    VertexFormat::LoadConstantTransform(transformation);
 }
 
 void TrackShader::loadLightSpaceMatrix(const glm::mat4 &lightSpaceMatrix)
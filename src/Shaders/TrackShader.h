@@ -28,7 +28,6 @@ protected:
     void bindAttributes() override;
     void getAllUniformLocations() override;
     void customCleanup() override;
-    GLint transformationMatrixLocation;
     GLint projectionMatrixLocation;
     GLint viewMatrixLocation;
     GLint lightSpaceMatrixLocation;
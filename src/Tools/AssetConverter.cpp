@@ -0,0 +1,228 @@
+#define TINYOBJLOADER_IMPLEMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "../Config.h"
+#include "../Util/Logger.h"
+#include "../Util/ThreadPool.h"
+#include "../Loaders/AssetCatalogue.h"
+#include "../Loaders/TrackLoader.h"
+#include "../Loaders/CarLoader.h"
+#include "ObjExporter.h"
+
+using namespace boost::program_options;
+
+// Headless batch conversion of every track and car OpenNFS can see in its resources directory. Loading an asset is what bakes its caches
+// (the NFS3 .onfs track cache, extracted NFS2 textures, compressed texture arrays etc.), optionally the loaded geometry is also exported to OBJ.
+// Runs without a GL context.
+namespace
+{
+    struct ConversionJob
+    {
+        NFSVer nfsVersion;
+        std::string assetName;
+        bool isTrack;
+        double loadMs   = 0;
+        double exportMs = 0;
+        bool succeeded  = false;
+    };
+
+    struct ConverterOptions
+    {
+        std::vector<std::string> nfsVersions;
+        std::string objOutputPath;
+        bool tracksOnly   = false;
+        bool carsOnly     = false;
+        uint32_t nWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+    };
+
+    bool IsLoadable(NFSVer nfsVersion)
+    {
+        // Those that TrackLoader and CarLoader currently handle
+        return nfsVersion == NFS_2 || nfsVersion == NFS_2_SE || nfsVersion == NFS_2_PS1 || nfsVersion == NFS_3 || nfsVersion == NFS_3_PS1;
+    }
+
+    bool UsesFshtool(NFSVer nfsVersion)
+    {
+        // fshtool keeps its state in globals and changes the process working directory, so PC NFS2 QFS extraction can't overlap any other load
+        return nfsVersion == NFS_2 || nfsVersion == NFS_2_SE;
+    }
+
+    double MsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void Convert(ConversionJob &job, const ConverterOptions &options)
+    {
+        std::string assetType = job.isTrack ? "track" : "car";
+        std::string objPath   = options.objOutputPath + "/" + ToString(job.nfsVersion) + "/" + assetType + "s/" + job.assetName + ".obj";
+
+        // Loaders ASSERT on assets they can't handle, which throws when headless, so one bad asset fails only its own conversion
+        auto loadStart = std::chrono::steady_clock::now();
+        try
+        {
+            if (job.isTrack)
+            {
+                auto track = TrackLoader::LoadTrack(job.nfsVersion, job.assetName);
+                job.loadMs = MsSince(loadStart);
+                if (!options.objOutputPath.empty())
+                {
+                    auto exportStart = std::chrono::steady_clock::now();
+                    job.succeeded    = ObjExporter::ExportTrack(track, objPath);
+                    job.exportMs     = MsSince(exportStart);
+                }
+                else
+                {
+                    job.succeeded = track != nullptr;
+                }
+            }
+            else
+            {
+                auto car   = CarLoader::LoadCar(job.nfsVersion, job.assetName);
+                job.loadMs = MsSince(loadStart);
+                if (!options.objOutputPath.empty())
+                {
+                    auto exportStart = std::chrono::steady_clock::now();
+                    job.succeeded    = ObjExporter::ExportCar(car, objPath);
+                    job.exportMs     = MsSince(exportStart);
+                }
+                else
+                {
+                    job.succeeded = car != nullptr;
+                }
+            }
+        }
+        catch (std::exception &e)
+        {
+            job.loadMs    = job.loadMs > 0 ? job.loadMs : MsSince(loadStart);
+            job.succeeded = false;
+            LOG(WARNING) << "Failed to convert " << ToString(job.nfsVersion) << " " << assetType << " " << job.assetName << ": " << e.what();
+        }
+
+        LOG(INFO) << "Converted " << ToString(job.nfsVersion) << " " << assetType << " " << job.assetName << " (load " << job.loadMs << "ms, export " << job.exportMs
+                  << "ms)" << (job.succeeded ? "" : " FAILED");
+    }
+
+    // Runs the jobs with at most nWorkers in flight at once. The loaders' own ParallelFor work shares the same pool.
+    void ConvertAll(std::vector<ConversionJob *> &jobs, const ConverterOptions &options, uint32_t nWorkers)
+    {
+        std::atomic<size_t> nextJobIdx{0};
+        ThreadPool::Get().ParallelFor(std::min<size_t>(nWorkers, jobs.size()), [&](size_t) {
+            size_t jobIdx;
+            while ((jobIdx = nextJobIdx++) < jobs.size())
+            {
+                Convert(*jobs[jobIdx], options);
+            }
+        });
+    }
+
+    bool ParseCommandLine(int argc, char **argv, ConverterOptions &options)
+    {
+        options_description desc("Converts every track and car found in " + RESOURCE_PATH + " without a window. Allowed options");
+        desc.add_options()("help,h", "Print converter command-line parameters")(
+          "nfs", value(&options.nfsVersions)->multitoken(), "Only convert these NFS versions (NFS_2, NFS_2_SE, NFS_2_PS1, NFS_3, NFS_3_PS1), default all")(
+          "obj", value(&options.objOutputPath), "Also export the loaded geometry as OBJ under this directory")("tracks", bool_switch(&options.tracksOnly), "Only convert tracks")(
+          "cars", bool_switch(&options.carsOnly), "Only convert cars")("jobs,j", value(&options.nWorkers), "Maximum number of assets to convert at once");
+
+        try
+        {
+            variables_map vm;
+            store(parse_command_line(argc, argv, desc), vm);
+            notify(vm);
+            if (vm.count("help"))
+            {
+                std::cout << desc << "\n";
+                return false;
+            }
+        }
+        catch (std::exception &e)
+        {
+            std::cerr << e.what() << "\n" << desc << "\n";
+            return false;
+        }
+        options.nWorkers = std::max(options.nWorkers, 1u);
+
+        return true;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    ConverterOptions options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+    // No GL context: models and texture arrays keep their CPU side data only
+    Config::get().headless = true;
+    std::shared_ptr<Logger> logger = std::make_shared<Logger>();
+
+    boost::filesystem::create_directories(CAR_PATH);
+    boost::filesystem::create_directories(TRACK_PATH);
+
+    AssetCatalogue assetCatalogue = AssetCatalogue::Open(RESOURCE_PATH);
+    std::vector<ConversionJob> jobs;
+    for (auto &installedNFS : assetCatalogue.GetInstalledNFS())
+    {
+        if (!options.nfsVersions.empty() && std::find(options.nfsVersions.begin(), options.nfsVersions.end(), ToString(installedNFS.tag)) == options.nfsVersions.end())
+        {
+            continue;
+        }
+        if (!IsLoadable(installedNFS.tag))
+        {
+            LOG(WARNING) << "Skipping " << ToString(installedNFS.tag) << ", not yet supported by the loaders";
+            continue;
+        }
+        if (!options.carsOnly)
+        {
+            for (auto &track : installedNFS.tracks)
+            {
+                jobs.push_back({installedNFS.tag, track, true});
+            }
+        }
+        if (!options.tracksOnly)
+        {
+            for (auto &car : installedNFS.cars)
+            {
+                jobs.push_back({installedNFS.tag, car, false});
+            }
+        }
+    }
+    LOG(INFO) << "Converting " << jobs.size() << " assets with up to " << options.nWorkers << " at once";
+
+    std::vector<ConversionJob *> serialJobs, parallelJobs;
+    for (auto &job : jobs)
+    {
+        (UsesFshtool(job.nfsVersion) ? serialJobs : parallelJobs).push_back(&job);
+    }
+    auto conversionStart = std::chrono::steady_clock::now();
+    ConvertAll(serialJobs, options, 1);
+    ConvertAll(parallelJobs, options, options.nWorkers);
+    double conversionMs = MsSince(conversionStart);
+
+    // Per asset timings, slowest first
+    std::sort(jobs.begin(), jobs.end(), [](const ConversionJob &a, const ConversionJob &b) { return a.loadMs + a.exportMs > b.loadMs + b.exportMs; });
+    size_t nFailed = 0;
+    std::cout << std::left << std::setw(10) << "Version" << std::setw(7) << "Type" << std::setw(32) << "Asset" << std::right << std::setw(12) << "Load (ms)" << std::setw(14)
+              << "Export (ms)" << "\n";
+    for (auto &job : jobs)
+    {
+        nFailed += job.succeeded ? 0 : 1;
+        std::cout << std::left << std::setw(10) << ToString(job.nfsVersion) << std::setw(7) << (job.isTrack ? "track" : "car") << std::setw(32) << job.assetName << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(12) << job.loadMs << std::setw(14) << job.exportMs << (job.succeeded ? "" : "  FAILED") << "\n";
+    }
+    std::cout << jobs.size() << " assets converted in " << conversionMs / 1000.0 << "s, " << nFailed << " failed" << std::endl;
+
+    return nFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,114 @@
+#include "ObjExporter.h"
+
+#include <boost/filesystem.hpp>
+
+bool ObjExporter::ExportTrack(const std::shared_ptr<Track> &track, const std::string &objPath)
+{
+    boost::filesystem::create_directories(boost::filesystem::path(objPath).parent_path());
+    std::ofstream obj(objPath, std::ios::out);
+    if (!obj.is_open())
+    {
+        return false;
+    }
+    obj << "# " << ToString(track->nfsVersion) << " track " << track->name << ", exported by OpenNFS " << ONFS_VERSION << "\n";
+
+    ObjIndices objIndices;
+    for (auto &trackBlock : track->trackBlocks)
+    {
+        std::string blockName = "block" + std::to_string(trackBlock.id);
+        _WriteEntities(obj, trackBlock.track, blockName + "_road", objIndices);
+        _WriteEntities(obj, trackBlock.objects, blockName + "_object", objIndices);
+        _WriteEntities(obj, trackBlock.lanes, blockName + "_lane", objIndices);
+    }
+    _WriteEntities(obj, track->globalObjects, "global_object", objIndices);
+
+    return obj.good();
+}
+
+bool ObjExporter::ExportCar(const std::shared_ptr<Car> &car, const std::string &objPath)
+{
+    boost::filesystem::create_directories(boost::filesystem::path(objPath).parent_path());
+    std::ofstream obj(objPath, std::ios::out);
+    if (!obj.is_open())
+    {
+        return false;
+    }
+    obj << "# " << ToString(car->tag) << " car " << car->id << " (" << car->name << "), exported by OpenNFS " << ONFS_VERSION << "\n";
+
+    ObjIndices objIndices;
+    for (auto &carModel : car->assetData.meshes)
+    {
+        _WriteModel(obj, carModel, nullptr, carModel.m_name, objIndices);
+    }
+
+    return obj.good();
+}
+
+void ObjExporter::_WriteModel(std::ofstream &obj, const Model &model, const std::vector<uint32_t> *vertexIndices, const std::string &objectName, ObjIndices &objIndices)
+{
+    // Models keep their vertices relative to their centre, place them as the renderer would
+    glm::mat4 rotationMatrix = glm::toMat4(model.orientation);
+    glm::mat4 modelMatrix    = glm::translate(glm::mat4(1.0), model.position) * rotationMatrix;
+    // Not every loader fills UVs and normals per vertex, only export them where they line up
+    bool hasUVs     = model.m_uvs.size() == model.m_vertices.size();
+    bool hasNormals = model.m_normals.size() == model.m_vertices.size();
+
+    obj << "o " << objectName << "\n";
+    for (auto &vertex : model.m_vertices)
+    {
+        glm::vec3 worldVertex = glm::vec3(modelMatrix * glm::vec4(vertex, 1.0f));
+        obj << "v " << worldVertex.x << " " << worldVertex.y << " " << worldVertex.z << "\n";
+    }
+    if (hasUVs)
+    {
+        for (auto &uv : model.m_uvs)
+        {
+            obj << "vt " << uv.x << " " << uv.y << "\n";
+        }
+    }
+    if (hasNormals)
+    {
+        for (auto &normal : model.m_normals)
+        {
+            glm::vec3 worldNormal = glm::vec3(rotationMatrix * glm::vec4(normal, 0.0f));
+            obj << "vn " << worldNormal.x << " " << worldNormal.y << " " << worldNormal.z << "\n";
+        }
+    }
+
+    // Without indices the vertices are de-indexed, so every 3 make a triangle
+    size_t nCorners = vertexIndices != nullptr ? vertexIndices->size() : model.m_vertices.size();
+    for (size_t triangleIdx = 0; triangleIdx + 2 < nCorners; triangleIdx += 3)
+    {
+        obj << "f";
+        for (size_t cornerIdx = 0; cornerIdx < 3; ++cornerIdx)
+        {
+            size_t vertexIdx = vertexIndices != nullptr ? (*vertexIndices)[triangleIdx + cornerIdx] : triangleIdx + cornerIdx;
+            obj << " " << objIndices.vertex + vertexIdx;
+            if (hasNormals)
+            {
+                obj << "/" << (hasUVs ? std::to_string(objIndices.uv + vertexIdx) : "") << "/" << objIndices.normal + vertexIdx;
+            }
+            else if (hasUVs)
+            {
+                obj << "/" << objIndices.uv + vertexIdx;
+            }
+        }
+        obj << "\n";
+    }
+    objIndices.vertex += model.m_vertices.size();
+    objIndices.uv += hasUVs ? model.m_uvs.size() : 0;
+    objIndices.normal += hasNormals ? model.m_normals.size() : 0;
+}
+
+void ObjExporter::_WriteEntities(std::ofstream &obj, const std::vector<Entity> &entities, const std::string &groupName, ObjIndices &objIndices)
+{
+    for (auto &entity : entities)
+    {
+        const TrackModel *trackModel = boost::get<TrackModel>(&entity.raw);
+        if (trackModel == nullptr || trackModel->m_vertices.empty())
+        {
+            continue;
+        }
+        _WriteModel(obj, *trackModel, &trackModel->m_vertexIndices, groupName + std::to_string(entity.entityID), objIndices);
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "../Scene/Track.h"
+#include "../Physics/Car.h"
+
+// Writes loaded ONFS geometry out as Wavefront OBJ, one object per mesh, in world space. Materials are not exported.
+class ObjExporter
+{
+public:
+    static bool ExportTrack(const std::shared_ptr<Track> &track, const std::string &objPath);
+    static bool ExportCar(const std::shared_ptr<Car> &car, const std::string &objPath);
+
+private:
+    // Running (1-based) OBJ indices, which count independently for each element type across the whole file
+    struct ObjIndices
+    {
+        size_t vertex = 1;
+        size_t uv     = 1;
+        size_t normal = 1;
+    };
+
+    // Appends a triangle mesh, indexed by vertexIndices if given (welded track models), else de-indexed
+    static void _WriteModel(std::ofstream &obj, const Model &model, const std::vector<uint32_t> *vertexIndices, const std::string &objectName, ObjIndices &objIndices);
+    static void _WriteEntities(std::ofstream &obj, const std::vector<Entity> &entities, const std::string &groupName, ObjIndices &objIndices);
+};
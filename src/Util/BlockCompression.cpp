@@ -0,0 +1,510 @@
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLOCK_COMPRESSION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    const uint32_t N_BLOCK_TEXELS = 16;
+    // BC1 texels at or above this alpha are opaque
+    const uint8_t BC1_ALPHA_THRESHOLD = 128;
+    const uint8_t TRANSPARENT_INDEX   = 3;
+    // Power iterations to find the principal axis of a block's colours, converges well before this for 16 texels
+    const int N_AXIS_ITERATIONS = 8;
+
+    inline uint16_t ReadColour(const uint8_t *colourBlock, int endpointIdx)
+    {
+        return static_cast<uint16_t>(colourBlock[2 * endpointIdx] | (colourBlock[2 * endpointIdx + 1] << 8));
+    }
+
+    // RGB565 to RGBA8 packed little endian (red in the low byte) with zero alpha, replicating the top bits down as GPUs do
+    inline uint32_t Expand565(uint16_t colour)
+    {
+        uint32_t red   = (colour >> 11) & 0x1F;
+        uint32_t green = (colour >> 5) & 0x3F;
+        uint32_t blue  = colour & 0x1F;
+        return ((red << 3) | (red >> 2)) | (((green << 2) | (green >> 4)) << 8) | (((blue << 3) | (blue >> 2)) << 16);
+    }
+
+    inline uint16_t Quantise565(const float *rgb)
+    {
+        auto quantise = [](float channel, int maxValue) {
+            return static_cast<uint16_t>(std::lround(std::min(std::max(channel, 0.f), 255.f) * maxValue / 255.f));
+        };
+        return static_cast<uint16_t>((quantise(rgb[0], 31) << 11) | (quantise(rgb[1], 63) << 5) | quantise(rgb[2], 31));
+    }
+
+    inline uint32_t Channel(uint32_t colour, int channelIdx)
+    {
+        return (colour >> (8 * channelIdx)) & 0xFF;
+    }
+
+    inline uint32_t Blend(uint32_t colour0, uint32_t colour1, uint32_t weight0, uint32_t weight1)
+    {
+        uint32_t blended = 0;
+        for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+        {
+            blended |= ((Channel(colour0, channelIdx) * weight0 + Channel(colour1, channelIdx) * weight1) / (weight0 + weight1)) << (8 * channelIdx);
+        }
+        return blended;
+    }
+
+    // The colours a block's 2 bit indices select, as the decoder builds them. Four colour blocks interpolate thirds between the endpoints, three
+    // colour blocks (BC1 with the first endpoint not above the second) have a midpoint and transparent black.
+    inline void BuildPalette(uint16_t colour0, uint16_t colour1, bool fourColour, uint32_t *palette)
+    {
+        palette[0] = Expand565(colour0);
+        palette[1] = Expand565(colour1);
+        if (fourColour)
+        {
+            palette[2] = Blend(palette[0], palette[1], 2, 1);
+            palette[3] = Blend(palette[0], palette[1], 1, 2);
+        }
+        else
+        {
+            palette[2] = Blend(palette[0], palette[1], 1, 1);
+            palette[3] = 0;
+        }
+    }
+
+    inline uint32_t ColourDistance(uint32_t colour0, uint32_t colour1)
+    {
+        uint32_t distance = 0;
+        for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+        {
+            int32_t delta = static_cast<int32_t>(Channel(colour0, channelIdx)) - static_cast<int32_t>(Channel(colour1, channelIdx));
+            distance += delta * delta;
+        }
+        return distance;
+    }
+
+    // Picks the closest of the first nColours palette entries for each texel, texels and palette having zeroed alpha. Ties go to the lower index.
+    void SelectIndices(const uint32_t *texels, const uint32_t *palette, uint32_t nColours, uint8_t *indices, uint32_t *errors)
+    {
+#if defined(BLOCK_COMPRESSION_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; texelIdx += 4)
+        {
+            __m128i texelQuad    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(texels + texelIdx));
+            __m128i texelsLo     = _mm_unpacklo_epi8(texelQuad, zero);
+            __m128i texelsHi     = _mm_unpackhi_epi8(texelQuad, zero);
+            __m128i bestDistance = zero, bestIndex = zero;
+            for (uint32_t colourIdx = 0; colourIdx < nColours; ++colourIdx)
+            {
+                __m128i colour  = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(palette[colourIdx])), zero);
+                __m128i deltaLo = _mm_sub_epi16(texelsLo, colour);
+                __m128i deltaHi = _mm_sub_epi16(texelsHi, colour);
+                // Red/green and blue/alpha partial sums per texel, added pairwise to the full squared distance of each of the 4 texels
+                __m128 partialLo = _mm_castsi128_ps(_mm_madd_epi16(deltaLo, deltaLo));
+                __m128 partialHi = _mm_castsi128_ps(_mm_madd_epi16(deltaHi, deltaHi));
+                __m128i distance = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(partialLo, partialHi, _MM_SHUFFLE(2, 0, 2, 0))),
+                                                 _mm_castps_si128(_mm_shuffle_ps(partialLo, partialHi, _MM_SHUFFLE(3, 1, 3, 1))));
+                if (colourIdx == 0)
+                {
+                    bestDistance = distance;
+                    continue;
+                }
+                __m128i closer = _mm_cmplt_epi32(distance, bestDistance);
+                bestDistance   = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, bestDistance));
+                bestIndex      = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(static_cast<int>(colourIdx))), _mm_andnot_si128(closer, bestIndex));
+            }
+            uint32_t quadIndices[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(quadIndices), bestIndex);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(errors + texelIdx), bestDistance);
+            for (int quadIdx = 0; quadIdx < 4; ++quadIdx)
+            {
+                indices[texelIdx + quadIdx] = static_cast<uint8_t>(quadIndices[quadIdx]);
+            }
+        }
+#else
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            indices[texelIdx] = 0;
+            errors[texelIdx]  = ColourDistance(texels[texelIdx], palette[0]);
+            for (uint32_t colourIdx = 1; colourIdx < nColours; ++colourIdx)
+            {
+                uint32_t distance = ColourDistance(texels[texelIdx], palette[colourIdx]);
+                if (distance < errors[texelIdx])
+                {
+                    indices[texelIdx] = static_cast<uint8_t>(colourIdx);
+                    errors[texelIdx]  = distance;
+                }
+            }
+        }
+#endif
+    }
+
+    struct ColourFit
+    {
+        uint16_t colour0, colour1;
+        uint8_t indices[N_BLOCK_TEXELS];
+        uint32_t error;
+    };
+
+    // Orders the endpoints for the block mode needed, then picks each texel's index. BC1 blocks with transparent texels must be three colour.
+    ColourFit FitIndices(uint16_t colour0, uint16_t colour1, bool isBC1, bool hasTransparency, const uint32_t *texels, const bool *opaque)
+    {
+        if (hasTransparency ? colour0 > colour1 : colour0 < colour1)
+        {
+            std::swap(colour0, colour1);
+        }
+        ColourFit fit{colour0, colour1, {}, 0};
+        bool fourColour = !isBC1 || colour0 > colour1;
+        uint32_t palette[4];
+        BuildPalette(colour0, colour1, fourColour, palette);
+
+        uint32_t errors[N_BLOCK_TEXELS];
+        SelectIndices(texels, palette, fourColour ? 4 : 3, fit.indices, errors);
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            if (opaque[texelIdx])
+            {
+                fit.error += errors[texelIdx];
+            }
+            else
+            {
+                fit.indices[texelIdx] = TRANSPARENT_INDEX;
+            }
+        }
+        return fit;
+    }
+
+    // Least squares endpoints for the texels given the indices they picked, false if the indices don't pin the endpoints down
+    bool RefineEndpoints(const ColourFit &fit, bool fourColour, const uint32_t *texels, const bool *opaque, float *endpoint0, float *endpoint1)
+    {
+        const float fourColourWeights[4]  = {1.f, 0.f, 2.f / 3.f, 1.f / 3.f};
+        const float threeColourWeights[4] = {1.f, 0.f, 0.5f, 0.f};
+        float weight00 = 0.f, weight01 = 0.f, weight11 = 0.f;
+        float weightedSum0[3] = {}, weightedSum1[3] = {};
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            if (!opaque[texelIdx])
+            {
+                continue;
+            }
+            float weight0 = (fourColour ? fourColourWeights : threeColourWeights)[fit.indices[texelIdx]];
+            float weight1 = 1.f - weight0;
+            weight00 += weight0 * weight0;
+            weight01 += weight0 * weight1;
+            weight11 += weight1 * weight1;
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                weightedSum0[channelIdx] += weight0 * Channel(texels[texelIdx], channelIdx);
+                weightedSum1[channelIdx] += weight1 * Channel(texels[texelIdx], channelIdx);
+            }
+        }
+        float determinant = weight00 * weight11 - weight01 * weight01;
+        if (std::fabs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+        for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+        {
+            endpoint0[channelIdx] = (weight11 * weightedSum0[channelIdx] - weight01 * weightedSum1[channelIdx]) / determinant;
+            endpoint1[channelIdx] = (weight00 * weightedSum1[channelIdx] - weight01 * weightedSum0[channelIdx]) / determinant;
+        }
+        return true;
+    }
+
+    void EncodeColourBlock(const uint8_t *rgbaTexels, bool isBC1, uint8_t *dst)
+    {
+        uint32_t texels[N_BLOCK_TEXELS];
+        bool opaque[N_BLOCK_TEXELS];
+        uint32_t nOpaque = 0;
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            const uint8_t *texel = rgbaTexels + texelIdx * 4;
+            texels[texelIdx]     = texel[0] | (texel[1] << 8) | (texel[2] << 16);
+            opaque[texelIdx]     = !isBC1 || texel[3] >= BC1_ALPHA_THRESHOLD;
+            nOpaque += opaque[texelIdx];
+        }
+        if (nOpaque == 0)
+        {
+            // Equal endpoints make a three colour block, every texel the transparent entry
+            memset(dst, 0, 4);
+            memset(dst + 4, 0xFF, 4);
+            return;
+        }
+
+        // Endpoints at the extremes of the texels along their principal axis
+        float mean[3] = {};
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            if (!opaque[texelIdx])
+            {
+                continue;
+            }
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                mean[channelIdx] += Channel(texels[texelIdx], channelIdx) / static_cast<float>(nOpaque);
+            }
+        }
+        float covariance[3][3] = {}, minChannel[3] = {255.f, 255.f, 255.f}, maxChannel[3] = {};
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            if (!opaque[texelIdx])
+            {
+                continue;
+            }
+            float delta[3];
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                float channel          = static_cast<float>(Channel(texels[texelIdx], channelIdx));
+                delta[channelIdx]      = channel - mean[channelIdx];
+                minChannel[channelIdx] = std::min(minChannel[channelIdx], channel);
+                maxChannel[channelIdx] = std::max(maxChannel[channelIdx], channel);
+            }
+            for (int row = 0; row < 3; ++row)
+            {
+                for (int col = 0; col < 3; ++col)
+                {
+                    covariance[row][col] += delta[row] * delta[col];
+                }
+            }
+        }
+        float axis[3] = {maxChannel[0] - minChannel[0], maxChannel[1] - minChannel[1], maxChannel[2] - minChannel[2]};
+        for (int iteration = 0; iteration < N_AXIS_ITERATIONS; ++iteration)
+        {
+            float nextAxis[3] = {};
+            for (int row = 0; row < 3; ++row)
+            {
+                nextAxis[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+            }
+            float length = std::max({std::fabs(nextAxis[0]), std::fabs(nextAxis[1]), std::fabs(nextAxis[2])});
+            if (length < 1e-6f)
+            {
+                break;
+            }
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                axis[channelIdx] = nextAxis[channelIdx] / length;
+            }
+        }
+        float minProjection = 0.f, maxProjection = 0.f;
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            if (!opaque[texelIdx])
+            {
+                continue;
+            }
+            float projection = 0.f;
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                projection += (Channel(texels[texelIdx], channelIdx) - mean[channelIdx]) * axis[channelIdx];
+            }
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+        float axisLength2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        float endpoint0[3], endpoint1[3];
+        for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+        {
+            endpoint0[channelIdx] = mean[channelIdx] + (axisLength2 > 0.f ? axis[channelIdx] * maxProjection / axisLength2 : 0.f);
+            endpoint1[channelIdx] = mean[channelIdx] + (axisLength2 > 0.f ? axis[channelIdx] * minProjection / axisLength2 : 0.f);
+        }
+
+        bool hasTransparency = nOpaque < N_BLOCK_TEXELS;
+        ColourFit bestFit    = FitIndices(Quantise565(endpoint0), Quantise565(endpoint1), isBC1, hasTransparency, texels, opaque);
+        bool fourColour      = !isBC1 || bestFit.colour0 > bestFit.colour1;
+        if (bestFit.error > 0 && RefineEndpoints(bestFit, fourColour, texels, opaque, endpoint0, endpoint1))
+        {
+            ColourFit refinedFit = FitIndices(Quantise565(endpoint0), Quantise565(endpoint1), isBC1, hasTransparency, texels, opaque);
+            if (refinedFit.error < bestFit.error)
+            {
+                bestFit = refinedFit;
+            }
+        }
+
+        uint32_t packedIndices = 0;
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            packedIndices |= static_cast<uint32_t>(bestFit.indices[texelIdx]) << (2 * texelIdx);
+        }
+        dst[0] = static_cast<uint8_t>(bestFit.colour0);
+        dst[1] = static_cast<uint8_t>(bestFit.colour0 >> 8);
+        dst[2] = static_cast<uint8_t>(bestFit.colour1);
+        dst[3] = static_cast<uint8_t>(bestFit.colour1 >> 8);
+        for (int byteIdx = 0; byteIdx < 4; ++byteIdx)
+        {
+            dst[4 + byteIdx] = static_cast<uint8_t>(packedIndices >> (8 * byteIdx));
+        }
+    }
+
+    void BuildAlphaPalette(uint8_t alpha0, uint8_t alpha1, uint8_t *palette)
+    {
+        palette[0] = alpha0;
+        palette[1] = alpha1;
+        if (alpha0 > alpha1)
+        {
+            for (int alphaIdx = 2; alphaIdx < 8; ++alphaIdx)
+            {
+                palette[alphaIdx] = static_cast<uint8_t>(((8 - alphaIdx) * alpha0 + (alphaIdx - 1) * alpha1) / 7);
+            }
+        }
+        else
+        {
+            for (int alphaIdx = 2; alphaIdx < 6; ++alphaIdx)
+            {
+                palette[alphaIdx] = static_cast<uint8_t>(((6 - alphaIdx) * alpha0 + (alphaIdx - 1) * alpha1) / 5);
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    // Eight interpolated alphas between the block's extremes
+    void EncodeAlphaBlock(const uint8_t *rgbaTexels, uint8_t *dst)
+    {
+        uint8_t minAlpha = 255, maxAlpha = 0;
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            minAlpha = std::min(minAlpha, rgbaTexels[texelIdx * 4 + 3]);
+            maxAlpha = std::max(maxAlpha, rgbaTexels[texelIdx * 4 + 3]);
+        }
+        uint8_t palette[8];
+        BuildAlphaPalette(maxAlpha, minAlpha, palette);
+
+        uint64_t packedIndices = 0;
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            uint8_t alpha    = rgbaTexels[texelIdx * 4 + 3];
+            uint64_t bestIdx = 0;
+            int bestDistance = 256;
+            for (int alphaIdx = 0; alphaIdx < (maxAlpha > minAlpha ? 8 : 1); ++alphaIdx)
+            {
+                int distance = std::abs(alpha - palette[alphaIdx]);
+                if (distance < bestDistance)
+                {
+                    bestIdx      = static_cast<uint64_t>(alphaIdx);
+                    bestDistance = distance;
+                }
+            }
+            packedIndices |= bestIdx << (3 * texelIdx);
+        }
+        dst[0] = maxAlpha;
+        dst[1] = minAlpha;
+        for (int byteIdx = 0; byteIdx < 6; ++byteIdx)
+        {
+            dst[2 + byteIdx] = static_cast<uint8_t>(packedIndices >> (8 * byteIdx));
+        }
+    }
+
+    void DecodeColourBlock(const uint8_t *src, bool isBC1, uint8_t *rgbaTexels)
+    {
+        uint16_t colour0 = ReadColour(src, 0);
+        uint16_t colour1 = ReadColour(src, 1);
+        bool fourColour  = !isBC1 || colour0 > colour1;
+        uint32_t palette[4];
+        BuildPalette(colour0, colour1, fourColour, palette);
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            uint32_t colourIdx = (src[4 + texelIdx / 4] >> (2 * (texelIdx % 4))) & 3;
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                rgbaTexels[texelIdx * 4 + channelIdx] = static_cast<uint8_t>(Channel(palette[colourIdx], channelIdx));
+            }
+            rgbaTexels[texelIdx * 4 + 3] = (!fourColour && colourIdx == TRANSPARENT_INDEX) ? 0 : 255;
+        }
+    }
+
+    void DecodeAlphaBlock(const uint8_t *src, uint8_t *rgbaTexels)
+    {
+        uint8_t palette[8];
+        BuildAlphaPalette(src[0], src[1], palette);
+        uint64_t packedIndices = 0;
+        for (int byteIdx = 0; byteIdx < 6; ++byteIdx)
+        {
+            packedIndices |= static_cast<uint64_t>(src[2 + byteIdx]) << (8 * byteIdx);
+        }
+        for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+        {
+            rgbaTexels[texelIdx * 4 + 3] = palette[(packedIndices >> (3 * texelIdx)) & 7];
+        }
+    }
+} // namespace
+
+size_t BlockCompression::GetBlockSize(Format format)
+{
+    return format == BC1 ? 8 : 16;
+}
+
+size_t BlockCompression::GetCompressedSize(Format format, uint32_t width, uint32_t height)
+{
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+}
+
+void BlockCompression::CompressImage(Format format, const uint8_t *rgba, uint32_t width, uint32_t height, uint8_t *dst)
+{
+    uint8_t texels[N_BLOCK_TEXELS * 4];
+    for (uint32_t blockY = 0; blockY < height; blockY += 4)
+    {
+        for (uint32_t blockX = 0; blockX < width; blockX += 4, dst += GetBlockSize(format))
+        {
+            for (uint32_t texelIdx = 0; texelIdx < N_BLOCK_TEXELS; ++texelIdx)
+            {
+                uint32_t x = std::min(blockX + texelIdx % 4, width - 1);
+                uint32_t y = std::min(blockY + texelIdx / 4, height - 1);
+                memcpy(&texels[texelIdx * 4], rgba + (static_cast<size_t>(y) * width + x) * 4, 4);
+            }
+            EncodeBlock(format, texels, dst);
+        }
+    }
+}
+
+void BlockCompression::DecompressImage(Format format, const uint8_t *src, uint32_t width, uint32_t height, uint8_t *rgba)
+{
+    uint8_t texels[N_BLOCK_TEXELS * 4];
+    for (uint32_t blockY = 0; blockY < height; blockY += 4)
+    {
+        for (uint32_t blockX = 0; blockX < width; blockX += 4, src += GetBlockSize(format))
+        {
+            DecodeBlock(format, src, texels);
+            for (uint32_t y = blockY; y < std::min(blockY + 4, height); ++y)
+            {
+                for (uint32_t x = blockX; x < std::min(blockX + 4, width); ++x)
+                {
+                    memcpy(rgba + (static_cast<size_t>(y) * width + x) * 4, &texels[((y - blockY) * 4 + (x - blockX)) * 4], 4);
+                }
+            }
+        }
+    }
+}
+
+void BlockCompression::EncodeBlock(Format format, const uint8_t *texels, uint8_t *dst)
+{
+    if (format == BC1)
+    {
+        EncodeColourBlock(texels, true, dst);
+        return;
+    }
+    EncodeAlphaBlock(texels, dst);
+    EncodeColourBlock(texels, false, dst + 8);
+}
+
+void BlockCompression::DecodeBlock(Format format, const uint8_t *src, uint8_t *texels)
+{
+    if (format == BC1)
+    {
+        DecodeColourBlock(src, true, texels);
+        return;
+    }
+    DecodeColourBlock(src + 8, false, texels);
+    DecodeAlphaBlock(src, texels);
+}
+
+bool BlockCompression::IsFourColourBlock(const uint8_t *colourBlock)
+{
+    return ReadColour(colourBlock, 0) > ReadColour(colourBlock, 1);
+}
+
+void BlockCompression::FlipColourBlock(uint8_t *colourBlock)
+{
+    std::swap(colourBlock[4], colourBlock[7]);
+    std::swap(colourBlock[5], colourBlock[6]);
+}
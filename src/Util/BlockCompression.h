@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// BC1 (DXT1) and BC3 (DXT5) block compression of RGBA8 images, so textures can be uploaded compressed. Colour endpoints are fit along the
+// principal axis of each block's texels then refined by least squares, with the per texel palette search done by an SSE2 kernel where the
+// build targets it (x86-64 always has SSE2). Both paths produce identical output.
+class BlockCompression
+{
+public:
+    enum Format : uint8_t
+    {
+        BC1 = 0, // RGB plus 1 bit alpha, 8 bytes per 4x4 block
+        BC3,     // RGBA, 16 bytes per 4x4 block
+        N_BLOCK_FORMATS
+    };
+
+    static size_t GetBlockSize(Format format);
+    static size_t GetCompressedSize(Format format, uint32_t width, uint32_t height);
+    // rgba is width x height RGBA8 texels, row by row. Blocks hanging off the right or bottom edge repeat the edge texels. BC1 texels with alpha
+    // below 128 come out transparent black.
+    static void CompressImage(Format format, const uint8_t *rgba, uint32_t width, uint32_t height, uint8_t *dst);
+    static void DecompressImage(Format format, const uint8_t *src, uint32_t width, uint32_t height, uint8_t *rgba);
+    // Single blocks, texels being the 16 RGBA8 texels of the block row by row
+    static void EncodeBlock(Format format, const uint8_t *texels, uint8_t *dst);
+    static void DecodeBlock(Format format, const uint8_t *src, uint8_t *texels);
+    // True if the 8 byte colour block decodes the same way whether read as BC1 or as the colour half of a BC2/BC3 block
+    static bool IsFourColourBlock(const uint8_t *colourBlock);
+    // Swaps the rows of an 8 byte colour block top to bottom, for blocks of an image stored the other way up
+    static void FlipColourBlock(uint8_t *colourBlock);
+};
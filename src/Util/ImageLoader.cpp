@@ -1,31 +1,59 @@
 #include "ImageLoader.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 GLuint ImageLoader::LoadImage(const std::string &imagePath, int *width, int *height, GLint wrapParam, GLint sampleParam)
 {
-    GLuint textureID;
     int nChannels;
 
     unsigned char *image = stbi_load(imagePath.c_str(), width, height, &nChannels, STBI_rgb_alpha);
     ASSERT(image != nullptr, "Failed to load texture " << imagePath);
 
+    GLuint textureID = LoadImage(image, *width, *height, wrapParam, sampleParam);
+    stbi_image_free(image);
+
+    return textureID;
+}
+
+GLuint ImageLoader::LoadImage(const GLubyte *imageData, int width, int height, GLint wrapParam, GLint sampleParam)
+{
+    GLuint textureID;
+
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapParam);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapParam);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sampleParam);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sampleParam);
-    // No need to change this dependent on nChannels, we've always requested an RGBA load from stb
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, *width, *height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, imageData);
     glGenerateMipmap(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(image);
 
     return textureID;
 }
 
+bool ImageLoader::DecodeImage(const char *encodedImage, size_t encodedSize, std::vector<GLubyte> &imageData, int *width, int *height)
+{
+    int nChannels;
+
+    // Always request RGBA from stb, whatever the source channel count
+    unsigned char *image = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(encodedImage), static_cast<int>(encodedSize), width, height, &nChannels, STBI_rgb_alpha);
+    if (image == nullptr)
+    {
+        return false;
+    }
+    imageData.assign(image, image + static_cast<size_t>(*width) * *height * 4);
+    stbi_image_free(image);
+
+    return true;
+}
+
 // lpBits stand for long pointer bits
 // szPathName : Specifies the pathname        -> the file path to save the image
 // lpBits    : Specifies the bitmap bits      -> the buffer (content of the) image
@@ -112,6 +140,30 @@ uint32_t ImageLoader::abgr1555ToARGB8888(uint16_t abgr1555)
     return alpha << 24 | red << 16 | green << 8 | blue;
 }
 
+void ImageLoader::_ExpandBmpPalette(const uint8_t *bmpData, long bmpSize, uint32_t *palette)
+{
+    // Indices past the end of a short colour table used to read on into the pixel data, so carry on reading, but not past the end of the file
+    const long paletteOffset = sizeof(CP_BITMAPFILEHEADER) + offsetof(CP_BITMAPINFO, bmiColors);
+    const auto *colours      = reinterpret_cast<const CP_RGBQUAD *>(bmpData + paletteOffset);
+    long nColours            = bmpSize > paletteOffset ? std::min(256L, (bmpSize - paletteOffset) / (long) sizeof(CP_RGBQUAD)) : 0;
+
+    for (long colourIdx = 0; colourIdx < 256; ++colourIdx)
+    {
+        uint8_t *rgba = reinterpret_cast<uint8_t *>(&palette[colourIdx]);
+        if (colourIdx < nColours)
+        {
+            rgba[0] = colours[colourIdx].rgbRed;
+            rgba[1] = colours[colourIdx].rgbGreen;
+            rgba[2] = colours[colourIdx].rgbBlue;
+            rgba[3] = 255;
+        }
+        else
+        {
+            palette[colourIdx] = 0;
+        }
+    }
+}
+
 // TODO: Integrate into LoadBmpCustomAlpha as a master bitmap loader
 bool ImageLoader::LoadBmpCustomAlpha(const char *fname, GLubyte **bits, GLsizei *width_, GLsizei *height_, uint8_t alphaColour)
 {
@@ -163,50 +215,32 @@ bool ImageLoader::LoadBmpCustomAlpha(const char *fname, GLubyte **bits, GLsizei
                                             {
                                             // 8-bit palette bitmaps
                                             case 8:
+                                            {
                                                 padding = w % 2;
-                                                CP_RGBQUAD rgba;
+                                                // Resolve the colour key once per palette entry rather than per pixel
+                                                uint32_t palette[256];
+                                                _ExpandBmpPalette(data, size, palette);
+                                                for (uint32_t &colour : palette)
+                                                {
+                                                    uint8_t *rgba = reinterpret_cast<uint8_t *>(&colour);
+                                                    rgba[3]       = (rgba[0] == 0 && rgba[1] == alphaColour && rgba[2] == 0) ? 0 : 255;
+                                                }
                                                 for (; h > 0; h--)
                                                 {
-                                                    for (w = width; w > 0; w--)
-                                                    {
-                                                        rgba = info->bmiColors[*pixel];
-                                                        pixel++;
-                                                        *current_bits++ = rgba.rgbRed;
-                                                        *current_bits++ = rgba.rgbGreen;
-                                                        *current_bits++ = rgba.rgbBlue;
-                                                        if (rgba.rgbRed == 0 && rgba.rgbGreen == alphaColour && rgba.rgbBlue == 0)
-                                                        {
-                                                            *current_bits++ = 0;
-                                                        }
-                                                        else
-                                                        {
-                                                            *current_bits++ = 255;
-                                                        }
-                                                    }
-                                                    pixel += padding;
+                                                    PixelConversion::LookupPalette(pixel, palette, current_bits, width);
+                                                    pixel += width + padding;
+                                                    current_bits += width * 4;
                                                 }
-                                                break;
+                                            }
+                                            break;
                                                 // 24-bit bitmaps
                                             case 24:
                                                 padding = (w * 3) % 2;
                                                 for (; h > 0; h--)
                                                 {
-                                                    for (w = width; w > 0; w--)
-                                                    {
-                                                        *current_bits++ = pixel[2];
-                                                        *current_bits++ = pixel[1];
-                                                        *current_bits++ = pixel[0];
-                                                        if (pixel[2] == 0 && pixel[1] == alphaColour && pixel[0] == 0)
-                                                        {
-                                                            *current_bits++ = 0;
-                                                        }
-                                                        else
-                                                        {
-                                                            *current_bits++ = 255;
-                                                        }
-                                                        pixel += 3;
-                                                    }
-                                                    pixel += padding;
+                                                    PixelConversion::BGR8ToRGBA8ColourKey(pixel, current_bits, width, 0, alphaColour, 0);
+                                                    pixel += width * 3 + padding;
+                                                    current_bits += width * 4;
                                                 }
                                                 break;
                                             case 32:
@@ -325,45 +359,43 @@ bool ImageLoader::LoadBmpWithAlpha(const char *fname, const char *afname, GLubyt
                                         switch (info->bmiHeader.biBitCount)
                                         { // 24-bit bitmaps
                                         case 8:
-                                            padding_a = w % 2;
-                                            padding   = w % 2;
-                                            CP_RGBQUAD rgba;
+                                        {
+                                            padding = w % 2;
+                                            uint32_t palette[256];
+                                            _ExpandBmpPalette(data, size, palette);
+                                            for (uint32_t &colour : palette)
+                                            {
+                                                uint8_t *rgba = reinterpret_cast<uint8_t *>(&colour);
+                                                rgba[3]       = rgba[0];
+                                            }
                                             for (; h > 0; h--)
                                             {
-                                                for (w = width; w > 0; w--)
-                                                {
-                                                    rgba = info->bmiColors[*pixel];
-                                                    pixel++;
-                                                    pixel_a++;
-                                                    *current_bits++ = rgba.rgbRed;
-                                                    *current_bits++ = rgba.rgbGreen;
-                                                    *current_bits++ = rgba.rgbBlue;
-                                                    *current_bits++ = rgba.rgbRed;
-                                                }
-                                                pixel += padding;
-                                                pixel_a += padding_a;
+                                                PixelConversion::LookupPalette(pixel, palette, current_bits, width);
+                                                pixel += width + padding;
+                                                current_bits += width * 4;
                                             }
-                                            break;
+                                        }
+                                        break;
                                         case 24:
+                                        {
                                             // Read the 8 Bit bitmap alpha data
                                             padding_a = w % 2;
                                             padding   = (w * 3) % 2;
+                                            uint32_t alphaPalette[256];
+                                            _ExpandBmpPalette(data_a, size_a, alphaPalette);
                                             for (; h > 0; h--)
                                             {
-                                                for (w = width; w > 0; w--)
+                                                PixelConversion::BGR8ToRGBA8(pixel, current_bits, width);
+                                                for (w = 0; w < width; w++)
                                                 {
-                                                    rgba = info_a->bmiColors[*pixel_a];
-                                                    pixel_a++;
-                                                    *current_bits++ = pixel[2];
-                                                    *current_bits++ = pixel[1];
-                                                    *current_bits++ = pixel[0];
-                                                    *current_bits++ = rgba.rgbRed;
-                                                    pixel += 3;
+                                                    current_bits[w * 4 + 3] = reinterpret_cast<uint8_t *>(&alphaPalette[pixel_a[w]])[0];
                                                 }
-                                                pixel += padding;
-                                                pixel_a += padding_a;
+                                                pixel += width * 3 + padding;
+                                                pixel_a += width + padding_a;
+                                                current_bits += width * 4;
                                             }
-                                            break;
+                                        }
+                                        break;
                                         case 32:
                                             // 32-bit bitmaps
                                             // never seen it, but Win32 SDK claims the existance
@@ -466,12 +498,10 @@ bool ImageLoader::ExtractPSH(const std::string &psh_path, const std::string &out
         auto *imageHeader = new PSH::IMAGE_HEADER();
         psh.read(((char *) imageHeader), sizeof(PSH::IMAGE_HEADER));
 
-        uint8_t bitDepth   = static_cast<uint8_t>(imageHeader->imageType & 0x3);
-        uint32_t *pixels   = new uint32_t[imageHeader->width * imageHeader->height];
-        uint8_t *indexPair = new uint8_t();
-        uint8_t *indexes   = new uint8_t[imageHeader->width * imageHeader->height]; // Only used if indexed
-        bool hasAlpha      = false;
-        bool isPadded      = false;
+        uint8_t bitDepth = static_cast<uint8_t>(imageHeader->imageType & 0x3);
+        uint32_t *pixels = new uint32_t[imageHeader->width * imageHeader->height];
+        uint8_t *indexes = new uint8_t[imageHeader->width * imageHeader->height]; // Only used if indexed
+        bool isPadded    = false;
         if (bitDepth == 0)
         {
             isPadded = (imageHeader->width % 4 == 1) || (imageHeader->width % 4 == 2);
@@ -481,58 +511,35 @@ bool ImageLoader::ExtractPSH(const std::string &psh_path, const std::string &out
             isPadded = imageHeader->width % 2 == 1;
         }
 
+        // Read and convert a whole row at a time
+        const size_t rowBytes[] = {(imageHeader->width + 1u) / 2u, imageHeader->width, imageHeader->width * 2u, imageHeader->width * 3u};
+        std::vector<uint8_t> row(rowBytes[bitDepth]);
         for (int y = 0; y < imageHeader->height; y++)
         {
-            for (int x = 0; x < imageHeader->width; x++)
+            psh.read((char *) row.data(), row.size());
+            uint8_t *rowIndexes = indexes + y * imageHeader->width;
+            uint32_t *rowPixels = pixels + y * imageHeader->width;
+            switch (bitDepth)
             {
-                switch (bitDepth)
-                {
-                case 0:
-                { // 4-bit indexed colour
-                    uint8_t index;
-                    if (x % 2 == 0)
-                    {
-                        psh.read((char *) indexPair, sizeof(uint8_t));
-                        index = static_cast<uint8_t>(*indexPair & 0xF);
-                    }
-                    else
-                    {
-                        index = *indexPair >> 4;
-                    }
-                    indexes[(x + y * imageHeader->width)] = index;
-                    break;
-                }
-                case 1:
-                { // 8-bit indexed colour
-                    psh.read((char *) &indexes[(x + y * imageHeader->width)], sizeof(uint8_t));
-                    break;
-                }
-                case 2:
-                { // 16-bit direct colour
-                    uint16_t *input = new uint16_t;
-                    psh.read((char *) input, sizeof(uint16_t));
-                    uint32_t pixel                       = abgr1555ToARGB8888(*input);
-                    hasAlpha                             = (pixel & 0xFF000000) != -16777216;
-                    pixels[(x + y * imageHeader->width)] = pixel;
-                    break;
-                }
-                case 3:
-                { // 24-bit direct colour
-                    uint8_t alpha = 255u;
-                    uint8_t rgb[3];
-                    psh.read((char *) rgb, 3 * sizeof(uint8_t));
-                    if ((rgb[0] == 0) && (rgb[1] == 0) && (rgb[2] == 0))
-                    {
-                        hasAlpha = true;
-                        alpha    = 0;
-                    }
-                    pixels[(x + y * imageHeader->width)] = (alpha << 24 | rgb[0] << 16 | rgb[1] << 8 | rgb[2]);
-                }
-                }
-                if ((x == imageHeader->width - 1) && (isPadded))
+            case 0: // 4-bit indexed colour
+                for (int x = 0; x < imageHeader->width; x++)
                 {
-                    psh.seekg(1, std::ios_base::cur); // Skip a byte of padding
+                    rowIndexes[x] = (x % 2 == 0) ? static_cast<uint8_t>(row[x / 2] & 0xF) : static_cast<uint8_t>(row[x / 2] >> 4);
                 }
+                break;
+            case 1: // 8-bit indexed colour
+                memcpy(rowIndexes, row.data(), row.size());
+                break;
+            case 2: // 16-bit direct colour
+                PixelConversion::ABGR1555ToARGB8888(reinterpret_cast<const uint16_t *>(row.data()), rowPixels, imageHeader->width);
+                break;
+            case 3: // 24-bit direct colour, black is transparent
+                PixelConversion::BGR8ToRGBA8ColourKey(row.data(), reinterpret_cast<uint8_t *>(rowPixels), imageHeader->width, 0, 0, 0);
+                break;
+            }
+            if (isPadded)
+            {
+                psh.seekg(1, std::ios_base::cur); // Skip a byte of padding
             }
         }
 
@@ -588,18 +595,10 @@ bool ImageLoader::ExtractPSH(const std::string &psh_path, const std::string &out
             uint16_t *paletteColours = new uint16_t[paletteHeader->nPaletteEntries];
             psh.read((char *) paletteColours, paletteHeader->nPaletteEntries * sizeof(uint16_t));
 
-            // Rewrite the pixels using the palette data
-            if ((bitDepth == 0) || (bitDepth == 1))
-            {
-                for (int y = 0; y < imageHeader->height; y++)
-                {
-                    for (int x = 0; x < imageHeader->width; x++)
-                    {
-                        uint32_t pixel                       = abgr1555ToARGB8888(paletteColours[indexes[(x + y * imageHeader->width)]]);
-                        pixels[(x + y * imageHeader->width)] = pixel;
-                    }
-                }
-            }
+            // Rewrite the pixels using the palette data, converted up front. Out of range indices come out transparent black.
+            uint32_t palette[256] = {};
+            PixelConversion::ABGR1555ToARGB8888(paletteColours, palette, std::min<size_t>(paletteHeader->nPaletteEntries, 256));
+            PixelConversion::LookupPalette(indexes, palette, reinterpret_cast<uint8_t *>(pixels), imageHeader->width * imageHeader->height);
 
             delete paletteHeader;
         }
@@ -2,10 +2,12 @@
 
 #include <GL/glew.h>
 #include <string>
+#include <vector>
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
 
 #include "Logger.h"
+#include "PixelConversion.h"
 
 extern "C"
 {
@@ -98,10 +100,16 @@ struct PSH
 class ImageLoader
 {
 private:
+    // Reads a BMP colour table out into RGBA8 words for PixelConversion::LookupPalette
+    static void _ExpandBmpPalette(const uint8_t *bmpData, long bmpSize, uint32_t *palette);
+
 public:
     explicit ImageLoader();
     ~ImageLoader();
     static GLuint LoadImage(const std::string &imagePath, int *width, int *height, GLint wrapParam, GLint sampleParam);
+    static GLuint LoadImage(const GLubyte *imageData, int width, int height, GLint wrapParam, GLint sampleParam);
+    // CPU side only decode of an in memory TGA/PNG/BMP etc. to RGBA8, no GL
+    static bool DecodeImage(const char *encodedImage, size_t encodedSize, std::vector<GLubyte> &imageData, int *width, int *height);
     static bool SaveImage(const char *szPathName, void *lpBits, uint16_t w, uint16_t h);
     static uint32_t abgr1555ToARGB8888(uint16_t abgr1555);
     static bool ExtractQFS(const std::string &qfs_input, const std::string &output_dir);
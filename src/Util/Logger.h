@@ -12,6 +12,8 @@
 
 #include <iostream>
 #include <cmath>
+#include <sstream>
+#include <stdexcept>
 #include <g3log/g3log.hpp>
 #include <g3log/logworker.hpp>
 
@@ -22,13 +24,18 @@
     {                                                                                                                         \
         if (!(condition))                                                                                                     \
         {                                                                                                                     \
-            LOG(WARNING) << "Assertion `" #condition "` failed in " << __FILE__ << " line " << __LINE__ << ": " << message;   \
+            std::ostringstream assertMessage;                                                                                 \
+            assertMessage << "Assertion `" #condition "` failed in " << __FILE__ << " line " << __LINE__ << ": " << message;  \
+            /* Headless batch runs carry on with the rest of their work, leaving the caller to report what failed */          \
+            if (Config::get().headless)                                                                                       \
+                throw std::runtime_error(assertMessage.str());                                                                \
+            LOG(WARNING) << assertMessage.str();                                                                              \
             LOG(WARNING) << "Press ESC to terminate, and let me know on Discord! (if you're sure this isn't your own fault)"; \
-            char c;                                                                                                           \
+            int c;                                                                                                            \
             while (true)                                                                                                      \
             {                                                                                                                 \
                 c = std::getchar();                                                                                           \
-                if (c == 27)                                                                                                  \
+                if (c == 27 || c == EOF) /* No console to wait on when run as a batch job */                                  \
                     break;                                                                                                    \
             }                                                                                                                 \
             std::terminate();                                                                                                 \
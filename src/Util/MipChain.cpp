@@ -0,0 +1,125 @@
+#include "MipChain.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const uint32_t N_ALPHA_VALUES = 256;
+} // namespace
+
+uint32_t MipChain::GetLevelDimension(uint32_t dimension, int level)
+{
+    return std::max((dimension + (1u << level) - 1) >> level, 1u);
+}
+
+float MipChain::GetAlphaCoverage(const uint8_t *rgba, uint32_t width, uint32_t height, uint8_t alphaReference)
+{
+    size_t nTexels = static_cast<size_t>(width) * height, nCovered = 0;
+    for (size_t texelIdx = 0; texelIdx < nTexels; ++texelIdx)
+    {
+        nCovered += rgba[texelIdx * 4 + 3] >= alphaReference;
+    }
+    return nTexels ? static_cast<float>(nCovered) / nTexels : 0.f;
+}
+
+std::vector<uint8_t> MipChain::Downsample(const uint8_t *rgba, uint32_t width, uint32_t height)
+{
+    uint32_t halfWidth = GetLevelDimension(width, 1), halfHeight = GetLevelDimension(height, 1);
+    std::vector<uint8_t> half(static_cast<size_t>(halfWidth) * halfHeight * 4);
+    for (uint32_t y = 0; y < halfHeight; ++y)
+    {
+        for (uint32_t x = 0; x < halfWidth; ++x)
+        {
+            const uint8_t *texels[4] = {&rgba[(std::min(2 * y, height - 1) * width + std::min(2 * x, width - 1)) * 4],
+                                        &rgba[(std::min(2 * y, height - 1) * width + std::min(2 * x + 1, width - 1)) * 4],
+                                        &rgba[(std::min(2 * y + 1, height - 1) * width + std::min(2 * x, width - 1)) * 4],
+                                        &rgba[(std::min(2 * y + 1, height - 1) * width + std::min(2 * x + 1, width - 1)) * 4]};
+            uint32_t alphaSum = texels[0][3] + texels[1][3] + texels[2][3] + texels[3][3];
+            uint8_t *halfTexel = &half[(y * halfWidth + x) * 4];
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                // Fully transparent quads have no weights to go on, so fall back to a plain average
+                uint32_t channelSum = 0;
+                for (auto texel : texels)
+                {
+                    channelSum += alphaSum ? texel[channelIdx] * texel[3] : texel[channelIdx];
+                }
+                uint32_t weightSum    = alphaSum ? alphaSum : 4;
+                halfTexel[channelIdx] = static_cast<uint8_t>((channelSum + weightSum / 2) / weightSum);
+            }
+            halfTexel[3] = static_cast<uint8_t>((alphaSum + 2) / 4);
+        }
+    }
+    return half;
+}
+
+void MipChain::ScaleAlphaToCoverage(uint8_t *rgba, uint32_t width, uint32_t height, float coverage, uint8_t alphaReference)
+{
+    size_t nTexels = static_cast<size_t>(width) * height;
+    if (nTexels == 0 || alphaReference == 0)
+    {
+        return;
+    }
+
+    // nCovered[alpha] is how many texels would pass with a reference of alpha, so scaling by alphaReference / alpha gives that coverage
+    size_t nCovered[N_ALPHA_VALUES + 1] = {};
+    for (size_t texelIdx = 0; texelIdx < nTexels; ++texelIdx)
+    {
+        ++nCovered[rgba[texelIdx * 4 + 3]];
+    }
+    for (int32_t alpha = N_ALPHA_VALUES - 1; alpha >= 0; --alpha)
+    {
+        nCovered[alpha] += nCovered[alpha + 1];
+    }
+
+    size_t targetCovered = static_cast<size_t>(std::lround(coverage * nTexels));
+    uint32_t threshold   = alphaReference;
+    if (nCovered[threshold] < targetCovered)
+    {
+        // Eroded, lower the threshold as little as gets back to the target
+        while (threshold > 1 && nCovered[threshold] < targetCovered)
+        {
+            --threshold;
+        }
+    }
+    else
+    {
+        // Grown, raise it as little as gets back down to the target, or as close to it as the alpha values there are allow
+        while (threshold < N_ALPHA_VALUES - 1 && nCovered[threshold] > targetCovered &&
+               nCovered[threshold] - targetCovered > (targetCovered > nCovered[threshold + 1] ? targetCovered - nCovered[threshold + 1] : 0))
+        {
+            ++threshold;
+        }
+    }
+    if (threshold == alphaReference)
+    {
+        return;
+    }
+
+    // Truncating keeps every texel below the threshold below alphaReference, and the threshold itself lands exactly on it
+    for (size_t texelIdx = 0; texelIdx < nTexels; ++texelIdx)
+    {
+        uint8_t &alpha = rgba[texelIdx * 4 + 3];
+        alpha          = static_cast<uint8_t>(std::min(alpha * static_cast<uint32_t>(alphaReference) / threshold, 255u));
+    }
+}
+
+std::vector<std::vector<uint8_t>> MipChain::Build(const uint8_t *rgba, uint32_t width, uint32_t height, int nLevels, uint8_t alphaReference)
+{
+    std::vector<std::vector<uint8_t>> levels;
+    if (nLevels < 2 || width == 0 || height == 0)
+    {
+        return levels;
+    }
+
+    float coverage = GetAlphaCoverage(rgba, width, height, alphaReference);
+    std::vector<uint8_t> unscaled(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    for (int level = 1; level < nLevels; ++level)
+    {
+        unscaled = Downsample(unscaled.data(), GetLevelDimension(width, level - 1), GetLevelDimension(height, level - 1));
+        levels.push_back(unscaled);
+        ScaleAlphaToCoverage(levels.back().data(), GetLevelDimension(width, level), GetLevelDimension(height, level), coverage, alphaReference);
+    }
+    return levels;
+}
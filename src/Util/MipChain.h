@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Mip chains for RGBA8 images, built on the CPU from the image's own texels so nothing outside of it (such as texture array padding) gets
+// filtered in. Colour is averaged weighted by alpha, so transparent texels don't bleed their colour into the visible edge, and alpha is rescaled
+// at each level to keep the fraction of texels passing an alpha test the same as the full size image. Otherwise averaging away thin alpha tested
+// detail (foliage, fences) makes it erode a little further at every level.
+class MipChain
+{
+public:
+    // Level dimensions round up, so a texel on an odd edge isn't dropped. Level 0 is the source image itself.
+    static uint32_t GetLevelDimension(uint32_t dimension, int level);
+    // Fraction of texels at or above alphaReference
+    static float GetAlphaCoverage(const uint8_t *rgba, uint32_t width, uint32_t height, uint8_t alphaReference);
+    // The next level down of a width x height image, each texel averaging the 2x2 texels above it, repeating the last row/column for odd sizes
+    static std::vector<uint8_t> Downsample(const uint8_t *rgba, uint32_t width, uint32_t height);
+    // Scales alpha so that as close to coverage of the texels as possible are at or above alphaReference. Leaves the image be if it's already
+    // there, or if nothing but fully transparent texels could make up the difference.
+    static void ScaleAlphaToCoverage(uint8_t *rgba, uint32_t width, uint32_t height, float coverage, uint8_t alphaReference);
+    // Levels 1 to nLevels - 1 of rgba, each downsampled from the unscaled level before it, then alpha scaled to level 0's coverage
+    static std::vector<std::vector<uint8_t>> Build(const uint8_t *rgba, uint32_t width, uint32_t height, int nLevels, uint8_t alphaReference);
+};
@@ -0,0 +1,253 @@
+#include "PixelConversion.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#define PIXEL_CONVERSION_AVX2
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#define PIXEL_CONVERSION_SSSE3
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXEL_CONVERSION_SSE2
+#endif
+
+#if defined(PIXEL_CONVERSION_AVX2)
+#include <immintrin.h>
+#elif defined(PIXEL_CONVERSION_SSSE3)
+#include <tmmintrin.h>
+#elif defined(PIXEL_CONVERSION_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    inline void PutPixel(uint8_t *pixel, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+    {
+        pixel[0] = red;
+        pixel[1] = green;
+        pixel[2] = blue;
+        pixel[3] = alpha;
+    }
+
+    // Exact integer form of round(channel / 31.f * 255.f)
+    inline uint32_t Expand5To8(uint32_t channel)
+    {
+        return (channel * 527 + 23) >> 6;
+    }
+
+#if defined(PIXEL_CONVERSION_SSE2)
+    // Loads 4 BGR8 pixels as RGB8 with a zero alpha byte. Reads 16 bytes, 4 past the pixels themselves.
+    inline __m128i LoadBGR8AsRGB0(const uint8_t *pixels)
+    {
+#if defined(PIXEL_CONVERSION_SSSE3)
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels)), _mm_setr_epi8(2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128));
+#else
+        int32_t bgr[4];
+        for (int pixelIdx = 0; pixelIdx < 4; ++pixelIdx)
+        {
+            memcpy(&bgr[pixelIdx], pixels + pixelIdx * 3, sizeof(int32_t));
+        }
+        __m128i bgrx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bgr));
+        __m128i red  = _mm_and_si128(_mm_srli_epi32(bgrx, 16), _mm_set1_epi32(0xFF));
+        __m128i blue = _mm_slli_epi32(_mm_and_si128(bgrx, _mm_set1_epi32(0xFF)), 16);
+        return _mm_or_si128(_mm_or_si128(red, blue), _mm_and_si128(bgrx, _mm_set1_epi32(0xFF00)));
+#endif
+    }
+#endif
+
+    template <bool colourKeyed>
+    bool SwizzleBGR8(const uint8_t *src, uint8_t *dst, size_t nPixels, uint8_t keyRed, uint8_t keyGreen, uint8_t keyBlue)
+    {
+        size_t pixelIdx = 0;
+        int keyedOut    = 0;
+
+#if defined(PIXEL_CONVERSION_SSE2)
+        const uint32_t colourKey = keyRed | (keyGreen << 8) | (keyBlue << 16);
+#if defined(PIXEL_CONVERSION_AVX2)
+        const __m256i swizzle256 = _mm256_setr_epi8(2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128, 2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128);
+        const __m256i alpha256   = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+        const __m256i key256     = _mm256_set1_epi32(static_cast<int>(colourKey));
+        // Both 16 byte loads overrun the 12 bytes of pixels they're used for, stop early enough that they stay in bounds
+        for (; pixelIdx + 10 <= nPixels; pixelIdx += 8)
+        {
+            const uint8_t *pixels = src + pixelIdx * 3;
+            __m256i bgr           = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels))),
+                                                  _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + 12)), 1);
+            __m256i rgba          = _mm256_shuffle_epi8(bgr, swizzle256);
+            if (colourKeyed)
+            {
+                __m256i keyMask = _mm256_cmpeq_epi32(rgba, key256);
+                keyedOut |= _mm256_movemask_epi8(keyMask);
+                rgba = _mm256_or_si256(rgba, _mm256_andnot_si256(keyMask, alpha256));
+            }
+            else
+            {
+                rgba = _mm256_or_si256(rgba, alpha256);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + pixelIdx * 4), rgba);
+        }
+#endif
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+        const __m128i key   = _mm_set1_epi32(static_cast<int>(colourKey));
+        for (; pixelIdx + 6 <= nPixels; pixelIdx += 4)
+        {
+            __m128i rgba = LoadBGR8AsRGB0(src + pixelIdx * 3);
+            if (colourKeyed)
+            {
+                __m128i keyMask = _mm_cmpeq_epi32(rgba, key);
+                keyedOut |= _mm_movemask_epi8(keyMask);
+                rgba = _mm_or_si128(rgba, _mm_andnot_si128(keyMask, alpha));
+            }
+            else
+            {
+                rgba = _mm_or_si128(rgba, alpha);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + pixelIdx * 4), rgba);
+        }
+#endif
+
+        for (; pixelIdx < nPixels; ++pixelIdx)
+        {
+            const uint8_t *pixel = src + pixelIdx * 3;
+            bool keyed           = colourKeyed && pixel[2] == keyRed && pixel[1] == keyGreen && pixel[0] == keyBlue;
+            keyedOut |= keyed;
+            PutPixel(dst + pixelIdx * 4, pixel[2], pixel[1], pixel[0], keyed ? 0 : 255);
+        }
+
+        return keyedOut != 0;
+    }
+
+#if defined(PIXEL_CONVERSION_SSE2)
+    // Takes 4 zero extended 16 bit pixels per lane
+    inline __m128i ExpandARGB1555(__m128i colours)
+    {
+        __m128i red   = _mm_and_si128(_mm_srli_epi32(colours, 7), _mm_set1_epi32(0xF8));
+        __m128i green = _mm_and_si128(_mm_slli_epi32(colours, 6), _mm_set1_epi32(0xF800));
+        __m128i blue  = _mm_and_si128(_mm_slli_epi32(colours, 19), _mm_set1_epi32(0xF80000));
+        __m128i alpha = _mm_and_si128(_mm_srai_epi32(_mm_slli_epi32(colours, 16), 31), _mm_set1_epi32(static_cast<int>(0xFF000000)));
+        return _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, alpha));
+    }
+
+    inline __m128i ExpandARGB4444(__m128i colours)
+    {
+        // Spread each nibble out to the bottom of its destination byte, then n * 0x11 == n | n << 4 fills the top
+        __m128i red     = _mm_and_si128(_mm_srli_epi32(colours, 8), _mm_set1_epi32(0xF));
+        __m128i green   = _mm_and_si128(_mm_slli_epi32(colours, 4), _mm_set1_epi32(0xF00));
+        __m128i blue    = _mm_and_si128(_mm_slli_epi32(colours, 16), _mm_set1_epi32(0xF0000));
+        __m128i alpha   = _mm_and_si128(_mm_slli_epi32(colours, 12), _mm_set1_epi32(0xF000000));
+        __m128i nibbles = _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, alpha));
+        return _mm_or_si128(nibbles, _mm_slli_epi32(nibbles, 4));
+    }
+
+    inline __m128i Expand5To8(__m128i channels)
+    {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(channels, _mm_set1_epi16(527)), _mm_set1_epi16(23)), 6);
+    }
+#endif
+} // namespace
+
+void PixelConversion::LookupPalette(const uint8_t *indices, const uint32_t *palette, uint8_t *dst, size_t nPixels)
+{
+    size_t pixelIdx = 0;
+
+#if defined(PIXEL_CONVERSION_AVX2)
+    for (; pixelIdx + 8 <= nPixels; pixelIdx += 8)
+    {
+        __m256i paletteIndices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(indices + pixelIdx)));
+        __m256i colours        = _mm256_i32gather_epi32(reinterpret_cast<const int *>(palette), paletteIndices, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + pixelIdx * 4), colours);
+    }
+#endif
+
+    for (; pixelIdx < nPixels; ++pixelIdx)
+    {
+        memcpy(dst + pixelIdx * 4, &palette[indices[pixelIdx]], sizeof(uint32_t));
+    }
+}
+
+void PixelConversion::BGR8ToRGBA8(const uint8_t *src, uint8_t *dst, size_t nPixels)
+{
+    SwizzleBGR8<false>(src, dst, nPixels, 0, 0, 0);
+}
+
+bool PixelConversion::BGR8ToRGBA8ColourKey(const uint8_t *src, uint8_t *dst, size_t nPixels, uint8_t keyRed, uint8_t keyGreen, uint8_t keyBlue)
+{
+    return SwizzleBGR8<true>(src, dst, nPixels, keyRed, keyGreen, keyBlue);
+}
+
+void PixelConversion::ARGB1555ToRGBA8(const uint8_t *src, uint8_t *dst, size_t nPixels)
+{
+    size_t pixelIdx = 0;
+
+#if defined(PIXEL_CONVERSION_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; pixelIdx + 8 <= nPixels; pixelIdx += 8)
+    {
+        __m128i colours = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + pixelIdx * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + pixelIdx * 4), ExpandARGB1555(_mm_unpacklo_epi16(colours, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + pixelIdx * 4 + 16), ExpandARGB1555(_mm_unpackhi_epi16(colours, zero)));
+    }
+#endif
+
+    for (; pixelIdx < nPixels; ++pixelIdx)
+    {
+        uint16_t colour = static_cast<uint16_t>(src[pixelIdx * 2] | (src[pixelIdx * 2 + 1] << 8));
+        PutPixel(dst + pixelIdx * 4, ((colour >> 10) & 0x1F) << 3, ((colour >> 5) & 0x1F) << 3, (colour & 0x1F) << 3, (colour & 0x8000) ? 0xFF : 0x00);
+    }
+}
+
+void PixelConversion::ARGB4444ToRGBA8(const uint8_t *src, uint8_t *dst, size_t nPixels)
+{
+    size_t pixelIdx = 0;
+
+#if defined(PIXEL_CONVERSION_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; pixelIdx + 8 <= nPixels; pixelIdx += 8)
+    {
+        __m128i colours = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + pixelIdx * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + pixelIdx * 4), ExpandARGB4444(_mm_unpacklo_epi16(colours, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + pixelIdx * 4 + 16), ExpandARGB4444(_mm_unpackhi_epi16(colours, zero)));
+    }
+#endif
+
+    for (; pixelIdx < nPixels; ++pixelIdx)
+    {
+        const uint8_t *pixel = src + pixelIdx * 2;
+        PutPixel(dst + pixelIdx * 4, 0x11 * (pixel[1] & 0xF), 0x11 * (pixel[0] >> 4), 0x11 * (pixel[0] & 0xF), 0x11 * (pixel[1] >> 4));
+    }
+}
+
+void PixelConversion::ABGR1555ToARGB8888(const uint16_t *src, uint32_t *dst, size_t nPixels)
+{
+    size_t pixelIdx = 0;
+
+#if defined(PIXEL_CONVERSION_SSE2)
+    const __m128i channelMask = _mm_set1_epi16(0x1F);
+    const __m128i alphaMask   = _mm_set1_epi16(static_cast<short>(0xFF00));
+    for (; pixelIdx + 8 <= nPixels; pixelIdx += 8)
+    {
+        __m128i colours   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + pixelIdx));
+        __m128i red       = Expand5To8(_mm_and_si128(colours, channelMask));
+        __m128i green     = Expand5To8(_mm_and_si128(_mm_srli_epi16(colours, 5), channelMask));
+        __m128i blue      = Expand5To8(_mm_and_si128(_mm_srli_epi16(colours, 10), channelMask));
+        // Opaque when the STP bit is set on black, or clear on anything else
+        __m128i isBlack   = _mm_cmpeq_epi16(_mm_and_si128(colours, _mm_set1_epi16(0x7FFF)), _mm_setzero_si128());
+        __m128i opaque    = _mm_cmpeq_epi16(_mm_srai_epi16(colours, 15), isBlack);
+        __m128i lowBytes  = _mm_or_si128(blue, _mm_slli_epi16(green, 8));
+        __m128i highBytes = _mm_or_si128(red, _mm_and_si128(opaque, alphaMask));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + pixelIdx), _mm_unpacklo_epi16(lowBytes, highBytes));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + pixelIdx + 4), _mm_unpackhi_epi16(lowBytes, highBytes));
+    }
+#endif
+
+    for (; pixelIdx < nPixels; ++pixelIdx)
+    {
+        uint16_t colour = src[pixelIdx];
+        uint32_t red    = Expand5To8(colour & 0x1F);
+        uint32_t green  = Expand5To8((colour >> 5) & 0x1F);
+        uint32_t blue   = Expand5To8((colour >> 10) & 0x1F);
+        uint32_t alpha  = (((colour & 0x8000) != 0) == ((colour & 0x7FFF) == 0)) ? 255 : 0;
+        dst[pixelIdx]   = alpha << 24 | red << 16 | green << 8 | blue;
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Bulk pixel format conversion kernels for the texture loaders. Each has a scalar path, plus SSE2/SSSE3/AVX2 paths that are picked at compile time
+// from the instruction sets the build targets (x86-64 always has SSE2, build with -mavx2 or /arch:AVX2 for the rest). All paths produce identical output.
+// Destinations are RGBA8 byte order unless stated otherwise, and may be unaligned.
+class PixelConversion
+{
+public:
+    // dst[i] = palette[indices[i]], where palette is 256 entries already laid out in destination byte order
+    static void LookupPalette(const uint8_t *indices, const uint32_t *palette, uint8_t *dst, size_t nPixels);
+    // BGR8 (BMP/FSH 24 bit order) to opaque RGBA8
+    static void BGR8ToRGBA8(const uint8_t *src, uint8_t *dst, size_t nPixels);
+    // As above, but pixels matching the RGB colour key get zero alpha. Returns true if any pixel was keyed out.
+    static bool BGR8ToRGBA8ColourKey(const uint8_t *src, uint8_t *dst, size_t nPixels, uint8_t keyRed, uint8_t keyGreen, uint8_t keyBlue);
+    // Little endian FSH 1:5:5:5 to RGBA8, truncating expansion and 1 bit alpha as fshtool did
+    static void ARGB1555ToRGBA8(const uint8_t *src, uint8_t *dst, size_t nPixels);
+    // Little endian FSH 4:4:4:4 to RGBA8
+    static void ARGB4444ToRGBA8(const uint8_t *src, uint8_t *dst, size_t nPixels);
+    // PSX 1:5:5:5 to packed ARGB8888 words, bit exact with ImageLoader::abgr1555ToARGB8888
+    static void ABGR1555ToARGB8888(const uint16_t *src, uint32_t *dst, size_t nPixels);
+};
@@ -0,0 +1,396 @@
+#include "QfsArchive.h"
+#include "BlockCompression.h"
+#include "PixelConversion.h"
+#include "RefPack.h"
+
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    const size_t FSH_HEADER_SIZE = sizeof(FSH_HDR);
+
+    // Writes a top-down source row to its position in the bottom-up RGBA8 output
+    inline GLubyte *OutputRow(GLubyte *bits, int width, int height, int row)
+    {
+        return bits + (static_cast<size_t>(height - 1 - row) * width * 4);
+    }
+
+    inline void PutPixel(GLubyte *pixel, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+    {
+        pixel[0] = red;
+        pixel[1] = green;
+        pixel[2] = blue;
+        pixel[3] = alpha;
+    }
+} // namespace
+
+QfsArchive::QfsArchive(const std::string &qfsPath)
+{
+    std::ifstream qfs(qfsPath, std::ios::in | std::ios::binary);
+    if (!qfs.is_open())
+    {
+        LOG(WARNING) << "Unable to open QFS file " << qfsPath;
+        return;
+    }
+    m_fshData.assign(std::istreambuf_iterator<char>(qfs), std::istreambuf_iterator<char>());
+
+    // RefPack compressed (QFS) rather than raw FSH
+    if (RefPack::IsCompressed(m_fshData.data(), m_fshData.size()))
+    {
+        std::vector<uint8_t> fshData;
+        if (!RefPack::Decompress(m_fshData.data(), m_fshData.size(), fshData))
+        {
+            LOG(WARNING) << qfsPath << " has corrupt compressed data";
+            return;
+        }
+        m_fshData.swap(fshData);
+    }
+
+    if (m_fshData.size() < FSH_HEADER_SIZE || strncmp(reinterpret_cast<const char *>(m_fshData.data()), "SHPI", 4) != 0)
+    {
+        LOG(WARNING) << qfsPath << " is not a valid QFS/FSH file";
+        return;
+    }
+
+    const FSH_HDR *fshHeader = reinterpret_cast<const FSH_HDR *>(m_fshData.data());
+    if (fshHeader->nbmp < 0 || static_cast<size_t>(fshHeader->nbmp) > (m_fshData.size() - FSH_HEADER_SIZE) / sizeof(BMPDIR))
+    {
+        LOG(WARNING) << qfsPath << " has a corrupt directory";
+        return;
+    }
+    m_directory.resize(fshHeader->nbmp);
+    memcpy(m_directory.data(), m_fshData.data() + FSH_HEADER_SIZE, fshHeader->nbmp * sizeof(BMPDIR));
+
+    // Same rules as fshtool: the global palette is the last palette up to and including any '!pal' entry
+    bool foundPaletteEntry = false;
+    for (uint32_t entryIdx = 0; entryIdx < m_directory.size(); ++entryIdx)
+    {
+        const ENTRYHDR *entryHeader = _GetEntryHeader(m_directory[entryIdx].ofs);
+        if (entryHeader == nullptr)
+        {
+            LOG(WARNING) << qfsPath << " has a corrupt directory";
+            return;
+        }
+        if (foundPaletteEntry)
+        {
+            continue;
+        }
+        if (_IsPalette(entryHeader->code & 0xFF))
+        {
+            m_globalPaletteIdx = entryIdx;
+        }
+        foundPaletteEntry = strncmp(m_directory[entryIdx].name, "!pal", 4) == 0;
+    }
+
+    m_isOpen = true;
+}
+
+bool QfsArchive::IsOpen() const
+{
+    return m_isOpen;
+}
+
+uint32_t QfsArchive::GetEntryCount() const
+{
+    return static_cast<uint32_t>(m_directory.size());
+}
+
+bool QfsArchive::DecodeEntry(uint32_t entryIdx, GLubyte **bits, GLsizei *width, GLsizei *height) const
+{
+    if (!m_isOpen || entryIdx >= m_directory.size())
+    {
+        return false;
+    }
+
+    uint32_t entryOffset        = m_directory[entryIdx].ofs;
+    uint32_t entryEnd           = _GetEntryEnd(entryIdx);
+    const ENTRYHDR *entryHeader = _GetEntryHeader(entryOffset);
+    int entryCode               = entryHeader->code & 0x7F;
+    if (entryHeader->width <= 0 || entryHeader->height <= 0 || entryEnd < entryOffset + sizeof(ENTRYHDR))
+    {
+        return false;
+    }
+
+    // Walk the attachments looking for a local palette, falling back to the global palette
+    const int *palette   = nullptr;
+    bool paletteHasAlpha = false;
+    int localPalette[256] = {}, localPaletteLength;
+    if (entryCode == 0x7B)
+    {
+        uint32_t attachmentOffset        = entryOffset;
+        const ENTRYHDR *attachmentHeader = entryHeader;
+        int32_t paletteOffset            = -1;
+        while ((attachmentHeader->code >> 8) > 0)
+        {
+            attachmentOffset += (attachmentHeader->code >> 8);
+            if (attachmentOffset >= entryEnd || (attachmentHeader = _GetEntryHeader(attachmentOffset)) == nullptr)
+            {
+                break;
+            }
+            if (_IsPalette(attachmentHeader->code & 0xFF))
+            {
+                paletteOffset = attachmentOffset;
+            }
+        }
+        if (paletteOffset < 0 && m_globalPaletteIdx >= 0)
+        {
+            paletteOffset = m_directory[m_globalPaletteIdx].ofs;
+        }
+        if (paletteOffset < 0)
+        {
+            return false;
+        }
+        const ENTRYHDR *paletteHeader = _GetEntryHeader(paletteOffset);
+        size_t paletteEntrySize = ((paletteHeader->code & 0xFF) == 0x2A) ? 4 : ((paletteHeader->code & 0xFF) == 0x2D || (paletteHeader->code & 0xFF) == 0x29) ? 2 : 3;
+        if (paletteHeader->width < 0 || paletteHeader->width > 256 || paletteOffset + sizeof(ENTRYHDR) + paletteHeader->width * paletteEntrySize > m_fshData.size())
+        {
+            return false;
+        }
+        makepal(const_cast<unsigned char *>(m_fshData.data() + paletteOffset), &localPaletteLength, localPalette);
+        palette         = localPalette;
+        paletteHasAlpha = _PaletteHasAlpha(paletteHeader->code & 0xFF);
+    }
+
+    const uint8_t *pixels;
+    size_t pixelsSize;
+    std::vector<uint8_t> unpacked;
+    if (!_GetEntryPixels(entryIdx, &pixels, &pixelsSize, unpacked))
+    {
+        return false;
+    }
+
+    *width  = entryHeader->width;
+    *height = entryHeader->height;
+    *bits   = new GLubyte[static_cast<size_t>(*width) * *height * 4];
+
+    bool decoded = _DecodePixels(entryHeader, pixels, pixelsSize, palette, paletteHasAlpha, *bits);
+    if (!decoded)
+    {
+        delete[] * bits;
+        *bits = nullptr;
+    }
+
+    return decoded;
+}
+
+bool QfsArchive::GetEntryDxtColourBlocks(uint32_t entryIdx, std::vector<uint8_t> &colourBlocks) const
+{
+    if (!m_isOpen || entryIdx >= m_directory.size())
+    {
+        return false;
+    }
+
+    const ENTRYHDR *entryHeader = _GetEntryHeader(m_directory[entryIdx].ofs);
+    int entryCode               = entryHeader->code & 0x7F;
+    const uint8_t *pixels;
+    size_t pixelsSize;
+    std::vector<uint8_t> unpacked;
+    if ((entryCode != 0x60 && entryCode != 0x61) || entryHeader->width <= 0 || entryHeader->height <= 0 || (entryHeader->width % 4) || (entryHeader->height % 4) ||
+        !_GetEntryPixels(entryIdx, &pixels, &pixelsSize, unpacked))
+    {
+        return false;
+    }
+    // DXT3 blocks lead with 8 bytes of explicit alpha
+    size_t blockSize = entryCode == 0x61 ? 16 : 8;
+    int nBlocksX     = entryHeader->width / 4;
+    int nBlocksY     = entryHeader->height / 4;
+    if (pixelsSize < static_cast<size_t>(nBlocksX) * nBlocksY * blockSize)
+    {
+        return false;
+    }
+
+    colourBlocks.resize(static_cast<size_t>(nBlocksX) * nBlocksY * 8);
+    for (int blockRow = 0; blockRow < nBlocksY; ++blockRow)
+    {
+        for (int blockCol = 0; blockCol < nBlocksX; ++blockCol)
+        {
+            const uint8_t *block = pixels + (static_cast<size_t>(blockRow) * nBlocksX + blockCol) * blockSize + (blockSize - 8);
+            uint8_t *colourBlock = colourBlocks.data() + (static_cast<size_t>(nBlocksY - 1 - blockRow) * nBlocksX + blockCol) * 8;
+            memcpy(colourBlock, block, 8);
+            BlockCompression::FlipColourBlock(colourBlock);
+        }
+    }
+    return true;
+}
+
+bool QfsArchive::_GetEntryPixels(uint32_t entryIdx, const uint8_t **pixels, size_t *pixelsSize, std::vector<uint8_t> &unpacked) const
+{
+    // Pixel data follows the entry header, RefPack compressed if the top bit of the code is set
+    uint32_t entryOffset        = m_directory[entryIdx].ofs;
+    uint32_t entryEnd           = _GetEntryEnd(entryIdx);
+    const ENTRYHDR *entryHeader = _GetEntryHeader(entryOffset);
+    if (entryEnd < entryOffset + sizeof(ENTRYHDR))
+    {
+        return false;
+    }
+    *pixels     = m_fshData.data() + entryOffset + sizeof(ENTRYHDR);
+    *pixelsSize = entryEnd - entryOffset - sizeof(ENTRYHDR);
+    if (entryHeader->code & 0x80)
+    {
+        if (!RefPack::Decompress(*pixels, *pixelsSize, unpacked))
+        {
+            return false;
+        }
+        *pixels     = unpacked.data();
+        *pixelsSize = unpacked.size();
+    }
+    return true;
+}
+
+const ENTRYHDR *QfsArchive::_GetEntryHeader(uint32_t offset) const
+{
+    if (offset < FSH_HEADER_SIZE || offset + sizeof(ENTRYHDR) > m_fshData.size())
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const ENTRYHDR *>(m_fshData.data() + offset);
+}
+
+uint32_t QfsArchive::_GetEntryEnd(uint32_t entryIdx) const
+{
+    // Entries aren't guaranteed to be stored in directory order, next entry is the nearest one following this
+    uint32_t entryEnd = static_cast<uint32_t>(m_fshData.size());
+    for (auto &directoryEntry : m_directory)
+    {
+        if (static_cast<uint32_t>(directoryEntry.ofs) > static_cast<uint32_t>(m_directory[entryIdx].ofs) && static_cast<uint32_t>(directoryEntry.ofs) < entryEnd)
+        {
+            entryEnd = directoryEntry.ofs;
+        }
+    }
+    return entryEnd;
+}
+
+bool QfsArchive::_DecodePixels(const ENTRYHDR *header, const uint8_t *pixels, size_t pixelsSize, const int *palette, bool paletteHasAlpha, GLubyte *bits) const
+{
+    int width      = header->width;
+    int height     = header->height;
+    size_t nPixels = static_cast<size_t>(width) * height;
+
+    // Channel orders below mirror what fshtool wrote into the (BGR) BMPs, so textures come out identical to the old extract + reload
+    switch (header->code & 0x7F)
+    {
+    case 0x7B: // 8 bit palettised
+    {
+        if (pixelsSize < nPixels)
+        {
+            return false;
+        }
+        uint32_t rgbaPalette[256];
+        for (int colourIdx = 0; colourIdx < 256; ++colourIdx)
+        {
+            uint32_t colour = static_cast<uint32_t>(palette[colourIdx]);
+            PutPixel(reinterpret_cast<GLubyte *>(&rgbaPalette[colourIdx]), (colour >> 16) & 0xFF, (colour >> 8) & 0xFF, colour & 0xFF, paletteHasAlpha ? (colour >> 24) : 0xFF);
+        }
+        for (int row = 0; row < height; ++row)
+        {
+            PixelConversion::LookupPalette(pixels + static_cast<size_t>(row) * width, rgbaPalette, OutputRow(bits, width, height, row), width);
+        }
+        return true;
+    }
+    case 0x7D: // 32 bit 8:8:8:8
+        if (pixelsSize < nPixels * 4)
+        {
+            return false;
+        }
+        for (int row = 0; row < height; ++row)
+        {
+            const uint8_t *src = pixels + static_cast<size_t>(row) * width * 4;
+            GLubyte *dst       = OutputRow(bits, width, height, row);
+            for (int col = 0; col < width; ++col, src += 4, dst += 4)
+            {
+                PutPixel(dst, src[2], src[1], src[0], src[3]);
+            }
+        }
+        return true;
+    case 0x7F: // 24 bit 0:8:8:8
+        if (pixelsSize < nPixels * 3)
+        {
+            return false;
+        }
+        for (int row = 0; row < height; ++row)
+        {
+            PixelConversion::BGR8ToRGBA8(pixels + static_cast<size_t>(row) * width * 3, OutputRow(bits, width, height, row), width);
+        }
+        return true;
+    case 0x7E: // 16 bit 1:5:5:5
+    case 0x78: // 16 bit 0:5:6:5
+    case 0x6D: // 16 bit 4:4:4:4
+        if (pixelsSize < nPixels * 2)
+        {
+            return false;
+        }
+        for (int row = 0; row < height; ++row)
+        {
+            const uint8_t *src = pixels + static_cast<size_t>(row) * width * 2;
+            GLubyte *dst       = OutputRow(bits, width, height, row);
+            switch (header->code & 0x7F)
+            {
+            case 0x7E:
+                PixelConversion::ARGB1555ToRGBA8(src, dst, width);
+                break;
+            case 0x78:
+                for (int col = 0; col < width; ++col, src += 2, dst += 4)
+                {
+                    uint16_t colour = static_cast<uint16_t>(src[0] | (src[1] << 8));
+                    PutPixel(dst, ((colour >> 11) & 0x1F) << 3, ((colour >> 5) & 0x3F) << 2, (colour & 0x1F) << 3, 0xFF);
+                }
+                break;
+            default:
+                PixelConversion::ARGB4444ToRGBA8(src, dst, width);
+                break;
+            }
+        }
+        return true;
+    case 0x61: // DXT3
+    case 0x60: // DXT1
+    {
+        bool isDxt3      = (header->code & 0x7F) == 0x61;
+        size_t blockSize = isDxt3 ? 16 : 8;
+        if ((width % 4) || (height % 4) || pixelsSize < (nPixels / 16) * blockSize)
+        {
+            return false;
+        }
+        for (int blockRow = 0; blockRow < height / 4; ++blockRow)
+        {
+            for (int blockCol = 0; blockCol < width / 4; ++blockCol)
+            {
+                const uint8_t *block      = pixels + (static_cast<size_t>(blockRow) * (width / 4) + blockCol) * blockSize;
+                const uint8_t *colourData = isDxt3 ? block + 8 : block;
+                uint16_t colour1          = static_cast<uint16_t>(colourData[0] | (colourData[1] << 8));
+                uint16_t colour2          = static_cast<uint16_t>(colourData[2] | (colourData[3] << 8));
+                for (int y = 0; y < 4; ++y)
+                {
+                    GLubyte *dst = OutputRow(bits, width, height, blockRow * 4 + y) + blockCol * 16;
+                    for (int x = 0; x < 4; ++x, dst += 4)
+                    {
+                        // unpack_dxt hands back the channels in BMP (BGR) order
+                        unsigned char bgr[3];
+                        unpack_dxt(static_cast<unsigned char>((colourData[4 + y] >> (2 * x)) & 3), colour1, colour2, bgr);
+                        uint8_t alpha = 0xFF;
+                        if (isDxt3)
+                        {
+                            alpha = 0x11 * ((block[2 * y + (x >> 1)] >> (4 * (x & 1))) & 0xF);
+                        }
+                        PutPixel(dst, bgr[2], bgr[1], bgr[0], alpha);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    default:
+        LOG(WARNING) << "Unsupported FSH bitmap type " << std::hex << (header->code & 0xFF);
+        return false;
+    }
+}
+
+bool QfsArchive::_IsPalette(int code)
+{
+    return (code == 0x22) || (code == 0x24) || (code == 0x2D) || (code == 0x2A) || (code == 0x29);
+}
+
+bool QfsArchive::_PaletteHasAlpha(int code)
+{
+    return (code == 0x2D) || (code == 0x2A);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ImageLoader.h"
+
+// In-memory QFS/FSH texture pack. The pack is read (and decompressed) once, entries are then decoded straight to RGBA8 on request,
+// replacing the fshtool extraction to BMP on disk and reload via LoadBmpWithAlpha.
+class QfsArchive
+{
+public:
+    explicit QfsArchive(const std::string &qfsPath);
+    bool IsOpen() const;
+    uint32_t GetEntryCount() const;
+    // Produces RGBA8 rows bottom-up, matching the layout of the BMPs previously extracted by fshtool
+    bool DecodeEntry(uint32_t entryIdx, GLubyte **bits, GLsizei *width, GLsizei *height) const;
+    // DXT1/DXT3 packed entries only, the 8 byte colour half of each 4x4 block in the same bottom-up order as DecodeEntry, so the blocks can go
+    // straight into a compressed texture rather than being decoded and re-encoded
+    bool GetEntryDxtColourBlocks(uint32_t entryIdx, std::vector<uint8_t> &colourBlocks) const;
+
+private:
+    const ENTRYHDR *_GetEntryHeader(uint32_t offset) const;
+    uint32_t _GetEntryEnd(uint32_t entryIdx) const;
+    bool _GetEntryPixels(uint32_t entryIdx, const uint8_t **pixels, size_t *pixelsSize, std::vector<uint8_t> &unpacked) const;
+    bool _DecodePixels(const ENTRYHDR *header, const uint8_t *pixels, size_t pixelsSize, const int *palette, bool paletteHasAlpha, GLubyte *bits) const;
+    static bool _IsPalette(int code);
+    static bool _PaletteHasAlpha(int code);
+
+    std::vector<uint8_t> m_fshData;
+    std::vector<BMPDIR> m_directory;
+    int32_t m_globalPaletteIdx = -1;
+    bool m_isOpen              = false;
+};
@@ -0,0 +1,167 @@
+#include "RefPack.h"
+
+#include <cstring>
+
+namespace
+{
+    // Copies are done in fixed 16 byte chunks where there's room, which compile down to single unaligned vector moves rather than a memcpy call
+    const size_t WIDE_COPY_SIZE = 16;
+
+    // Back reference copy. The match may overlap its own output (offset < length) to repeat a run, so chunks are never wider than the offset.
+    inline void CopyMatch(uint8_t *dst, size_t offset, size_t length, const uint8_t *dstEnd)
+    {
+        const uint8_t *src = dst - offset;
+        if (offset >= WIDE_COPY_SIZE && dst + length + WIDE_COPY_SIZE <= dstEnd)
+        {
+            // May write up to 15 bytes past the match, which the following tokens then overwrite
+            for (size_t copied = 0; copied < length; copied += WIDE_COPY_SIZE)
+            {
+                memcpy(dst + copied, src + copied, WIDE_COPY_SIZE);
+            }
+        }
+        else if (offset >= length)
+        {
+            memcpy(dst, src, length);
+        }
+        else if (offset == 1)
+        {
+            memset(dst, *src, length);
+        }
+        else
+        {
+            while (length > 0)
+            {
+                size_t chunk = length < offset ? length : offset;
+                memcpy(dst, src, chunk);
+                dst += chunk;
+                src += chunk;
+                length -= chunk;
+            }
+        }
+    }
+
+    inline void CopyLiterals(uint8_t *dst, const uint8_t *src, size_t length, const uint8_t *dstEnd, const uint8_t *srcEnd)
+    {
+        if (length <= WIDE_COPY_SIZE && dst + WIDE_COPY_SIZE <= dstEnd && src + WIDE_COPY_SIZE <= srcEnd)
+        {
+            memcpy(dst, src, WIDE_COPY_SIZE);
+        }
+        else
+        {
+            memcpy(dst, src, length);
+        }
+    }
+} // namespace
+
+bool RefPack::IsCompressed(const uint8_t *src, size_t srcSize)
+{
+    return srcSize >= 5 && (src[0] & 0xFE) == 0x10 && src[1] == 0xFB && srcSize >= _GetHeaderSize(src);
+}
+
+size_t RefPack::GetDecompressedSize(const uint8_t *src, size_t srcSize)
+{
+    if (!IsCompressed(src, srcSize))
+    {
+        return 0;
+    }
+
+    return (static_cast<size_t>(src[2]) << 16) | (static_cast<size_t>(src[3]) << 8) | src[4];
+}
+
+bool RefPack::Decompress(const uint8_t *src, size_t srcSize, std::vector<uint8_t> &dst)
+{
+    if (!IsCompressed(src, srcSize))
+    {
+        return false;
+    }
+    dst.resize(GetDecompressedSize(src, srcSize));
+
+    const uint8_t *in     = src + _GetHeaderSize(src);
+    const uint8_t *inEnd  = src + srcSize;
+    uint8_t *out          = dst.data();
+    uint8_t *const outBeg = dst.data();
+    uint8_t *const outEnd = dst.data() + dst.size();
+
+    while (in < inEnd)
+    {
+        uint8_t packCode = in[0];
+        size_t tokenSize, nLiterals, matchLength, matchOffset;
+
+        if (!(packCode & 0x80))
+        {
+            // 0oolllpp oooooooo: up to 3 literals, then a 3-10 byte match up to 1KB back
+            if (inEnd - in < 2)
+            {
+                return false;
+            }
+            tokenSize   = 2;
+            nLiterals   = packCode & 0x03;
+            matchLength = ((packCode & 0x1C) >> 2) + 3;
+            matchOffset = ((packCode >> 5) << 8) + in[1] + 1;
+        }
+        else if (!(packCode & 0x40))
+        {
+            // 10llllll ppoooooo oooooooo: up to 3 literals, then a 4-67 byte match up to 16KB back
+            if (inEnd - in < 3)
+            {
+                return false;
+            }
+            tokenSize   = 3;
+            nLiterals   = (in[1] >> 6) & 0x03;
+            matchLength = (packCode & 0x3F) + 4;
+            matchOffset = ((in[1] & 0x3F) << 8) + in[2] + 1;
+        }
+        else if (!(packCode & 0x20))
+        {
+            // 110ollpp oooooooo oooooooo llllllll: up to 3 literals, then a 5-1028 byte match up to 128KB back
+            if (inEnd - in < 4)
+            {
+                return false;
+            }
+            tokenSize   = 4;
+            nLiterals   = packCode & 0x03;
+            matchLength = (((packCode >> 2) & 0x03) << 8) + in[3] + 5;
+            matchOffset = ((packCode & 0x10) << 12) + (in[1] << 8) + in[2] + 1;
+        }
+        else
+        {
+            // 111ppppp: 4-112 literals, or 0-3 trailing literals to end the stream for 0xFC and above
+            tokenSize   = 1;
+            nLiterals   = (packCode < 0xFC) ? ((packCode & 0x1F) << 2) + 4 : packCode & 0x03;
+            matchLength = 0;
+            matchOffset = 0;
+        }
+        in += tokenSize;
+
+        if (static_cast<size_t>(inEnd - in) < nLiterals || static_cast<size_t>(outEnd - out) < nLiterals + matchLength)
+        {
+            return false;
+        }
+        CopyLiterals(out, in, nLiterals, outEnd, inEnd);
+        in += nLiterals;
+        out += nLiterals;
+
+        if (matchLength > 0)
+        {
+            if (matchOffset > static_cast<size_t>(out - outBeg))
+            {
+                return false;
+            }
+            CopyMatch(out, matchOffset, matchLength, outEnd);
+            out += matchLength;
+        }
+
+        if (packCode >= 0xFC)
+        {
+            break;
+        }
+    }
+
+    return out == outEnd;
+}
+
+size_t RefPack::_GetHeaderSize(const uint8_t *src)
+{
+    // 0x01 flag: the compressed size follows the decompressed size
+    return (src[0] & 0x01) ? 8 : 5;
+}
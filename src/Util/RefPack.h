@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// EA RefPack (0x10FB) LZ77 decompression, as used by compressed CRP cars, QFS texture packs and their entries, working directly on memory buffers.
+// Every token is bounds checked against both buffers, so truncated or corrupt streams fail cleanly rather than reading or writing out of range.
+class RefPack
+{
+public:
+    // True if the buffer starts with a RefPack header (0x10FB, or 0x11FB with the compressed size field present)
+    static bool IsCompressed(const uint8_t *src, size_t srcSize);
+    // Size of the decompressed data as stated by the header, 0 if not RefPack
+    static size_t GetDecompressedSize(const uint8_t *src, size_t srcSize);
+    // Decompresses the whole stream into dst, resized to the header size. Returns false if the stream is corrupt or does not produce exactly that many bytes.
+    static bool Decompress(const uint8_t *src, size_t srcSize, std::vector<uint8_t> &dst);
+
+private:
+    static size_t _GetHeaderSize(const uint8_t *src);
+};
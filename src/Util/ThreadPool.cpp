@@ -0,0 +1,130 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace
+{
+    // Shared between the caller of ParallelFor and any helper tasks, which may still be queued after the caller has returned
+    struct ParallelForState
+    {
+        ParallelForState(size_t count, std::function<void(size_t)> task) : count(count), task(std::move(task))
+        {
+        }
+
+        void RunUntilExhausted()
+        {
+            size_t idx;
+            while ((idx = nextIdx++) < count)
+            {
+                try
+                {
+                    task(idx);
+                }
+                catch (...)
+                {
+                    // Still counts as completed, so the caller isn't left waiting on it, and rethrows the first failure once it's done waiting
+                    std::lock_guard<std::mutex> lock(completionMutex);
+                    if (!exception)
+                    {
+                        exception = std::current_exception();
+                    }
+                }
+                if (++nCompleted == count)
+                {
+                    std::lock_guard<std::mutex> lock(completionMutex);
+                    completionCondition.notify_all();
+                }
+            }
+        }
+
+        const size_t count;
+        const std::function<void(size_t)> task;
+        std::atomic<size_t> nextIdx{0};
+        std::atomic<size_t> nCompleted{0};
+        std::mutex completionMutex;
+        std::condition_variable completionCondition;
+        // First exception any item threw, guarded by completionMutex
+        std::exception_ptr exception;
+    };
+} // namespace
+
+ThreadPool::ThreadPool(uint32_t nThreads)
+{
+    nThreads = std::max(nThreads, 1u);
+    m_workers.reserve(nThreads);
+    for (uint32_t threadIdx = 0; threadIdx < nThreads; ++threadIdx)
+    {
+        m_workers.emplace_back(&ThreadPool::_WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopping = true;
+    }
+    m_queueCondition.notify_all();
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+ThreadPool &ThreadPool::Get()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)> &task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>(count, task);
+
+    // No point waking more helpers than there are items left over for them once the caller has taken one
+    size_t nHelpers = std::min<size_t>(m_workers.size(), count - 1);
+    for (size_t helperIdx = 0; helperIdx < nHelpers; ++helperIdx)
+    {
+        Enqueue([state]() { state->RunUntilExhausted(); });
+    }
+    state->RunUntilExhausted();
+
+    // Any items not run by this thread are already in flight on a worker, so this can't wait on a task that is stuck in the queue
+    std::unique_lock<std::mutex> lock(state->completionMutex);
+    state->completionCondition.wait(lock, [&state]() { return state->nCompleted == state->count; });
+    if (state->exception)
+    {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+uint32_t ThreadPool::GetThreadCount() const
+{
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+void ThreadPool::_WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this]() { return m_stopping || !m_taskQueue.empty(); });
+            if (m_stopping && m_taskQueue.empty())
+            {
+                return;
+            }
+            task = std::move(m_taskQueue.front());
+            m_taskQueue.pop();
+        }
+        task();
+    }
+}
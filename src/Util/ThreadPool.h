@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed size pool of worker threads for CPU side asset processing (parsing, texture decode etc.). Never touches GL.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(uint32_t nThreads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    // Shared pool used by the asset loaders
+    static ThreadPool &Get();
+
+    template <typename Task>
+    std::future<typename std::result_of<Task()>::type> Enqueue(Task &&task)
+    {
+        using ReturnType = typename std::result_of<Task()>::type;
+
+        auto packagedTask = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<Task>(task));
+        std::future<ReturnType> taskResult = packagedTask->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_taskQueue.emplace([packagedTask]() { (*packagedTask)(); });
+        }
+        m_queueCondition.notify_one();
+
+        return taskResult;
+    }
+
+    // Calls task(idx) for every idx in [0, count), blocking until all have completed. The calling thread takes part in the work,
+    // so this is safe to call from inside a task running on the pool. If any calls throw, the first exception is rethrown once all have completed.
+    void ParallelFor(size_t count, const std::function<void(size_t)> &task);
+
+    uint32_t GetThreadCount() const;
+
+private:
+    void _WorkerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_taskQueue;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCondition;
+    bool m_stopping = false;
+};
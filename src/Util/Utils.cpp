@@ -1,10 +1,14 @@
 #include "Utils.h"
+#include "RefPack.h"
+
+#include <iterator>
 
 namespace Utils
 {
     float RandomFloat(float min, float max)
     {
-        static std::mt19937 mt(std::random_device{}());
+        // Per thread, as cars may be loaded concurrently by the batch converter
+        static thread_local std::mt19937 mt(std::random_device{}());
         std::uniform_real_distribution<double> fdis(min, max);
 
         return static_cast<float>(fdis(mt));
@@ -249,152 +253,33 @@ namespace Utils
             return true;
         }
 
-        const char *filename = compressedCrpPath.c_str();
-
-        // Open file
-        std::ifstream file;
-        file.open(filename, std::ios::binary);
+        std::ifstream file(compressedCrpPath, std::ios::binary);
         ASSERT(file.is_open(), "Unable to open CRP at " << compressedCrpPath << " for decompression!");
+        std::vector<uint8_t> crpData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        file.close();
+        ASSERT(crpData.size() > 0x10, "CRP at " << compressedCrpPath << " has invalid file size");
 
-        // Check valid file length
-        file.seekg(0, std::ios::end);
-        std::streamoff filesize = file.tellg();
-        file.seekg(0);
-        ASSERT(filesize > 0x10, "CRP at " << compressedCrpPath << " has invalid file size");
-
-        // Initialization
-        unsigned int length = 0;
-        unsigned char *data = NULL;
-        // CRP compression type
-        unsigned int id = 0;
-        file.read((char *) &id, 4);
         // Uncompressed CRP
-        if ((id & 0x0000FFFF) != 0xFB10)
+        if (!RefPack::IsCompressed(crpData.data(), crpData.size()))
         {
-            file.close();
             LOG(INFO) << "CRP is already decompressed, skipping";
             boost::filesystem::copy_file(compressedCrpPath, decompressedCrpPath, boost::filesystem::copy_option::overwrite_if_exists);
             return true;
         }
-        // Compressed CRP
-        else
+
+        std::vector<uint8_t> decompressedData;
+        if (!RefPack::Decompress(crpData.data(), crpData.size(), decompressedData))
         {
-            // Create uncompressed data array
-            file.seekg(2);
-            unsigned int elhi, elmd, ello;
-            elhi = elmd = ello = 0;
-            file.read((char *) &elhi, 1);
-            file.read((char *) &elmd, 1);
-            file.read((char *) &ello, 1);
-            length = (((elhi * 256) + elmd) * 256) + ello;
-            data   = new unsigned char[length];
-            // Memory allocation
-            ASSERT(data != NULL, "Unable to allocate buffer for decompressed CRP data! Possible invalid length read");
-            // Initialization
-            file.seekg(5);
-            unsigned int datapos, len, offset, inbyte, tmp1, tmp2, tmp3;
-            unsigned char *srcpos, *dstpos;
-            datapos = len = offset = inbyte = tmp1 = tmp2 = tmp3 = 0;
-            file.read((char *) &inbyte, 1);
-            // Decompress
-            while ((!file.eof()) && (inbyte < 0xFC))
-            {
-                if (!(inbyte & 0x80))
-                {
-                    file.read((char *) &tmp1, 1);
-                    len = inbyte & 0x03;
-                    if (len != 0)
-                    {
-                        file.read((char *) (data + datapos), len);
-                        datapos += len;
-                    }
-                    len = ((inbyte & 0x1C) >> 2) + 3;
-                    if (len != 0)
-                    {
-                        offset = ((inbyte >> 5) << 8) + tmp1 + 1;
-                        dstpos = data + datapos;
-                        srcpos = data + datapos - offset;
-                        datapos += len;
-                        while (len--)
-                            *dstpos++ = *srcpos++;
-                    }
-                }
-                else if (!(inbyte & 0x40))
-                {
-                    file.read((char *) &tmp1, 1);
-                    file.read((char *) &tmp2, 1);
-                    len = (tmp1 >> 6) & 0x03;
-                    if (len != 0)
-                    {
-                        file.read((char *) (data + datapos), len);
-                        datapos += len;
-                    }
-                    len = (inbyte & 0x3F) + 4;
-                    if (len != 0)
-                    {
-                        offset = ((tmp1 & 0x3F) * 256) + tmp2 + 1;
-                        srcpos = data + datapos - offset;
-                        dstpos = data + datapos;
-                        datapos += len;
-                        while (len--)
-                            *dstpos++ = *srcpos++;
-                    }
-                }
-                else if (!(inbyte & 0x20))
-                {
-                    file.read((char *) &tmp1, 1);
-                    file.read((char *) &tmp2, 1);
-                    file.read((char *) &tmp3, 1);
-                    len = inbyte & 0x03;
-                    if (len != 0)
-                    {
-                        file.read((char *) (data + datapos), len);
-                        datapos += len;
-                    }
-                    len = (((inbyte >> 2) & 0x03) * 256) + tmp3 + 5;
-                    if (len != 0)
-                    {
-                        offset = ((inbyte & 0x10) << 0x0C) + (tmp1 * 256) + tmp2 + 1;
-                        srcpos = data + datapos - offset;
-                        dstpos = data + datapos;
-                        datapos += len;
-                        while (len--)
-                            *dstpos++ = *srcpos++;
-                    }
-                }
-                else
-                {
-                    len = ((inbyte & 0x1F) * 4) + 4;
-                    if (len != 0)
-                    {
-                        file.read((char *) (data + datapos), len);
-                        datapos += len;
-                    }
-                }
-                inbyte = tmp1 = tmp2 = tmp3 = 0;
-                file.read((char *) &inbyte, 1);
-            }
-            if ((!file.eof()) && (datapos < length))
-            {
-                len = inbyte & 0x03;
-                if (len != 0)
-                {
-                    file.read((char *) (data + datapos), len);
-                }
-            }
+            LOG(WARNING) << "CRP at " << compressedCrpPath << " has corrupt compressed data";
+            return false;
         }
-        // Clean up
-        file.close();
 
         // Write out uncompressed data
-        std::ofstream ofile;
-        ofile.open(decompressedCrpPath.c_str(), std::ios::binary);
+        std::ofstream ofile(decompressedCrpPath, std::ios::binary);
         ASSERT(ofile.is_open(), "Unable to open output CRP at " << decompressedCrpPath << " for write of decompressed data");
-        ofile.write((const char *) data, length);
+        ofile.write(reinterpret_cast<const char *>(decompressedData.data()), decompressedData.size());
         ofile.close();
 
-        delete[] data;
-
         return true;
     }
 
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "../src/Physics/AABBTree.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <set>
+#include <vector>
+
+// Checks the BvH frustum query against testing every box against every plane, over a scattered, track sized set of boxes and randomly placed cameras.
+class AABBTreeTest : public testing::Test
+{
+public:
+    static const int N_OBJECTS = 5000;
+    static const int N_FRUSTA  = 100;
+
+    struct TestObject : public IAABB
+    {
+        AABB aabb;
+        AABB GetAABB() const override
+        {
+            return aabb;
+        }
+    };
+
+    virtual void SetUp()
+    {
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> positionDist(-1000.f, 1000.f), extentDist(0.5f, 30.f);
+        objects.resize(N_OBJECTS);
+        for (auto &object : objects)
+        {
+            glm::vec3 halfExtent(extentDist(rng), extentDist(rng), extentDist(rng));
+            object.aabb = AABB(-halfExtent, halfExtent, glm::vec3(positionDist(rng), positionDist(rng) * 0.05f, positionDist(rng)));
+        }
+        for (int frustumIdx = 0; frustumIdx < N_FRUSTA; ++frustumIdx)
+        {
+            glm::vec3 eye(positionDist(rng), positionDist(rng) * 0.05f, positionDist(rng));
+            glm::vec3 target(positionDist(rng), 0.f, positionDist(rng));
+            Frustum frustum;
+            frustum.Update(glm::perspective(glm::radians(45.f), 4.f / 3.f, 1.f, 500.f) * glm::lookAt(eye, target, glm::vec3(0, 1, 0)));
+            frusta.push_back(frustum);
+        }
+    }
+
+    static bool BruteForceOverlaps(const Frustum &frustum, const AABB &aabb)
+    {
+        glm::vec3 min = aabb.position + aabb.min, max = aabb.position + aabb.max;
+        for (auto &plane : frustum.GetPlanes())
+        {
+            bool allOutside = true;
+            for (int cornerIdx = 0; cornerIdx < 8; ++cornerIdx)
+            {
+                glm::vec3 corner(cornerIdx & 1 ? max.x : min.x, cornerIdx & 2 ? max.y : min.y, cornerIdx & 4 ? max.z : min.z);
+                allOutside &= glm::dot(glm::vec3(plane), corner) + plane.w < 0.f;
+            }
+            if (allOutside)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<TestObject> objects;
+    std::vector<Frustum> frusta;
+};
+
+TEST_F(AABBTreeTest, MatchesBruteForce)
+{
+    std::vector<const IAABB *> objectPtrs;
+    for (auto &object : objects)
+    {
+        objectPtrs.push_back(&object);
+    }
+    AABBTree tree;
+    tree.Build(objectPtrs);
+    ASSERT_EQ(tree.GetObjectCount(), objects.size());
+
+    size_t nVisible = 0;
+    std::vector<const IAABB *> overlaps;
+    for (auto &frustum : frusta)
+    {
+        overlaps.clear();
+        tree.QueryOverlaps(frustum, overlaps);
+        std::set<const IAABB *> overlapSet(overlaps.begin(), overlaps.end());
+        ASSERT_EQ(overlapSet.size(), overlaps.size()) << "Object reported twice";
+        for (auto &object : objects)
+        {
+            ASSERT_EQ(overlapSet.count(&object) > 0, BruteForceOverlaps(frustum, object.aabb));
+        }
+        nVisible += overlaps.size();
+    }
+    // Make sure the cameras actually saw something
+    ASSERT_GT(nVisible, 0u);
+}
+
+TEST_F(AABBTreeTest, EmptyAndSingleObject)
+{
+    AABBTree tree;
+    std::vector<const IAABB *> overlaps;
+    tree.Build({});
+    tree.QueryOverlaps(frusta[0], overlaps);
+    ASSERT_TRUE(overlaps.empty());
+
+    for (auto &object : objects)
+    {
+        if (BruteForceOverlaps(frusta[0], object.aabb))
+        {
+            tree.Build({&object});
+            tree.QueryOverlaps(frusta[0], overlaps);
+            ASSERT_EQ(overlaps.size(), 1u);
+            ASSERT_EQ(overlaps[0], &object);
+            return;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "../src/Util/BlockCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Round trips a noisy gradient texture with alpha tested holes through each format, checking the quality that comes back and that BC1 keeps the
+// holes exactly.
+class BlockCompressionTest : public testing::Test
+{
+public:
+    static const uint32_t WIDTH  = 256;
+    static const uint32_t HEIGHT = 256;
+
+    virtual void SetUp()
+    {
+        std::mt19937 rng(1337);
+        texels.resize(WIDTH * HEIGHT * 4);
+        for (uint32_t y = 0; y < HEIGHT; ++y)
+        {
+            for (uint32_t x = 0; x < WIDTH; ++x)
+            {
+                uint8_t *texel = &texels[(y * WIDTH + x) * 4];
+                texel[0]       = static_cast<uint8_t>(std::min<uint32_t>(x + rng() % 8, 255));
+                texel[1]       = static_cast<uint8_t>((x + y) / 2);
+                texel[2]       = static_cast<uint8_t>(255 - y);
+                texel[3]       = ((x / 9 + y / 7) % 5 == 0) ? 0 : 255;
+            }
+        }
+    }
+
+    // Over the texels that come back opaque in both, alpha excluded
+    static double ColourPSNR(const std::vector<uint8_t> &expected, const std::vector<uint8_t> &actual)
+    {
+        double squaredError = 0.0;
+        size_t nSamples     = 0;
+        for (size_t texelIdx = 0; texelIdx < expected.size() / 4; ++texelIdx)
+        {
+            if (expected[texelIdx * 4 + 3] == 0 || actual[texelIdx * 4 + 3] == 0)
+            {
+                continue;
+            }
+            for (int channelIdx = 0; channelIdx < 3; ++channelIdx)
+            {
+                double delta = expected[texelIdx * 4 + channelIdx] - actual[texelIdx * 4 + channelIdx];
+                squaredError += delta * delta;
+                ++nSamples;
+            }
+        }
+        return 10.0 * std::log10(255.0 * 255.0 / (squaredError / nSamples));
+    }
+
+    std::vector<uint8_t> RoundTrip(BlockCompression::Format format, const std::vector<uint8_t> &source, uint32_t width, uint32_t height)
+    {
+        std::vector<uint8_t> compressed(BlockCompression::GetCompressedSize(format, width, height)), decompressed(width * height * 4);
+        BlockCompression::CompressImage(format, source.data(), width, height, compressed.data());
+        BlockCompression::DecompressImage(format, compressed.data(), width, height, decompressed.data());
+        return decompressed;
+    }
+
+    std::vector<uint8_t> texels;
+};
+
+TEST_F(BlockCompressionTest, BC1)
+{
+    std::vector<uint8_t> decompressed = RoundTrip(BlockCompression::BC1, texels, WIDTH, HEIGHT);
+    ASSERT_GT(ColourPSNR(texels, decompressed), 38.0);
+    for (size_t texelIdx = 0; texelIdx < texels.size() / 4; ++texelIdx)
+    {
+        ASSERT_EQ(texels[texelIdx * 4 + 3], decompressed[texelIdx * 4 + 3]);
+    }
+}
+
+TEST_F(BlockCompressionTest, BC3)
+{
+    for (size_t texelIdx = 0; texelIdx < texels.size() / 4; ++texelIdx)
+    {
+        texels[texelIdx * 4 + 3] = static_cast<uint8_t>(texelIdx % 13 == 0 ? 0 : 128 + texelIdx % 128);
+    }
+    std::vector<uint8_t> decompressed = RoundTrip(BlockCompression::BC3, texels, WIDTH, HEIGHT);
+    ASSERT_GT(ColourPSNR(texels, decompressed), 38.0);
+    for (size_t texelIdx = 0; texelIdx < texels.size() / 4; ++texelIdx)
+    {
+        ASSERT_NEAR(texels[texelIdx * 4 + 3], decompressed[texelIdx * 4 + 3], 10);
+    }
+}
+
+TEST_F(BlockCompressionTest, PartialBlocksAndFlip)
+{
+    // A solid colour off the block grid comes back within 565 precision
+    std::vector<uint8_t> solid(5 * 3 * 4, 200);
+    std::vector<uint8_t> decompressed = RoundTrip(BlockCompression::BC3, solid, 5, 3);
+    for (size_t byteIdx = 0; byteIdx < solid.size(); ++byteIdx)
+    {
+        ASSERT_NEAR(solid[byteIdx], decompressed[byteIdx], 4);
+    }
+
+    uint8_t block[8], flippedTexels[64], texelsBlock[64];
+    BlockCompression::EncodeBlock(BlockCompression::BC1, texels.data(), block);
+    BlockCompression::DecodeBlock(BlockCompression::BC1, block, texelsBlock);
+    BlockCompression::FlipColourBlock(block);
+    BlockCompression::DecodeBlock(BlockCompression::BC1, block, flippedTexels);
+    for (int row = 0; row < 4; ++row)
+    {
+        ASSERT_EQ(memcmp(&texelsBlock[row * 16], &flippedTexels[(3 - row) * 16], 16), 0);
+    }
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "../src/Util/MipChain.h"
+
+#include <cmath>
+#include <vector>
+
+// Builds mips of a chain link fence style texture, thin opaque wires over transparent texels, checking that the alpha tested coverage holds up
+// through the chain where plain averaging lets it erode, and that colour doesn't pick up the transparent texels.
+namespace
+{
+    const float TOLERANCE = 0.03f;
+    // Level 1 texels average just four texels, leaving only a handful of alpha values to choose a threshold between, so the coverage there
+    // can only get as close as those allow
+    const float LEVEL_1_TOLERANCE = 0.1f;
+} // namespace
+
+class MipChainTest : public testing::Test
+{
+public:
+    static const uint32_t WIDTH    = 64;
+    static const uint32_t HEIGHT   = 64;
+    static const int N_LEVELS      = 4;
+    static const uint8_t ALPHA_REF = 128;
+
+    virtual void SetUp()
+    {
+        texels.resize(WIDTH * HEIGHT * 4);
+        for (uint32_t y = 0; y < HEIGHT; ++y)
+        {
+            for (uint32_t x = 0; x < WIDTH; ++x)
+            {
+                uint8_t *texel = &texels[(y * WIDTH + x) * 4];
+                bool wire      = (x + y) % 7 == 0 || (x + 2 * WIDTH - y) % 7 == 0;
+                // Transparent texels are black, as they tend to be in the source textures
+                texel[0] = wire ? 40 : 0;
+                texel[1] = wire ? 200 : 0;
+                texel[2] = wire ? 90 : 0;
+                texel[3] = wire ? 255 : 0;
+            }
+        }
+    }
+
+    std::vector<uint8_t> texels;
+};
+
+TEST_F(MipChainTest, PreservesAlphaCoverage)
+{
+    float coverage                           = MipChain::GetAlphaCoverage(texels.data(), WIDTH, HEIGHT, ALPHA_REF);
+    std::vector<std::vector<uint8_t>> levels = MipChain::Build(texels.data(), WIDTH, HEIGHT, N_LEVELS, ALPHA_REF);
+    ASSERT_EQ(levels.size(), static_cast<size_t>(N_LEVELS - 1));
+
+    std::vector<uint8_t> averaged = texels;
+    for (int level = 1; level < N_LEVELS; ++level)
+    {
+        uint32_t levelWidth = MipChain::GetLevelDimension(WIDTH, level), levelHeight = MipChain::GetLevelDimension(HEIGHT, level);
+        averaged            = MipChain::Downsample(averaged.data(), MipChain::GetLevelDimension(WIDTH, level - 1), MipChain::GetLevelDimension(HEIGHT, level - 1));
+        ASSERT_EQ(levels[level - 1].size(), levelWidth * levelHeight * 4);
+        float levelCoverage    = MipChain::GetAlphaCoverage(levels[level - 1].data(), levelWidth, levelHeight, ALPHA_REF);
+        float averagedCoverage = MipChain::GetAlphaCoverage(averaged.data(), levelWidth, levelHeight, ALPHA_REF);
+        ASSERT_LE(std::fabs(levelCoverage - coverage), std::fabs(averagedCoverage - coverage));
+        if (level == 1)
+        {
+            ASSERT_NEAR(levelCoverage, coverage, LEVEL_1_TOLERANCE);
+        }
+        else
+        {
+            // Further down, the wires average out to well below the reference and plain averaging loses them
+            ASSERT_NEAR(levelCoverage, coverage, TOLERANCE);
+            ASSERT_GT(std::fabs(averagedCoverage - coverage), TOLERANCE);
+        }
+
+        // Wherever the fence shows through, it's the wire colour rather than darkened by the black around it
+        for (size_t texelIdx = 0; texelIdx < levels[level - 1].size() / 4; ++texelIdx)
+        {
+            if (levels[level - 1][texelIdx * 4 + 3] > 0)
+            {
+                ASSERT_NEAR(levels[level - 1][texelIdx * 4 + 1], 200, 1);
+            }
+        }
+    }
+}
+
+TEST_F(MipChainTest, OddSizes)
+{
+    // Levels round up, and the texels on the odd edges make it into them
+    std::vector<uint8_t> opaque(5 * 3 * 4, 255);
+    std::vector<std::vector<uint8_t>> levels = MipChain::Build(opaque.data(), 5, 3, 3, ALPHA_REF);
+    ASSERT_EQ(levels.size(), 2u);
+    ASSERT_EQ(levels[0].size(), 3u * 2u * 4u);
+    ASSERT_EQ(levels[1].size(), 2u * 1u * 4u);
+    for (auto &level : levels)
+    {
+        for (uint8_t byte : level)
+        {
+            ASSERT_EQ(byte, 255);
+        }
+    }
+}
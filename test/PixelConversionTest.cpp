@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+
+#include "../src/Util/PixelConversion.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Checks the conversion kernels against the per pixel loops they replaced, on a typical 256x256 texture
+class PixelConversionTest : public testing::Test
+{
+public:
+    static const size_t N_PIXELS = 256 * 256;
+
+    virtual void SetUp()
+    {
+        std::mt19937 rng(1337);
+        source.resize(N_PIXELS * 4);
+        for (auto &byte : source)
+        {
+            // Plenty of zeroes so that colour keys and alpha rules get hit
+            byte = (rng() % 4 == 0) ? 0 : static_cast<uint8_t>(rng());
+        }
+        for (auto &colour : palette)
+        {
+            colour = rng();
+        }
+        expected.resize(N_PIXELS * 4);
+        actual.resize(N_PIXELS * 4);
+    }
+
+    std::vector<uint8_t> source, expected, actual;
+    uint32_t palette[256];
+};
+
+TEST_F(PixelConversionTest, LookupPalette)
+{
+    auto reference = [&]() {
+        for (size_t pixelIdx = 0; pixelIdx < N_PIXELS; ++pixelIdx)
+        {
+            memcpy(&expected[pixelIdx * 4], &palette[source[pixelIdx]], sizeof(uint32_t));
+        }
+    };
+    auto kernel = [&]() { PixelConversion::LookupPalette(source.data(), palette, actual.data(), N_PIXELS); };
+
+    reference();
+    kernel();
+    ASSERT_EQ(expected, actual);
+}
+
+TEST_F(PixelConversionTest, BGR8ToRGBA8ColourKey)
+{
+    const uint8_t alphaColour = 0;
+    auto reference            = [&]() {
+        // As previously in ImageLoader::LoadBmpCustomAlpha
+        const uint8_t *pixel  = source.data();
+        uint8_t *current_bits = expected.data();
+        for (size_t w = N_PIXELS; w > 0; w--)
+        {
+            *current_bits++ = pixel[2];
+            *current_bits++ = pixel[1];
+            *current_bits++ = pixel[0];
+            *current_bits++ = (pixel[2] == 0 && pixel[1] == alphaColour && pixel[0] == 0) ? 0 : 255;
+            pixel += 3;
+        }
+    };
+    auto kernel = [&]() { PixelConversion::BGR8ToRGBA8ColourKey(source.data(), actual.data(), N_PIXELS, 0, alphaColour, 0); };
+
+    reference();
+    kernel();
+    ASSERT_EQ(expected, actual);
+}
+
+TEST_F(PixelConversionTest, ARGB1555ToRGBA8)
+{
+    auto reference = [&]() {
+        for (size_t pixelIdx = 0; pixelIdx < N_PIXELS; ++pixelIdx)
+        {
+            uint16_t colour = static_cast<uint16_t>(source[pixelIdx * 2] | (source[pixelIdx * 2 + 1] << 8));
+            uint8_t *dst    = &expected[pixelIdx * 4];
+            dst[0]          = ((colour >> 10) & 0x1F) << 3;
+            dst[1]          = ((colour >> 5) & 0x1F) << 3;
+            dst[2]          = (colour & 0x1F) << 3;
+            dst[3]          = (colour & 0x8000) ? 0xFF : 0x00;
+        }
+    };
+    auto kernel = [&]() { PixelConversion::ARGB1555ToRGBA8(source.data(), actual.data(), N_PIXELS); };
+
+    reference();
+    kernel();
+    ASSERT_EQ(expected, actual);
+}
+
+TEST_F(PixelConversionTest, ARGB4444ToRGBA8)
+{
+    auto reference = [&]() {
+        for (size_t pixelIdx = 0; pixelIdx < N_PIXELS; ++pixelIdx)
+        {
+            const uint8_t *src = &source[pixelIdx * 2];
+            uint8_t *dst       = &expected[pixelIdx * 4];
+            dst[0]             = 0x11 * (src[1] & 0xF);
+            dst[1]             = 0x11 * (src[0] >> 4);
+            dst[2]             = 0x11 * (src[0] & 0xF);
+            dst[3]             = 0x11 * (src[1] >> 4);
+        }
+    };
+    auto kernel = [&]() { PixelConversion::ARGB4444ToRGBA8(source.data(), actual.data(), N_PIXELS); };
+
+    reference();
+    kernel();
+    ASSERT_EQ(expected, actual);
+}
+
+TEST_F(PixelConversionTest, ABGR1555ToARGB8888)
+{
+    // Every possible input
+    std::vector<uint16_t> allColours(65536);
+    for (size_t colour = 0; colour < allColours.size(); ++colour)
+    {
+        allColours[colour] = static_cast<uint16_t>(colour);
+    }
+    std::vector<uint32_t> expectedWords(allColours.size()), actualWords(allColours.size());
+
+    // As ImageLoader::abgr1555ToARGB8888, kept here so the test doesn't drag in GL
+    auto referenceConversion = [](const uint16_t *src, uint32_t *dst, size_t nPixels) {
+        for (size_t pixelIdx = 0; pixelIdx < nPixels; ++pixelIdx)
+        {
+            uint16_t abgr1555 = src[pixelIdx];
+            uint8_t red       = static_cast<int>(round((abgr1555 & 0x1F) / 31.0F * 255.0F));
+            uint8_t green     = static_cast<int>(round(((abgr1555 & 0x3E0) >> 5) / 31.0F * 255.0F));
+            uint8_t blue      = static_cast<int>(round(((abgr1555 & 0x7C00) >> 10) / 31.0F * 255.0F));
+            uint32_t alpha    = 255;
+            if (((abgr1555 & 0x8000) == 0 ? 1 : 0) == ((red == 0) && (green == 0) && (blue == 0) ? 1 : 0))
+            {
+                alpha = 0;
+            }
+            dst[pixelIdx] = alpha << 24 | red << 16 | green << 8 | blue;
+        }
+    };
+    referenceConversion(allColours.data(), expectedWords.data(), allColours.size());
+    PixelConversion::ABGR1555ToARGB8888(allColours.data(), actualWords.data(), allColours.size());
+    ASSERT_EQ(expectedWords, actualWords);
+}
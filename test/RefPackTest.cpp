@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+
+#include "../src/Util/RefPack.h"
+
+#include <random>
+#include <vector>
+
+// Checks the RefPack decoder against the byte at a time decoder it replaced (Utils::DecompressCRP/fshtool uncompress_data) on a randomly generated
+// stream exercising every token type, and rejects corrupt streams.
+class RefPackTest : public testing::Test
+{
+public:
+    static const size_t DECOMPRESSED_SIZE = 4 * 1024 * 1024;
+
+    virtual void SetUp()
+    {
+        std::mt19937 rng(1337);
+        std::vector<uint8_t> tokens;
+
+        // Emit random tokens, applying each to the expected output as we go so the stream is valid by construction
+        auto emitLiterals = [&](size_t nLiterals) {
+            for (size_t literalIdx = 0; literalIdx < nLiterals; ++literalIdx)
+            {
+                uint8_t literal = static_cast<uint8_t>(rng() % 16);
+                tokens.push_back(literal);
+                expected.push_back(literal);
+            }
+        };
+        auto applyMatch = [&](size_t offset, size_t length) {
+            for (size_t byteIdx = 0; byteIdx < length; ++byteIdx)
+            {
+                expected.push_back(expected[expected.size() - offset]);
+            }
+        };
+        auto randomOffset = [&](size_t maxOffset) {
+            // Favour short (overlapping) offsets some of the time, as real data does for runs
+            size_t limit = std::min(maxOffset, expected.size());
+            return (rng() % 4 == 0) ? 1 + rng() % std::min<size_t>(limit, 8) : 1 + rng() % limit;
+        };
+
+        // Long literal run first so that there's something to match against
+        tokens.push_back(0xE0 | 27);
+        emitLiterals(112);
+        while (expected.size() < DECOMPRESSED_SIZE - 2048)
+        {
+            size_t nLiterals = rng() % 4;
+            switch (rng() % 4)
+            {
+            case 0: {
+                size_t length = 3 + rng() % 8;
+                size_t offset = randomOffset(1024);
+                tokens.push_back(static_cast<uint8_t>((((offset - 1) >> 8) << 5) | ((length - 3) << 2) | nLiterals));
+                tokens.push_back(static_cast<uint8_t>(offset - 1));
+                emitLiterals(nLiterals);
+                applyMatch(offset, length);
+                break;
+            }
+            case 1: {
+                size_t length = 4 + rng() % 64;
+                size_t offset = randomOffset(16384);
+                tokens.push_back(static_cast<uint8_t>(0x80 | (length - 4)));
+                tokens.push_back(static_cast<uint8_t>((nLiterals << 6) | ((offset - 1) >> 8)));
+                tokens.push_back(static_cast<uint8_t>(offset - 1));
+                emitLiterals(nLiterals);
+                applyMatch(offset, length);
+                break;
+            }
+            case 2: {
+                size_t length = 5 + rng() % 1024;
+                size_t offset = randomOffset(131072);
+                tokens.push_back(static_cast<uint8_t>(0xC0 | (((offset - 1) >> 12) & 0x10) | (((length - 5) >> 8) << 2) | nLiterals));
+                tokens.push_back(static_cast<uint8_t>((offset - 1) >> 8));
+                tokens.push_back(static_cast<uint8_t>(offset - 1));
+                tokens.push_back(static_cast<uint8_t>(length - 5));
+                emitLiterals(nLiterals);
+                applyMatch(offset, length);
+                break;
+            }
+            default: {
+                size_t nLongLiterals = rng() % 28;
+                tokens.push_back(static_cast<uint8_t>(0xE0 | nLongLiterals));
+                emitLiterals(nLongLiterals * 4 + 4);
+                break;
+            }
+            }
+        }
+        tokens.push_back(0xFC | 3);
+        emitLiterals(3);
+
+        compressed = {0x10, 0xFB, static_cast<uint8_t>(expected.size() >> 16), static_cast<uint8_t>(expected.size() >> 8), static_cast<uint8_t>(expected.size())};
+        compressed.insert(compressed.end(), tokens.begin(), tokens.end());
+    }
+
+    // As the decoding loop of Utils::DecompressCRP, reading the input a byte at a time and copying matches byte by byte
+    static std::vector<uint8_t> ReferenceDecompress(const std::vector<uint8_t> &compressed)
+    {
+        size_t length = (compressed[2] << 16) + (compressed[3] << 8) + compressed[4];
+        std::vector<uint8_t> data(length);
+        size_t inPos = 5, dataPos = 0, len, offset;
+        uint8_t inByte = compressed[inPos++];
+        while (inByte < 0xFC)
+        {
+            if (!(inByte & 0x80))
+            {
+                uint8_t tmp1 = compressed[inPos++];
+                for (len = inByte & 0x03; len > 0; --len)
+                    data[dataPos++] = compressed[inPos++];
+                len    = ((inByte & 0x1C) >> 2) + 3;
+                offset = ((inByte >> 5) << 8) + tmp1 + 1;
+                for (; len > 0; --len, ++dataPos)
+                    data[dataPos] = data[dataPos - offset];
+            }
+            else if (!(inByte & 0x40))
+            {
+                uint8_t tmp1 = compressed[inPos++];
+                uint8_t tmp2 = compressed[inPos++];
+                for (len = (tmp1 >> 6) & 0x03; len > 0; --len)
+                    data[dataPos++] = compressed[inPos++];
+                len    = (inByte & 0x3F) + 4;
+                offset = ((tmp1 & 0x3F) * 256) + tmp2 + 1;
+                for (; len > 0; --len, ++dataPos)
+                    data[dataPos] = data[dataPos - offset];
+            }
+            else if (!(inByte & 0x20))
+            {
+                uint8_t tmp1 = compressed[inPos++];
+                uint8_t tmp2 = compressed[inPos++];
+                uint8_t tmp3 = compressed[inPos++];
+                for (len = inByte & 0x03; len > 0; --len)
+                    data[dataPos++] = compressed[inPos++];
+                len    = (((inByte >> 2) & 0x03) * 256) + tmp3 + 5;
+                offset = ((inByte & 0x10) << 0x0C) + (tmp1 * 256) + tmp2 + 1;
+                for (; len > 0; --len, ++dataPos)
+                    data[dataPos] = data[dataPos - offset];
+            }
+            else
+            {
+                for (len = ((inByte & 0x1F) * 4) + 4; len > 0; --len)
+                    data[dataPos++] = compressed[inPos++];
+            }
+            inByte = compressed[inPos++];
+        }
+        for (len = inByte & 0x03; len > 0; --len)
+            data[dataPos++] = compressed[inPos++];
+
+        return data;
+    }
+
+    std::vector<uint8_t> compressed, expected;
+};
+
+TEST_F(RefPackTest, MatchesReferenceDecoder)
+{
+    ASSERT_TRUE(RefPack::IsCompressed(compressed.data(), compressed.size()));
+    ASSERT_EQ(RefPack::GetDecompressedSize(compressed.data(), compressed.size()), expected.size());
+
+    std::vector<uint8_t> actual;
+    ASSERT_TRUE(RefPack::Decompress(compressed.data(), compressed.size(), actual));
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(expected, ReferenceDecompress(compressed));
+}
+
+TEST_F(RefPackTest, CompressedSizeHeader)
+{
+    // 0x11FB streams carry the compressed size after the decompressed size, fshtool skipped it
+    std::vector<uint8_t> withSize(compressed.begin(), compressed.begin() + 5);
+    withSize[0] = 0x11;
+    withSize.insert(withSize.end(), {0, 0, 0});
+    withSize.insert(withSize.end(), compressed.begin() + 5, compressed.end());
+
+    std::vector<uint8_t> actual;
+    ASSERT_TRUE(RefPack::Decompress(withSize.data(), withSize.size(), actual));
+    ASSERT_EQ(expected, actual);
+}
+
+TEST_F(RefPackTest, RejectsCorruptStreams)
+{
+    std::vector<uint8_t> actual;
+
+    // Not RefPack at all
+    std::vector<uint8_t> notRefPack = {'S', 'H', 'P', 'I', 0, 0, 0, 0};
+    ASSERT_FALSE(RefPack::IsCompressed(notRefPack.data(), notRefPack.size()));
+    ASSERT_FALSE(RefPack::Decompress(notRefPack.data(), notRefPack.size(), actual));
+
+    // Truncated part way through, must neither read past the input nor report success
+    for (size_t truncatedSize : {compressed.size() / 2, compressed.size() - 1, static_cast<size_t>(6)})
+    {
+        ASSERT_FALSE(RefPack::Decompress(compressed.data(), truncatedSize, actual));
+    }
+
+    // Match reaching back before the start of the output
+    std::vector<uint8_t> badOffset = {0x10, 0xFB, 0x00, 0x00, 0x04, 0x00 | 0x01, 0x05, 'a', 0xFC};
+    ASSERT_FALSE(RefPack::Decompress(badOffset.data(), badOffset.size(), actual));
+
+    // Header claims less output than the stream produces
+    std::vector<uint8_t> overrun = compressed;
+    overrun[4]--;
+    ASSERT_FALSE(RefPack::Decompress(overrun.data(), overrun.size(), actual));
+}